@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+// Measures how long it takes to start a helper process and wait for it to exit, first with exec and then by forking
+// it from a ForkServer. The program is its own helper: when the first argument is "helper" it just writes a line to
+// its standard output like StandardOutputTestHelper does.
+//
+// Usage: ForkServerBenchmark [iterations]
+
+#include <Ishiko/TestFramework/Core.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+
+class DiscardOutput : public PipedChildProcess::Callbacks
+{
+};
+
+int HelperMain(int argc, char* argv[])
+{
+    std::cout << "Message from ForkServerBenchmark" << std::endl;
+    return 0;
+}
+
+// Returns the time taken by each run in microseconds, or an empty vector if a run failed
+std::vector<long long> Measure(const std::string& commandLine, std::shared_ptr<ForkServer> server, int iterations)
+{
+    std::vector<long long> result;
+    for (int i = 0; i < iterations; ++i)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        DiscardOutput callbacks;
+        PipedChildProcess process;
+        process.setForkServer(server);
+        Error error;
+        process.start(commandLine, callbacks, error);
+        if (error)
+        {
+            return std::vector<long long>();
+        }
+        process.readAllOutput();
+        process.waitForExit();
+        if (process.exitCode() != 0)
+        {
+            return std::vector<long long>();
+        }
+
+        result.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+    return result;
+}
+
+void Report(const std::string& name, std::vector<long long> timings)
+{
+    std::sort(timings.begin(), timings.end());
+    long long total = 0;
+    for (long long timing : timings)
+    {
+        total += timing;
+    }
+    std::cout << name << ": mean " << (total / (long long)timings.size()) << " us, median "
+        << timings[timings.size() / 2] << " us, 95th percentile " << timings[(timings.size() * 95) / 100]
+        << " us" << std::endl;
+}
+
+int BenchmarkMain(int argc, char* argv[])
+{
+    if ((argc > 1) && (strcmp(argv[1], "helper") == 0))
+    {
+        return HelperMain(argc - 1, argv + 1);
+    }
+
+    if (!ForkServer::IsSupported())
+    {
+        std::cerr << "ForkServer is not supported on this platform" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    int iterations = 200;
+    if (argc > 1)
+    {
+        iterations = std::max(1, atoi(argv[1]));
+    }
+
+    boost::filesystem::path executablePath = boost::filesystem::canonical("/proc/self/exe");
+    std::string commandLine = "\"" + executablePath.string() + "\" helper";
+
+    std::vector<long long> execTimings = Measure(commandLine, nullptr, iterations);
+    if (execTimings.empty())
+    {
+        std::cerr << "Failed to run " << commandLine << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::shared_ptr<ForkServer> server = std::make_shared<ForkServer>();
+    Error error;
+    server->start(executablePath, error);
+    if (error)
+    {
+        std::cerr << "Failed to start the fork server" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::vector<long long> forkServerTimings = Measure(commandLine, server, iterations);
+    if (forkServerTimings.empty())
+    {
+        std::cerr << "Failed to run " << commandLine << " through the fork server" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << iterations << " iterations" << std::endl;
+    Report("exec", execTimings);
+    Report("fork server", forkServerTimings);
+
+    return EXIT_SUCCESS;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    return ForkServer::RunIfRequested(argc, argv, BenchmarkMain);
+}
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+// Measures the cost of resolving paths through a chain of 10 nested contexts, which is roughly what a test nested in
+// a few sequences sees. The "uncached" figures clear the path caches of all the contexts before every call so they show
+// the cost of the full resolution, including the existence checks done by getReferencePath.
+//
+// Usage: TestContextBenchmark [iterations]
+
+#include <Ishiko/TestFramework/Core.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+
+const size_t depth = 10;
+
+void Report(const std::string& name, int iterations, const std::function<void()>& function)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        function();
+    }
+    long long total = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << (total / iterations) << " ns per call" << std::endl;
+}
+
+void ClearPathCaches(const std::vector<std::unique_ptr<TestContext>>& contexts)
+{
+    for (const std::unique_ptr<TestContext>& context : contexts)
+    {
+        context->clearPathCache();
+    }
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    int iterations = 100000;
+    if (argc > 1)
+    {
+        iterations = std::max(1, atoi(argv[1]));
+    }
+
+    std::vector<std::unique_ptr<TestContext>> contexts;
+    contexts.emplace_back(new TestContext());
+    contexts.back()->setDataDirectory("data");
+    contexts.back()->setReferenceDirectory("reference");
+    contexts.back()->setOutputDirectory("output");
+    for (size_t i = 1; i < depth; ++i)
+    {
+        contexts.emplace_back(new TestContext(contexts.back().get()));
+        contexts.back()->setOutputDirectory(std::to_string(i));
+    }
+    const TestContext& context = *contexts.back();
+
+    std::cout << iterations << " iterations, depth " << depth << std::endl;
+    Report("getOutputPath uncached", iterations,
+        [&contexts, &context]()
+        {
+            ClearPathCaches(contexts);
+            context.getOutputPath("file.txt");
+        });
+    Report("getOutputPath cached", iterations,
+        [&context]()
+        {
+            context.getOutputPath("file.txt");
+        });
+    Report("getDataDirectory uncached", iterations,
+        [&contexts, &context]()
+        {
+            ClearPathCaches(contexts);
+            context.getDataDirectory();
+        });
+    Report("getDataDirectory cached", iterations,
+        [&context]()
+        {
+            context.getDataDirectory();
+        });
+    Report("getReferencePath platform_specific uncached", iterations,
+        [&contexts, &context]()
+        {
+            ClearPathCaches(contexts);
+            context.getReferencePath("file.txt", TestContext::PathResolution::platform_specific);
+        });
+    Report("getReferencePath platform_specific cached", iterations,
+        [&context]()
+        {
+            context.getReferencePath("file.txt", TestContext::PathResolution::platform_specific);
+        });
+
+    return EXIT_SUCCESS;
+}
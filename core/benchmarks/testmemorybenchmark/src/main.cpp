@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+// Measures the memory used by each test of a large generated suite. The global operator new is replaced so that every
+// allocation made while the suite is built is counted. Two suites are built: one where all the tests have the same
+// name, like the cases of a parameterised test, and one where every name is different.
+//
+// Usage: TestMemoryBenchmark [test count]
+
+#include <Ishiko/TestFramework/Core.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+using namespace Ishiko;
+
+namespace
+{
+
+size_t allocatedBytes = 0;
+size_t allocationCount = 0;
+
+void Report(const std::string& name, size_t testCount, bool uniqueNames)
+{
+    size_t bytesBefore = allocatedBytes;
+    size_t countBefore = allocationCount;
+    {
+        TestSequence sequence(TestNumber(1), "TestMemoryBenchmark");
+        for (size_t i = 0; i < testCount; ++i)
+        {
+            sequence.append<Test>((uniqueNames ? ("generated test case " + std::to_string(i)) : "generated test case"),
+                [](Test& test)
+                {
+                    test.pass();
+                });
+        }
+
+        size_t bytes = (allocatedBytes - bytesBefore);
+        size_t count = (allocationCount - countBefore);
+        std::cout << name << ": " << (bytes / testCount) << " bytes and " << ((double)count / testCount)
+            << " allocations per test" << std::endl;
+    }
+}
+
+}
+
+void* operator new(size_t size)
+{
+    allocatedBytes += size;
+    ++allocationCount;
+    void* result = malloc(size);
+    if (!result)
+    {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t testCount = 1000000;
+    if (argc > 1)
+    {
+        testCount = std::max(1, atoi(argv[1]));
+    }
+
+    std::cout << testCount << " tests, sizeof(Test) is " << sizeof(Test) << " bytes" << std::endl;
+    Report("same names", testCount, false);
+    Report("unique names", testCount, true);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+// Compares Test::traverse with the TestTraversal functions on a synthetic tree of about 1 million tests: 100
+// sequences, each containing 100 sequences of 100 tests. The "dynamic_cast" figure is the way leaves used to be found
+// with Test::traverse.
+//
+// Usage: TestTraversalBenchmark [iterations]
+
+#include <Ishiko/TestFramework/Core.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace Ishiko;
+
+namespace
+{
+
+const size_t width = 100;
+
+void Report(const std::string& name, int iterations, size_t nodes, const std::function<size_t()>& function)
+{
+    size_t visited = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        visited += function();
+    }
+    long long total = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << (total / iterations / 1000000) << " ms per traversal, "
+        << ((double)total / iterations / nodes) << " ns per node, " << (visited / iterations) << " tests visited"
+        << std::endl;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    int iterations = 10;
+    if (argc > 1)
+    {
+        iterations = std::max(1, atoi(argv[1]));
+    }
+
+    TestSequence root(TestNumber(1), "root");
+    for (size_t i = 0; i < width; ++i)
+    {
+        TestSequence& level1 = root.append<TestSequence>("level1");
+        for (size_t j = 0; j < width; ++j)
+        {
+            TestSequence& level2 = level1.append<TestSequence>("level2");
+            for (size_t k = 0; k < width; ++k)
+            {
+                level2.append<Test>("test", TestResult::passed);
+            }
+        }
+    }
+    size_t nodes = 1 + width + (width * width) + (width * width * width);
+    const Test& constRoot = root;
+
+    std::cout << nodes << " nodes, " << iterations << " iterations" << std::endl;
+    Report("Test::traverse", iterations, nodes,
+        [&constRoot]()
+        {
+            size_t count = 0;
+            constRoot.traverse(
+                [&count](const Test& test)
+                {
+                    ++count;
+                });
+            return count;
+        });
+    Report("Test::traverse leaves with dynamic_cast", iterations, nodes,
+        [&constRoot]()
+        {
+            size_t count = 0;
+            constRoot.traverse(
+                [&count](const Test& test)
+                {
+                    const TestSequence* sequence = dynamic_cast<const TestSequence*>(&test);
+                    if (!sequence || (sequence->size() == 0))
+                    {
+                        ++count;
+                    }
+                });
+            return count;
+        });
+    Report("TestTraversal::PreOrder", iterations, nodes,
+        [&constRoot]()
+        {
+            size_t count = 0;
+            TestTraversal::PreOrder(constRoot,
+                [&count](const Test& test)
+                {
+                    ++count;
+                });
+            return count;
+        });
+    Report("TestTraversal::PostOrder", iterations, nodes,
+        [&constRoot]()
+        {
+            size_t count = 0;
+            TestTraversal::PostOrder(constRoot,
+                [&count](const Test& test)
+                {
+                    ++count;
+                });
+            return count;
+        });
+    Report("TestTraversal::Leaves", iterations, nodes,
+        [&constRoot]()
+        {
+            size_t count = 0;
+            TestTraversal::Leaves(constRoot,
+                [&count](const Test& test)
+                {
+                    ++count;
+                });
+            return count;
+        });
+
+    return EXIT_SUCCESS;
+}
@@ -3,7 +3,7 @@
 
 #include "Actions/CopyFilesAction.hpp"
 #include "Test.hpp"
-#include <Ishiko/FileSystem.hpp>
+#include "TestException.hpp"
 
 using namespace Ishiko;
 
@@ -12,12 +12,23 @@ CopyFilesAction::CopyFilesAction(const InterpolatedString& source, const Interpo
     m_copy_list.emplace_back(source, destination);
 }
 
+void CopyFilesAction::setReadOnly(bool readOnly)
+{
+    m_copier.setReadOnly(readOnly);
+}
+
 void CopyFilesAction::setup(const Test& test)
 {
     for (const std::pair<InterpolatedString, InterpolatedString>& source_destination_pair : m_copy_list)
     {
         boost::filesystem::path source = source_destination_pair.first.expand(test.context());
         boost::filesystem::path destination = source_destination_pair.second.expand(test.context());
-        FileSystem::CopySingleFile(source, destination);
+        Error error;
+        m_copier.copy(source, destination, error);
+        if (error)
+        {
+            throw TestException("CopyFilesAction::setup failed to copy " + source.string() + " to "
+                + destination.string());
+        }
     }
 }
@@ -0,0 +1,189 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "BackgroundDeleter.hpp"
+#include <boost/filesystem/operations.hpp>
+#include <algorithm>
+#include <atomic>
+
+using namespace Ishiko;
+
+/// A directory whose contents are being deleted. It is deleted itself once all its subdirectories have been.
+class BackgroundDeleter::Directory
+{
+public:
+    Directory(const boost::filesystem::path& path, std::shared_ptr<Directory> parent)
+        : path(path), parent(parent), pendingCount(1)
+    {
+    }
+
+    boost::filesystem::path path;
+    std::shared_ptr<Directory> parent;
+    // The number of subdirectories not yet deleted, plus one while the contents are being listed
+    std::atomic<size_t> pendingCount;
+};
+
+BackgroundDeleter::BackgroundDeleter(size_t threadCount)
+    : m_threadCount(std::max<size_t>(1, threadCount)), m_activeTaskCount(0), m_failureCount(0), m_stopping(false)
+{
+}
+
+BackgroundDeleter::~BackgroundDeleter()
+{
+    drain();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_taskAvailable.notify_all();
+    for (std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+size_t BackgroundDeleter::threadCount() const noexcept
+{
+    return m_threadCount;
+}
+
+bool BackgroundDeleter::RenameToTombstone(const boost::filesystem::path& path, boost::filesystem::path& tombstone)
+{
+    boost::system::error_code ec;
+    boost::filesystem::path candidate = path.parent_path()
+        / (path.filename().string() + boost::filesystem::unique_path(".deleted-%%%%-%%%%-%%%%").string());
+    boost::filesystem::rename(path, candidate, ec);
+    if (ec)
+    {
+        return false;
+    }
+    tombstone = candidate;
+    return true;
+}
+
+void BackgroundDeleter::remove(const boost::filesystem::path& path)
+{
+    enqueue(
+        [this, path]()
+        {
+            removePath(path);
+        });
+}
+
+void BackgroundDeleter::removeAll(const boost::filesystem::path& path)
+{
+    std::shared_ptr<Directory> directory = std::make_shared<Directory>(path, nullptr);
+    enqueue(
+        [this, directory]()
+        {
+            removeDirectoryContents(directory);
+        });
+}
+
+void BackgroundDeleter::drain()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_drained.wait(lock,
+        [this]()
+        {
+            return (m_tasks.empty() && (m_activeTaskCount == 0));
+        });
+}
+
+size_t BackgroundDeleter::failureCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_failureCount;
+}
+
+void BackgroundDeleter::enqueue(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+        if (m_threads.size() < std::min(m_threadCount, m_tasks.size() + m_activeTaskCount))
+        {
+            m_threads.emplace_back(&BackgroundDeleter::runTasks, this);
+        }
+    }
+    m_taskAvailable.notify_one();
+}
+
+void BackgroundDeleter::removeDirectoryContents(std::shared_ptr<Directory> directory)
+{
+    boost::system::error_code ec;
+    if (boost::filesystem::is_directory(boost::filesystem::symlink_status(directory->path, ec)))
+    {
+        for (boost::filesystem::directory_iterator it(directory->path, ec);
+            !ec && (it != boost::filesystem::directory_iterator()); it.increment(ec))
+        {
+            if (boost::filesystem::is_directory(it->symlink_status(ec)))
+            {
+                // Each subdirectory is handed to another task so that large trees are deleted in parallel
+                ++directory->pendingCount;
+                std::shared_ptr<Directory> subdirectory = std::make_shared<Directory>(it->path(), directory);
+                enqueue(
+                    [this, subdirectory]()
+                    {
+                        removeDirectoryContents(subdirectory);
+                    });
+            }
+            else
+            {
+                removePath(it->path());
+            }
+        }
+    }
+    completeDirectory(directory);
+}
+
+void BackgroundDeleter::completeDirectory(std::shared_ptr<Directory> directory)
+{
+    while (directory && (--directory->pendingCount == 0))
+    {
+        // This was the last thing the directory was waiting for so it is now empty, or it wasn't a directory
+        removePath(directory->path);
+        directory = directory->parent;
+    }
+}
+
+void BackgroundDeleter::removePath(const boost::filesystem::path& path)
+{
+    boost::system::error_code ec;
+    boost::filesystem::remove(path, ec);
+    if (ec && (ec != boost::system::errc::no_such_file_or_directory))
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_failureCount;
+    }
+}
+
+void BackgroundDeleter::runTasks()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_taskAvailable.wait(lock,
+            [this]()
+            {
+                return (m_stopping || !m_tasks.empty());
+            });
+        if (m_tasks.empty())
+        {
+            // We are stopping and there is nothing left to do
+            return;
+        }
+
+        std::function<void()> task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        ++m_activeTaskCount;
+        lock.unlock();
+        task();
+        lock.lock();
+        --m_activeTaskCount;
+        if (m_tasks.empty() && (m_activeTaskCount == 0))
+        {
+            m_drained.notify_all();
+        }
+    }
+}
@@ -0,0 +1,341 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "BinaryResultLogConverter.hpp"
+#include "BinaryResultLogReader.hpp"
+#include "JUnitXMLWriter.hpp"
+#include "TestFrameworkErrorCategory.hpp"
+#include "TestProgressObserver.hpp"
+#include <boost/filesystem/operations.hpp>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+
+struct Failure
+{
+    std::string message;
+    std::string file;
+    int line;
+    bool exception;
+};
+
+// A test whose test_end record has been read, along with what happened while it was running
+struct CompletedTest
+{
+    TestNumber number;
+    std::string name;
+    TestResult result;
+    int64_t startTimestamp;
+    int64_t endTimestamp;
+    // True if other tests started while this one was running, i.e. it is a sequence
+    bool hasChildren;
+    std::vector<Failure> failures;
+};
+
+// Calls the callback for each test as it completes. Only the tests that are running are kept in memory.
+void ForEachCompletedTest(std::istream& log, const std::function<void(const CompletedTest& test)>& callback,
+    Error& error)
+{
+    BinaryResultLogReader reader(log);
+    BinaryResultLogReader::Record record;
+    std::vector<CompletedTest> running;
+    while (reader.read(record, error))
+    {
+        switch (record.type)
+        {
+        case BinaryResultLogReader::RecordType::test_start:
+            if (!running.empty())
+            {
+                running.back().hasChildren = true;
+            }
+            running.push_back(
+                CompletedTest{record.number, record.name, TestResult::unknown, record.timestamp, 0, false, {}});
+            break;
+
+        case BinaryResultLogReader::RecordType::test_end:
+            if (!running.empty())
+            {
+                CompletedTest& test = running.back();
+                test.result = record.result;
+                test.endTimestamp = record.timestamp;
+                callback(test);
+                running.pop_back();
+            }
+            break;
+
+        case BinaryResultLogReader::RecordType::check_failed:
+            if (!running.empty())
+            {
+                running.back().failures.push_back(Failure{record.message, record.file, record.line, false});
+            }
+            break;
+
+        case BinaryResultLogReader::RecordType::exception_thrown:
+            if (!running.empty())
+            {
+                std::string message = (record.standardException ? ("Exception thrown: " + record.message)
+                    : "Exception not derived from std::exception thrown");
+                running.back().failures.push_back(Failure{message, "", 0, true});
+            }
+            break;
+        }
+    }
+}
+
+std::string FormatNumber(const TestNumber& number)
+{
+    std::string result;
+    for (size_t i = 0; i < number.depth(); ++i)
+    {
+        if (i != 0)
+        {
+            result.push_back('.');
+        }
+        result.append(std::to_string(number.part(i)));
+    }
+    return result;
+}
+
+void WriteJSONString(std::ostream& output, const std::string& value)
+{
+    output << '"';
+    for (char c : value)
+    {
+        switch (c)
+        {
+        case '"':
+            output << "\\\"";
+            break;
+
+        case '\\':
+            output << "\\\\";
+            break;
+
+        case '\n':
+            output << "\\n";
+            break;
+
+        case '\r':
+            output << "\\r";
+            break;
+
+        case '\t':
+            output << "\\t";
+            break;
+
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char escaped[7];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                output << escaped;
+            }
+            else
+            {
+                output << c;
+            }
+            break;
+        }
+    }
+    output << '"';
+}
+
+}
+
+void BinaryResultLogConverter::Replay(std::istream& log, Test::Observer& observer, Error& error)
+{
+    BinaryResultLogReader reader(log);
+    BinaryResultLogReader::Record record;
+    std::vector<std::unique_ptr<Test>> running;
+    while (reader.read(record, error))
+    {
+        switch (record.type)
+        {
+        case BinaryResultLogReader::RecordType::test_start:
+            running.emplace_back(new Test(record.number, record.name));
+            observer.onLifecycleEvent(*running.back(), Test::Observer::test_start);
+            break;
+
+        case BinaryResultLogReader::RecordType::test_end:
+            if (!running.empty())
+            {
+                running.back()->setResult(record.result);
+                observer.onLifecycleEvent(*running.back(), Test::Observer::test_end);
+                running.pop_back();
+            }
+            break;
+
+        case BinaryResultLogReader::RecordType::check_failed:
+            if (!running.empty())
+            {
+                observer.onCheckFailed(*running.back(), record.message, record.file.c_str(), record.line);
+            }
+            break;
+
+        case BinaryResultLogReader::RecordType::exception_thrown:
+            if (!running.empty())
+            {
+                std::exception_ptr exception;
+                if (record.standardException)
+                {
+                    exception = std::make_exception_ptr(std::runtime_error(record.message));
+                }
+                else
+                {
+                    exception = std::make_exception_ptr(0);
+                }
+                observer.onExceptionThrown(*running.back(), exception);
+            }
+            break;
+        }
+    }
+}
+
+void BinaryResultLogConverter::ToConsoleText(std::istream& log, std::ostream& output, Error& error)
+{
+    TestProgressObserver observer(output);
+    Replay(log, observer, error);
+}
+
+void BinaryResultLogConverter::ToJSON(std::istream& log, std::ostream& output, Error& error)
+{
+    bool first = true;
+    output << "[";
+    ForEachCompletedTest(log,
+        [&output, &first](const CompletedTest& test)
+        {
+            output << (first ? "\n" : ",\n");
+            first = false;
+            output << "{\"number\":";
+            WriteJSONString(output, FormatNumber(test.number));
+            output << ",\"name\":";
+            WriteJSONString(output, test.name);
+            output << ",\"result\":";
+            WriteJSONString(output, ToString(test.result));
+            output << ",\"sequence\":" << (test.hasChildren ? "true" : "false");
+            output << ",\"start\":" << test.startTimestamp;
+            output << ",\"duration\":" << (test.endTimestamp - test.startTimestamp);
+            output << ",\"failures\":[";
+            for (size_t i = 0; i < test.failures.size(); ++i)
+            {
+                const Failure& failure = test.failures[i];
+                if (i != 0)
+                {
+                    output << ",";
+                }
+                output << "{\"message\":";
+                WriteJSONString(output, failure.message);
+                if (!failure.exception)
+                {
+                    output << ",\"file\":";
+                    WriteJSONString(output, failure.file);
+                    output << ",\"line\":" << failure.line;
+                }
+                output << "}";
+            }
+            output << "]}";
+        },
+        error);
+    output << "\n]\n";
+}
+
+void BinaryResultLogConverter::ToJUnitXML(const boost::filesystem::path& logPath,
+    const boost::filesystem::path& reportPath, Error& error)
+{
+    // The test cases are the tests that don't contain other tests, like the ones TestHarness writes
+    size_t total = 0;
+    {
+        std::ifstream log(logPath.string(), std::ios::binary);
+        if (!log)
+        {
+            Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+            return;
+        }
+        ForEachCompletedTest(log,
+            [&total](const CompletedTest& test)
+            {
+                if (!test.hasChildren)
+                {
+                    ++total;
+                }
+            },
+            error);
+        if (error)
+        {
+            return;
+        }
+    }
+
+    if (reportPath.has_parent_path())
+    {
+        boost::filesystem::create_directories(reportPath.parent_path());
+    }
+    JUnitXMLWriter writer;
+    writer.create(reportPath, error);
+    if (error)
+    {
+        return;
+    }
+    writer.writeTestSuitesStart();
+    writer.writeTestSuiteStart(total);
+
+    std::ifstream log(logPath.string(), std::ios::binary);
+    ForEachCompletedTest(log,
+        [&writer](const CompletedTest& test)
+        {
+            if (test.hasChildren)
+            {
+                return;
+            }
+
+            writer.writeTestCaseStart("unknown", test.name);
+            switch (test.result)
+            {
+            case TestResult::passed:
+                // Do nothing
+                break;
+
+            case TestResult::skipped:
+                writer.writeSkippedStart();
+                writer.writeSkippedEnd();
+                break;
+
+            default:
+                if (test.failures.empty())
+                {
+                    writer.writeFailureStart();
+                    writer.writeFailureEnd();
+                }
+                for (const Failure& failure : test.failures)
+                {
+                    writer.writeFailureStart();
+                    if (failure.exception)
+                    {
+                        writer.writeText(failure.message);
+                    }
+                    else
+                    {
+                        writer.writeText(failure.message + " [file: " + failure.file + ", line: "
+                            + std::to_string(failure.line) + "]");
+                    }
+                    writer.writeFailureEnd();
+                }
+                break;
+            }
+            writer.writeTestCaseEnd();
+        },
+        error);
+
+    writer.writeTestSuiteEnd();
+    writer.writeTestSuitesEnd();
+    writer.close();
+}
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "BinaryResultLogObserver.hpp"
+#include "BinaryResultLogReader.hpp"
+#include <chrono>
+#include <cstring>
+
+using namespace Ishiko;
+
+namespace
+{
+
+void AppendUInt32(std::string& record, uint32_t value)
+{
+    for (size_t i = 0; i < 4; ++i)
+    {
+        record.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void AppendInt64(std::string& record, int64_t value)
+{
+    uint64_t unsignedValue = static_cast<uint64_t>(value);
+    for (size_t i = 0; i < 8; ++i)
+    {
+        record.push_back(static_cast<char>((unsignedValue >> (8 * i)) & 0xFF));
+    }
+}
+
+void AppendString(std::string& record, const char* value, size_t size)
+{
+    AppendUInt32(record, static_cast<uint32_t>(size));
+    record.append(value, size);
+}
+
+}
+
+BinaryResultLogObserver::BinaryResultLogObserver(std::ostream& output)
+    : m_output(output), m_nestingLevel(0)
+{
+    m_record.append(BinaryResultLogReader::magic, sizeof(BinaryResultLogReader::magic));
+    AppendUInt32(m_record, BinaryResultLogReader::version);
+    m_output.write(m_record.data(), m_record.size());
+    m_output.flush();
+}
+
+void BinaryResultLogObserver::onLifecycleEvent(const Test& source, EventType type)
+{
+    switch (type)
+    {
+    case test_start:
+        startRecord(static_cast<uint8_t>(BinaryResultLogReader::RecordType::test_start), source.number());
+        AppendString(m_record, source.name().c_str(), source.name().size());
+        writeRecord();
+        ++m_nestingLevel;
+        break;
+
+    case test_end:
+        startRecord(static_cast<uint8_t>(BinaryResultLogReader::RecordType::test_end), source.number());
+        m_record.push_back(static_cast<char>(source.result()));
+        writeRecord();
+        if (m_nestingLevel > 0)
+        {
+            --m_nestingLevel;
+        }
+        // Flush once the outermost test completes so that the whole run is on disk without flushing every record
+        if (m_nestingLevel == 0)
+        {
+            m_output.flush();
+        }
+        break;
+    }
+}
+
+void BinaryResultLogObserver::onCheckFailed(const Test& source, const std::string& message, const char* file,
+    int line)
+{
+    startRecord(static_cast<uint8_t>(BinaryResultLogReader::RecordType::check_failed), source.number());
+    AppendString(m_record, message.c_str(), message.size());
+    AppendString(m_record, file, strlen(file));
+    AppendUInt32(m_record, static_cast<uint32_t>(line));
+    writeRecord();
+    // Failures are rare and are what we most want to see if the run crashes afterwards
+    m_output.flush();
+}
+
+void BinaryResultLogObserver::onExceptionThrown(const Test& source, std::exception_ptr exception)
+{
+    startRecord(static_cast<uint8_t>(BinaryResultLogReader::RecordType::exception_thrown), source.number());
+    bool standardException = false;
+    std::string message;
+    if (exception)
+    {
+        try
+        {
+            std::rethrow_exception(exception);
+        }
+        catch (const std::exception& e)
+        {
+            standardException = true;
+            message = e.what();
+        }
+        catch (...)
+        {
+        }
+    }
+    m_record.push_back(standardException ? 1 : 0);
+    AppendString(m_record, message.c_str(), message.size());
+    writeRecord();
+    m_output.flush();
+}
+
+void BinaryResultLogObserver::startRecord(uint8_t type, const TestNumber& number)
+{
+    m_record.clear();
+    m_record.push_back(static_cast<char>(type));
+    // The size of the record is filled in by writeRecord()
+    AppendUInt32(m_record, 0);
+    int64_t timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    AppendInt64(m_record, timestamp);
+    AppendUInt32(m_record, static_cast<uint32_t>(number.depth()));
+    for (size_t i = 0; i < number.depth(); ++i)
+    {
+        AppendUInt32(m_record, static_cast<uint32_t>(number.part(i)));
+    }
+}
+
+void BinaryResultLogObserver::writeRecord()
+{
+    uint32_t size = static_cast<uint32_t>(m_record.size() - 5);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        m_record[1 + i] = static_cast<char>((size >> (8 * i)) & 0xFF);
+    }
+    m_output.write(m_record.data(), m_record.size());
+}
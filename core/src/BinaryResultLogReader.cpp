@@ -0,0 +1,214 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "BinaryResultLogReader.hpp"
+#include "TestFrameworkErrorCategory.hpp"
+#include <cstring>
+
+using namespace Ishiko;
+
+namespace
+{
+
+// Reads the fields of a record. Reading past the end of the record doesn't throw, it makes the parser invalid.
+class RecordParser
+{
+public:
+    RecordParser(const std::string& record)
+        : m_record(record), m_position(0), m_valid(true)
+    {
+    }
+
+    bool valid() const noexcept
+    {
+        return m_valid;
+    }
+
+    uint8_t readByte()
+    {
+        if (!ensureAvailable(1))
+        {
+            return 0;
+        }
+        return static_cast<uint8_t>(m_record[m_position++]);
+    }
+
+    uint32_t readUInt32()
+    {
+        if (!ensureAvailable(4))
+        {
+            return 0;
+        }
+        uint32_t result = 0;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            result |= (static_cast<uint32_t>(static_cast<uint8_t>(m_record[m_position++])) << (8 * i));
+        }
+        return result;
+    }
+
+    int64_t readInt64()
+    {
+        if (!ensureAvailable(8))
+        {
+            return 0;
+        }
+        uint64_t result = 0;
+        for (size_t i = 0; i < 8; ++i)
+        {
+            result |= (static_cast<uint64_t>(static_cast<uint8_t>(m_record[m_position++])) << (8 * i));
+        }
+        return static_cast<int64_t>(result);
+    }
+
+    void readString(std::string& value)
+    {
+        uint32_t size = readUInt32();
+        if (!ensureAvailable(size))
+        {
+            value.clear();
+            return;
+        }
+        value.assign(m_record, m_position, size);
+        m_position += size;
+    }
+
+private:
+    bool ensureAvailable(size_t size)
+    {
+        if (m_valid && ((m_record.size() - m_position) < size))
+        {
+            m_valid = false;
+        }
+        return m_valid;
+    }
+
+private:
+    const std::string& m_record;
+    size_t m_position;
+    bool m_valid;
+};
+
+}
+
+const char BinaryResultLogReader::magic[8] = { 'I', 'S', 'H', 'K', 'T', 'L', 'O', 'G' };
+const uint32_t BinaryResultLogReader::version;
+
+BinaryResultLogReader::BinaryResultLogReader(std::istream& input)
+    : m_input(input), m_headerRead(false)
+{
+}
+
+bool BinaryResultLogReader::read(Record& record, Error& error)
+{
+    if (!m_headerRead)
+    {
+        if (!readHeader(error))
+        {
+            return false;
+        }
+        m_headerRead = true;
+    }
+
+    char prefix[5];
+    if (!m_input.read(prefix, sizeof(prefix)))
+    {
+        return false;
+    }
+    uint8_t type = static_cast<uint8_t>(prefix[0]);
+    uint32_t size = 0;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        size |= (static_cast<uint32_t>(static_cast<uint8_t>(prefix[1 + i])) << (8 * i));
+    }
+    m_buffer.resize(size);
+    if ((size > 0) && !m_input.read(&m_buffer[0], size))
+    {
+        return false;
+    }
+
+    RecordParser parser(m_buffer);
+    record.timestamp = parser.readInt64();
+    uint32_t depth = parser.readUInt32();
+    // Don't trust the depth before checking there is enough data for it
+    if (!parser.valid() || (depth > (m_buffer.size() / 4)))
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return false;
+    }
+    m_numberParts.resize(depth);
+    for (uint32_t i = 0; i < depth; ++i)
+    {
+        m_numberParts[i] = static_cast<int>(parser.readUInt32());
+    }
+    record.number = TestNumber(m_numberParts.data(), depth);
+
+    record.name.clear();
+    record.result = TestResult::unknown;
+    record.message.clear();
+    record.file.clear();
+    record.line = 0;
+    record.standardException = false;
+    switch (static_cast<RecordType>(type))
+    {
+    case RecordType::test_start:
+        parser.readString(record.name);
+        break;
+
+    case RecordType::test_end:
+        {
+            uint8_t result = parser.readByte();
+            if (result > static_cast<uint8_t>(TestResult::skipped))
+            {
+                Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+                return false;
+            }
+            record.result = static_cast<TestResult>(result);
+        }
+        break;
+
+    case RecordType::check_failed:
+        parser.readString(record.message);
+        parser.readString(record.file);
+        record.line = static_cast<int>(parser.readUInt32());
+        break;
+
+    case RecordType::exception_thrown:
+        record.standardException = (parser.readByte() != 0);
+        parser.readString(record.message);
+        break;
+
+    default:
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return false;
+    }
+    if (!parser.valid())
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return false;
+    }
+    record.type = static_cast<RecordType>(type);
+
+    return true;
+}
+
+bool BinaryResultLogReader::readHeader(Error& error)
+{
+    char header[sizeof(magic) + 4];
+    if (!m_input.read(header, sizeof(header)) || (memcmp(header, magic, sizeof(magic)) != 0))
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return false;
+    }
+    uint32_t logVersion = 0;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        logVersion |= (static_cast<uint32_t>(static_cast<uint8_t>(header[sizeof(magic) + i])) << (8 * i));
+    }
+    if (logVersion > version)
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "CapturedOutput.hpp"
+#include "TestFrameworkErrorCategory.hpp"
+#include <Ishiko/FileSystem.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <algorithm>
+
+using namespace Ishiko;
+
+CapturedOutput::CapturedOutput(size_t maxMemorySize)
+    : m_maxMemorySize(maxMemorySize), m_size(0), m_spillFile(nullptr), m_spillFailed(false)
+{
+}
+
+CapturedOutput::~CapturedOutput()
+{
+    closeSpillFile();
+}
+
+size_t CapturedOutput::maxMemorySize() const noexcept
+{
+    return m_maxMemorySize;
+}
+
+void CapturedOutput::setMaxMemorySize(size_t maxMemorySize)
+{
+    m_maxMemorySize = maxMemorySize;
+}
+
+void CapturedOutput::setSpillFilePath(const boost::filesystem::path& path)
+{
+    m_spillFilePath = path;
+}
+
+void CapturedOutput::append(const char* data, size_t size)
+{
+    if (!m_spillFile && !m_spillFailed && ((m_size + size) > m_maxMemorySize) && !m_spillFilePath.empty())
+    {
+        // We are about to exceed the memory limit, move what we have so far to the spill file. From then on all the
+        // output goes to the file as well so that it holds the complete output.
+        m_spillFile = fopen(m_spillFilePath.string().c_str(), "wb");
+        if (m_spillFile)
+        {
+            fwrite(m_data.data(), 1, m_data.size(), m_spillFile);
+        }
+        else
+        {
+            m_spillFailed = true;
+        }
+    }
+    if (m_spillFile)
+    {
+        fwrite(data, 1, size, m_spillFile);
+    }
+
+    if (m_data.size() < m_maxMemorySize)
+    {
+        m_data.append(data, std::min(size, m_maxMemorySize - m_data.size()));
+    }
+    m_size += size;
+}
+
+void CapturedOutput::clear()
+{
+    closeSpillFile();
+    m_data.clear();
+    m_size = 0;
+    m_spillFailed = false;
+}
+
+size_t CapturedOutput::size() const noexcept
+{
+    return m_size;
+}
+
+const std::string& CapturedOutput::data() const noexcept
+{
+    return m_data;
+}
+
+bool CapturedOutput::truncated() const noexcept
+{
+    return (m_size > m_data.size());
+}
+
+bool CapturedOutput::spilled() const noexcept
+{
+    return (m_spillFile != nullptr);
+}
+
+const boost::filesystem::path& CapturedOutput::spillFilePath() const noexcept
+{
+    return m_spillFilePath;
+}
+
+void CapturedOutput::save(const boost::filesystem::path& path, Error& error)
+{
+    if (m_spillFile)
+    {
+        fflush(m_spillFile);
+        if (path != m_spillFilePath)
+        {
+            FileSystem::CopySingleFile(m_spillFilePath, path, error);
+        }
+    }
+    else
+    {
+        FILE* file = fopen(path.string().c_str(), "wb");
+        if (!file)
+        {
+            Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+            return;
+        }
+        fwrite(m_data.data(), 1, m_data.size(), file);
+        fclose(file);
+    }
+}
+
+void CapturedOutput::closeSpillFile()
+{
+    if (m_spillFile)
+    {
+        fclose(m_spillFile);
+        m_spillFile = nullptr;
+    }
+}
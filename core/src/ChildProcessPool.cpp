@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ChildProcessPool.hpp"
+#include <algorithm>
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+#include <errno.h>
+#include <poll.h>
+#endif
+
+using namespace Ishiko;
+
+namespace
+{
+
+// How often processes are checked for exit when the platform has no exit descriptor, in milliseconds
+const int exitPollingInterval = 10;
+
+bool IsComplete(const PipedChildProcess& process)
+{
+    return (process.hasExited() && (process.standardOutputDescriptor() < 0)
+        && (process.standardErrorDescriptor() < 0));
+}
+
+}
+
+ChildProcessPool::ChildProcessPool(size_t maxSize)
+    : m_maxSize(maxSize)
+{
+}
+
+size_t ChildProcessPool::maxSize() const noexcept
+{
+    return m_maxSize;
+}
+
+size_t ChildProcessPool::size() const noexcept
+{
+    return m_processes.size();
+}
+
+bool ChildProcessPool::full() const noexcept
+{
+    return (m_processes.size() >= m_maxSize);
+}
+
+void ChildProcessPool::add(PipedChildProcess& process)
+{
+    m_processes.push_back(&process);
+}
+
+void ChildProcessPool::remove(PipedChildProcess& process)
+{
+    m_processes.erase(std::remove(m_processes.begin(), m_processes.end(), &process), m_processes.end());
+}
+
+void ChildProcessPool::waitForExit(PipedChildProcess& process)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    while (!IsComplete(process))
+    {
+        serviceProcesses(-1);
+    }
+#else
+    process.readAllOutput();
+    process.waitForExit();
+#endif
+}
+
+bool ChildProcessPool::waitForExit(PipedChildProcess& process, std::chrono::steady_clock::time_point deadline)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    while (!IsComplete(process))
+    {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+        {
+            return false;
+        }
+        // Round up so we don't spin when less than a millisecond remains
+        std::chrono::microseconds remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - now);
+        serviceProcesses((int)((remaining.count() + 999) / 1000));
+    }
+    return true;
+#else
+    waitForExit(process);
+    return true;
+#endif
+}
+
+void ChildProcessPool::serviceProcesses(int timeout)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    std::vector<pollfd> fds;
+    std::vector<PipedChildProcess*> owners;
+    bool pollForExit = false;
+    for (PipedChildProcess* process : m_processes)
+    {
+        // Exit descriptors can be shared between processes, see PipedChildProcess::exitDescriptor(), so the
+        // notification may have been consumed while servicing another process
+        if (!process->hasExited())
+        {
+            process->tryWaitForExit();
+        }
+
+        int descriptors[3] = {
+            process->standardOutputDescriptor(), process->standardErrorDescriptor(), process->exitDescriptor()
+        };
+        for (int descriptor : descriptors)
+        {
+            if (descriptor >= 0)
+            {
+                pollfd fd;
+                fd.fd = descriptor;
+                fd.events = POLLIN;
+                fd.revents = 0;
+                fds.push_back(fd);
+                owners.push_back(process);
+            }
+        }
+        if (!process->hasExited() && (process->exitDescriptor() < 0))
+        {
+            // Without an exit descriptor the only option is to check periodically
+            pollForExit = true;
+        }
+    }
+    if (fds.empty() && !pollForExit)
+    {
+        return;
+    }
+    if (pollForExit && ((timeout < 0) || (timeout > exitPollingInterval)))
+    {
+        timeout = exitPollingInterval;
+    }
+
+    int ready = poll(fds.data(), fds.size(), timeout);
+    if (ready <= 0)
+    {
+        // Either a timeout, in which case the next call will check for exits again, or EINTR
+        return;
+    }
+    for (size_t i = 0; i < fds.size(); ++i)
+    {
+        if (fds[i].revents != 0)
+        {
+            PipedChildProcess& process = *owners[i];
+            if (fds[i].fd == process.exitDescriptor())
+            {
+                process.tryWaitForExit();
+            }
+            else
+            {
+                // The callbacks may have closed the streams, readDescriptor ignores descriptors that are no longer valid
+                process.readDescriptor(fds[i].fd);
+            }
+        }
+    }
+#endif
+}
@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ChildProcessResources.hpp"
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+#include <sys/resource.h>
+#endif
+
+using namespace Ishiko;
+
+ChildProcessResourceUsage::ChildProcessResourceUsage()
+    : userTime(0), systemTime(0), wallTime(0), maxResidentSetSize(0), blockInputOperations(0),
+    blockOutputOperations(0)
+{
+}
+
+ChildProcessResourceLimits::ChildProcessResourceLimits()
+    : maxCPUTime(0), maxMemorySize(0), wallTimeout(0)
+{
+}
+
+void ChildProcessResourceLimits::applyToCurrentProcess() const
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    if (maxCPUTime.count() > 0)
+    {
+        // The kernel sends SIGXCPU at the soft limit and SIGKILL at the hard limit
+        rlimit limit;
+        limit.rlim_cur = (rlim_t)((maxCPUTime.count() + 999) / 1000);
+        limit.rlim_max = limit.rlim_cur + 1;
+        setrlimit(RLIMIT_CPU, &limit);
+    }
+    if (maxMemorySize > 0)
+    {
+        rlimit limit;
+        limit.rlim_cur = (rlim_t)maxMemorySize;
+        limit.rlim_max = (rlim_t)maxMemorySize;
+        setrlimit(RLIMIT_AS, &limit);
+    }
+#endif
+}
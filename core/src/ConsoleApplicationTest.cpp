@@ -2,28 +2,225 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "ConsoleApplicationTest.hpp"
+#include "IncrementalFileComparison.hpp"
+#include "PersistentStorage.hpp"
+#include "PipedChildProcess.hpp"
 #include "TestMacros.hpp"
 #include <Ishiko/Process.hpp>
 
 using namespace Ishiko;
 
+namespace
+{
+
+// Default in-memory capture size, this is only used if setInMemoryOutputCapture is not called
+const size_t defaultMaxMemorySize = 1024 * 1024;
+
+}
+
+/// The state of an application started with in-memory output capture.
+
+/// This is kept separate from the test because the application may be launched well before the test runs when a
+/// ChildProcessPool is used.
+class ConsoleApplicationTest::InMemoryRun : public PipedChildProcess::Callbacks
+{
+public:
+    InMemoryRun(CapturedOutput& standardOutput, CapturedOutput& standardError, bool abortOnFirstMismatch,
+        const ChildProcessResourceLimits& resourceLimits);
+    ~InMemoryRun() override;
+
+    void onStandardOutput(const char* data, size_t size) override;
+    void onStandardError(const char* data, size_t size) override;
+
+    void start(const std::string& commandLine, const boost::filesystem::path& standardOutputReferenceFilePath,
+        const boost::filesystem::path& standardErrorReferenceFilePath, ChildProcessPool* pool);
+    void waitForExit();
+
+    const Error& startError() const noexcept;
+    PipedChildProcess& process();
+    IncrementalFileComparison& standardOutputComparison();
+    IncrementalFileComparison& standardErrorComparison();
+    bool aborted() const noexcept;
+    bool timedOut() const noexcept;
+
+private:
+    void abortIfMismatch();
+
+private:
+    CapturedOutput& m_standardOutput;
+    CapturedOutput& m_standardError;
+    bool m_abortOnFirstMismatch;
+    std::chrono::milliseconds m_wallTimeout;
+    IncrementalFileComparison m_standardOutputComparison;
+    IncrementalFileComparison m_standardErrorComparison;
+    PipedChildProcess m_process;
+    ChildProcessPool* m_pool;
+    Error m_startError;
+    std::chrono::steady_clock::time_point m_deadline;
+    bool m_aborted;
+    bool m_timedOut;
+};
+
+ConsoleApplicationTest::InMemoryRun::InMemoryRun(CapturedOutput& standardOutput, CapturedOutput& standardError,
+    bool abortOnFirstMismatch, const ChildProcessResourceLimits& resourceLimits)
+    : m_standardOutput(standardOutput), m_standardError(standardError), m_abortOnFirstMismatch(abortOnFirstMismatch),
+    m_wallTimeout(resourceLimits.wallTimeout), m_pool(nullptr), m_aborted(false), m_timedOut(false)
+{
+    m_process.setResourceLimits(resourceLimits);
+}
+
+ConsoleApplicationTest::InMemoryRun::~InMemoryRun()
+{
+    if (m_pool)
+    {
+        m_pool->remove(m_process);
+    }
+}
+
+void ConsoleApplicationTest::InMemoryRun::onStandardOutput(const char* data, size_t size)
+{
+    m_standardOutput.append(data, size);
+    if (m_standardOutputComparison.isOpen())
+    {
+        m_standardOutputComparison.compare(data, size);
+        abortIfMismatch();
+    }
+}
+
+void ConsoleApplicationTest::InMemoryRun::onStandardError(const char* data, size_t size)
+{
+    m_standardError.append(data, size);
+    if (m_standardErrorComparison.isOpen())
+    {
+        m_standardErrorComparison.compare(data, size);
+        abortIfMismatch();
+    }
+}
+
+void ConsoleApplicationTest::InMemoryRun::start(const std::string& commandLine,
+    const boost::filesystem::path& standardOutputReferenceFilePath,
+    const boost::filesystem::path& standardErrorReferenceFilePath, ChildProcessPool* pool)
+{
+    // Failures to open the reference files are reported by the test when it checks whether the comparisons are open
+    if (!standardOutputReferenceFilePath.empty())
+    {
+        Error error;
+        m_standardOutputComparison.open(standardOutputReferenceFilePath, error);
+    }
+    if (!standardErrorReferenceFilePath.empty())
+    {
+        Error error;
+        m_standardErrorComparison.open(standardErrorReferenceFilePath, error);
+    }
+
+    m_process.start(commandLine, *this, m_startError);
+    m_deadline = std::chrono::steady_clock::now() + m_wallTimeout;
+    if (!m_startError && pool)
+    {
+        m_pool = pool;
+        m_pool->add(m_process);
+    }
+}
+
+void ConsoleApplicationTest::InMemoryRun::waitForExit()
+{
+    if (m_wallTimeout.count() > 0)
+    {
+        // A pool of one is used to get the timeout handling when the test wasn't launched through a pool
+        ChildProcessPool localPool(1);
+        ChildProcessPool* pool = m_pool;
+        if (!pool)
+        {
+            pool = &localPool;
+            pool->add(m_process);
+        }
+        if (!pool->waitForExit(m_process, m_deadline))
+        {
+            m_process.kill();
+            m_process.stopReading();
+            m_timedOut = true;
+            pool->waitForExit(m_process);
+        }
+    }
+    else if (m_pool)
+    {
+        m_pool->waitForExit(m_process);
+    }
+    else
+    {
+        m_process.readAllOutput();
+        m_process.waitForExit();
+    }
+}
+
+const Error& ConsoleApplicationTest::InMemoryRun::startError() const noexcept
+{
+    return m_startError;
+}
+
+PipedChildProcess& ConsoleApplicationTest::InMemoryRun::process()
+{
+    return m_process;
+}
+
+IncrementalFileComparison& ConsoleApplicationTest::InMemoryRun::standardOutputComparison()
+{
+    return m_standardOutputComparison;
+}
+
+IncrementalFileComparison& ConsoleApplicationTest::InMemoryRun::standardErrorComparison()
+{
+    return m_standardErrorComparison;
+}
+
+bool ConsoleApplicationTest::InMemoryRun::aborted() const noexcept
+{
+    return m_aborted;
+}
+
+bool ConsoleApplicationTest::InMemoryRun::timedOut() const noexcept
+{
+    return m_timedOut;
+}
+
+void ConsoleApplicationTest::InMemoryRun::abortIfMismatch()
+{
+    if (m_abortOnFirstMismatch && !m_aborted
+        && (m_standardOutputComparison.mismatch() || m_standardErrorComparison.mismatch()))
+    {
+        // There is no point waiting for the rest of the output, the test has failed already
+        m_process.kill();
+        m_process.stopReading();
+        m_aborted = true;
+    }
+}
+
 ConsoleApplicationTest::ConsoleApplicationTest(const TestNumber& number, const std::string& name,
     const std::string& commandLine, int expectedExitCode)
-    : Test(number, name), m_commandLine(commandLine), m_checkExitCode(true), m_expectedExitCode(expectedExitCode)
+    : Test(number, name), m_commandLine(commandLine), m_checkExitCode(true), m_expectedExitCode(expectedExitCode),
+    m_inMemoryOutputCapture(false), m_abortOnFirstMismatch(false), m_standardOutput(defaultMaxMemorySize),
+    m_standardError(defaultMaxMemorySize), m_launched(false)
 {
 }
 
 ConsoleApplicationTest::ConsoleApplicationTest(const TestNumber& number, const std::string& name,
     const std::string& commandLine, int expectedExitCode, const TestContext& context)
     : Test(number, name, context), m_commandLine(commandLine), m_checkExitCode(true),
-    m_expectedExitCode(expectedExitCode)
+    m_expectedExitCode(expectedExitCode), m_inMemoryOutputCapture(false), m_abortOnFirstMismatch(false),
+    m_standardOutput(defaultMaxMemorySize), m_standardError(defaultMaxMemorySize), m_launched(false)
 {
 }
 
 ConsoleApplicationTest::ConsoleApplicationTest(const TestNumber& number, const std::string& name,
     const std::string& command_line, std::function<void(int exit_code, ConsoleApplicationTest& test)> run_fct,
     const TestContext& context)
-    : Test(number, name, context), m_commandLine(command_line), m_checkExitCode(false), m_run_fct(run_fct)
+    : Test(number, name, context), m_commandLine(command_line), m_checkExitCode(false),
+    m_inMemoryOutputCapture(false), m_abortOnFirstMismatch(false), m_standardOutput(defaultMaxMemorySize),
+    m_standardError(defaultMaxMemorySize), m_run_fct(run_fct), m_launched(false)
+{
+}
+
+ConsoleApplicationTest::~ConsoleApplicationTest() noexcept
 {
 }
 
@@ -37,41 +234,306 @@ void ConsoleApplicationTest::setStandardOutputReferenceFilePath(const boost::fil
     m_standardOutputTest.setReferenceFilePath(path);
 }
 
+void ConsoleApplicationTest::setStandardErrorReferenceFilePath(const boost::filesystem::path& path)
+{
+    m_standardErrorReferenceFilePath = path;
+}
+
+void ConsoleApplicationTest::setInMemoryOutputCapture(size_t maxMemorySize)
+{
+    m_inMemoryOutputCapture = true;
+    m_standardOutput.setMaxMemorySize(maxMemorySize);
+    m_standardError.setMaxMemorySize(maxMemorySize);
+}
+
+void ConsoleApplicationTest::setAbortOnFirstMismatch(bool abort)
+{
+    m_abortOnFirstMismatch = abort;
+}
+
+const CapturedOutput& ConsoleApplicationTest::standardOutput() const
+{
+    return m_standardOutput;
+}
+
+const CapturedOutput& ConsoleApplicationTest::standardError() const
+{
+    return m_standardError;
+}
+
+void ConsoleApplicationTest::setResourceLimits(const ChildProcessResourceLimits& limits)
+{
+    m_resourceLimits = limits;
+}
+
+const ChildProcessResourceUsage& ConsoleApplicationTest::resourceUsage() const
+{
+    return m_resourceUsage;
+}
+
+void ConsoleApplicationTest::setForkServer(std::shared_ptr<ForkServer> server)
+{
+    m_forkServer = server;
+}
+
+bool ConsoleApplicationTest::launch(ChildProcessPool& pool)
+{
+    // The setup actions could depend on the tests before this one having completed, in which case the test is run when
+    // the sequence gets to it
+    if (!m_inMemoryOutputCapture || !PipedChildProcess::IsSupported() || hasSetupActions())
+    {
+        return false;
+    }
+
+    m_launched = true;
+    try
+    {
+        Test::setup();
+    }
+    catch (...)
+    {
+        // The exception is rethrown by setup() when the test is run so it gets reported in the same way as when the
+        // test is not launched in advance
+        m_launchException = std::current_exception();
+        return true;
+    }
+    startInMemoryRun(&pool);
+
+    return true;
+}
+
+void ConsoleApplicationTest::setup()
+{
+    if (m_launched)
+    {
+        // The setup was already done by launch()
+        m_launched = false;
+        if (m_launchException)
+        {
+            std::exception_ptr exception = m_launchException;
+            m_launchException = nullptr;
+            std::rethrow_exception(exception);
+        }
+    }
+    else
+    {
+        Test::setup();
+    }
+}
+
 // TODO: this is used the test macros but I probably want custom error messages
 void ConsoleApplicationTest::doRun()
 {
     // The test macros rely a variable called "test" to be defined.
     Test& test = *this;
 
-    ChildProcessBuilder processCreator(m_commandLine);
-    if (!m_standardOutputTest.outputFilePath().empty())
+    int exitCode = -1;
+    if (m_inMemoryRun)
+    {
+        // The application was started by launch()
+        exitCode = completeInMemoryRun();
+    }
+    else if (m_inMemoryOutputCapture && PipedChildProcess::IsSupported())
     {
-        processCreator.redirectStandardOutputToFile(m_standardOutputTest.outputFilePath().string());
+        startInMemoryRun(nullptr);
+        exitCode = completeInMemoryRun();
     }
+    else
+    {
+        ChildProcessBuilder processCreator(m_commandLine);
+        if (!m_standardOutputTest.outputFilePath().empty())
+        {
+            processCreator.redirectStandardOutputToFile(m_standardOutputTest.outputFilePath().string());
+        }
 
-    Error error;
-    ChildProcess processHandle = processCreator.start(error);
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
 
-    ISHIKO_TEST_ABORT_IF(error);
-    
-    processHandle.waitForExit();
+        Error error;
+        ChildProcess processHandle = processCreator.start(error);
 
-    if (m_checkExitCode)
-    {
-        ISHIKO_TEST_FAIL_IF_NEQ(processHandle.exitCode(), m_expectedExitCode);
-    }
+        ISHIKO_TEST_ABORT_IF(error);
 
-    if (!m_standardOutputTest.outputFilePath().empty() && !m_standardOutputTest.referenceFilePath().empty())
-    {
-        m_standardOutputTest.run(test, __FILE__, __LINE__);
+        processHandle.waitForExit();
+        exitCode = processHandle.exitCode();
+
+        // ChildProcess doesn't give us access to the usage of the process, only the wall time is known
+        m_resourceUsage = ChildProcessResourceUsage();
+        m_resourceUsage.wallTime =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+        if (m_checkExitCode)
+        {
+            ISHIKO_TEST_FAIL_IF_NEQ(exitCode, m_expectedExitCode);
+        }
+        checkResourceUsage(true);
+
+        if (!m_standardOutputTest.outputFilePath().empty() && !m_standardOutputTest.referenceFilePath().empty())
+        {
+            m_standardOutputTest.run(test, __FILE__, __LINE__);
+        }
+        keepOutputIfFailed();
     }
 
     if (m_run_fct)
     {
-        m_run_fct(processHandle.exitCode(), *this);
+        m_run_fct(exitCode, *this);
     }
     else
     {
         ISHIKO_TEST_PASS();
     }
 }
+
+void ConsoleApplicationTest::startInMemoryRun(ChildProcessPool* pool)
+{
+    m_standardOutput.clear();
+    m_standardOutput.setSpillFilePath(m_standardOutputTest.outputFilePath());
+    m_standardError.clear();
+
+    m_inMemoryRun.reset(new InMemoryRun(m_standardOutput, m_standardError, m_abortOnFirstMismatch,
+        m_resourceLimits));
+    m_inMemoryRun->process().setForkServer(m_forkServer);
+    m_inMemoryRun->start(m_commandLine, m_standardOutputTest.referenceFilePath(), m_standardErrorReferenceFilePath,
+        pool);
+}
+
+int ConsoleApplicationTest::completeInMemoryRun()
+{
+    // The test macros rely a variable called "test" to be defined.
+    Test& test = *this;
+
+    // We take ownership of the run so that the application is cleaned up even if the test is aborted
+    std::unique_ptr<InMemoryRun> run(std::move(m_inMemoryRun));
+
+    const boost::filesystem::path& standardOutputReferenceFilePath = m_standardOutputTest.referenceFilePath();
+    if (!standardOutputReferenceFilePath.empty() && !run->standardOutputComparison().isOpen())
+    {
+        fail("failed to open reference file: " + standardOutputReferenceFilePath.string(), __FILE__, __LINE__);
+    }
+    if (!m_standardErrorReferenceFilePath.empty() && !run->standardErrorComparison().isOpen())
+    {
+        fail("failed to open reference file: " + m_standardErrorReferenceFilePath.string(), __FILE__, __LINE__);
+    }
+
+    ISHIKO_TEST_ABORT_IF(run->startError());
+
+    run->waitForExit();
+    int exitCode = run->process().exitCode();
+    m_resourceUsage = run->process().resourceUsage();
+
+    if (run->timedOut())
+    {
+        fail("application was terminated because it didn't complete within "
+            + std::to_string(m_resourceLimits.wallTimeout.count()) + " ms", __FILE__, __LINE__);
+    }
+    else if (run->aborted())
+    {
+        fail("application was terminated because its output differs from the reference", __FILE__, __LINE__);
+    }
+    else if (m_checkExitCode)
+    {
+        ISHIKO_TEST_FAIL_IF_NEQ(exitCode, m_expectedExitCode);
+    }
+
+    // The wall timeout was already enforced
+    checkResourceUsage(false);
+
+    IncrementalFileComparison& standardOutputComparison = run->standardOutputComparison();
+    if (standardOutputComparison.isOpen() && !standardOutputComparison.finish())
+    {
+        fail("standard output differs from reference file " + standardOutputReferenceFilePath.string()
+            + " at line " + std::to_string(standardOutputComparison.mismatchLine()), __FILE__, __LINE__);
+        if (!m_standardOutputTest.outputFilePath().empty())
+        {
+            Error saveError;
+            m_standardOutput.save(m_standardOutputTest.outputFilePath(), saveError);
+            if (saveError)
+            {
+                fail("failed to save standard output to " + m_standardOutputTest.outputFilePath().string(), __FILE__,
+                    __LINE__);
+            }
+        }
+        persistCapturedOutput(m_standardOutput, standardOutputReferenceFilePath);
+    }
+    IncrementalFileComparison& standardErrorComparison = run->standardErrorComparison();
+    if (standardErrorComparison.isOpen() && !standardErrorComparison.finish())
+    {
+        fail("standard error differs from reference file " + m_standardErrorReferenceFilePath.string()
+            + " at line " + std::to_string(standardErrorComparison.mismatchLine()), __FILE__, __LINE__);
+        persistCapturedOutput(m_standardError, m_standardErrorReferenceFilePath);
+    }
+    keepOutputIfFailed();
+
+    return exitCode;
+}
+
+void ConsoleApplicationTest::checkResourceUsage(bool checkWallTime)
+{
+    if ((m_resourceLimits.maxCPUTime.count() > 0)
+        && ((m_resourceUsage.userTime + m_resourceUsage.systemTime) >= m_resourceLimits.maxCPUTime))
+    {
+        fail("application exceeded its CPU time limit of " + std::to_string(m_resourceLimits.maxCPUTime.count())
+            + " ms", __FILE__, __LINE__);
+    }
+    if ((m_resourceLimits.maxMemorySize > 0) && (m_resourceUsage.maxResidentSetSize > m_resourceLimits.maxMemorySize))
+    {
+        fail("application exceeded its memory limit of " + std::to_string(m_resourceLimits.maxMemorySize) + " bytes",
+            __FILE__, __LINE__);
+    }
+    if (checkWallTime && (m_resourceLimits.wallTimeout.count() > 0)
+        && (m_resourceUsage.wallTime > m_resourceLimits.wallTimeout))
+    {
+        fail("application didn't complete within " + std::to_string(m_resourceLimits.wallTimeout.count()) + " ms",
+            __FILE__, __LINE__);
+    }
+}
+
+void ConsoleApplicationTest::addPropertiesToJUnitXMLTestReport(JUnitXMLWriter& writer) const
+{
+    if (m_resourceUsage.wallTime.count() == 0)
+    {
+        // The application never ran
+        return;
+    }
+
+    writer.writePropertiesStart();
+    writer.writeProperty("user-time-us", std::to_string(m_resourceUsage.userTime.count()));
+    writer.writeProperty("system-time-us", std::to_string(m_resourceUsage.systemTime.count()));
+    writer.writeProperty("wall-time-us", std::to_string(m_resourceUsage.wallTime.count()));
+    writer.writeProperty("max-rss-bytes", std::to_string(m_resourceUsage.maxResidentSetSize));
+    writer.writeProperty("block-input-operations", std::to_string(m_resourceUsage.blockInputOperations));
+    writer.writeProperty("block-output-operations", std::to_string(m_resourceUsage.blockOutputOperations));
+    writer.writePropertiesEnd();
+}
+
+void ConsoleApplicationTest::persistCapturedOutput(CapturedOutput& output,
+    const boost::filesystem::path& referenceFilePath)
+{
+    // The output is saved next to a copy of the reference, e.g. file.output.txt and file.txt
+    Error error;
+    boost::filesystem::path targetDirectory = PersistentStorage::CreateTestDirectory(*this, error);
+    if (!error && !targetDirectory.empty())
+    {
+        boost::filesystem::path outputFileName = referenceFilePath.stem();
+        outputFileName += ".output";
+        outputFileName += referenceFilePath.extension();
+        output.save(targetDirectory / outputFileName, error);
+        PersistentStorage::CopySingleFile(*this, referenceFilePath, error);
+    }
+    if (error)
+    {
+        fail("failed to save the output and reference files to the persistent storage", __FILE__, __LINE__);
+    }
+}
+
+void ConsoleApplicationTest::keepOutputIfFailed()
+{
+    // The output of a failed run is what the user will want to look at so it must survive a memory-backed output
+    // directory
+    MemoryBackedOutputDirectory* memoryBackedOutputDirectory = context().getMemoryBackedOutputDirectory();
+    if (memoryBackedOutputDirectory && (result() == TestResult::failed)
+        && !m_standardOutputTest.outputFilePath().empty())
+    {
+        memoryBackedOutputDirectory->keep(m_standardOutputTest.outputFilePath());
+    }
+}
@@ -5,6 +5,7 @@
 */
 
 #include "DirectoriesTeardownAction.hpp"
+#include "Test.hpp"
 #include <boost/filesystem/operations.hpp>
 
 namespace Ishiko
@@ -14,7 +15,32 @@ void DirectoriesTeardownAction::teardown()
 {
     for (size_t i = 0; i < d_directories.size(); ++i)
     {
-        boost::filesystem::remove(d_directories[i]);
+        boost::filesystem::remove_all(d_directories[i]);
+    }
+}
+
+void DirectoriesTeardownAction::teardown(const Test& test)
+{
+    BackgroundDeleter* deleter = test.context().getBackgroundDeleter();
+    if (deleter)
+    {
+        for (size_t i = 0; i < d_directories.size(); ++i)
+        {
+            // A directory created again at the same path must not be caught by the deletion still pending here
+            boost::filesystem::path tombstone;
+            if (BackgroundDeleter::RenameToTombstone(d_directories[i], tombstone))
+            {
+                deleter->removeAll(tombstone);
+            }
+            else
+            {
+                boost::filesystem::remove_all(d_directories[i]);
+            }
+        }
+    }
+    else
+    {
+        teardown();
     }
 }
 
@@ -11,6 +11,21 @@
 
 using namespace Ishiko;
 
+namespace
+{
+
+// Keeps the output directory of a failed comparison when the output directory is memory-backed
+void KeepOutputDirectory(Test& test, const boost::filesystem::path& path)
+{
+    MemoryBackedOutputDirectory* memoryBackedOutputDirectory = test.context().getMemoryBackedOutputDirectory();
+    if (memoryBackedOutputDirectory)
+    {
+        memoryBackedOutputDirectory->keep(path);
+    }
+}
+
+}
+
 DirectoryComparisonTestCheck::DirectoryComparisonTestCheck()
 {
 }
@@ -36,6 +51,7 @@ void DirectoryComparisonTestCheck::run(Test& test, const char* file, int line)
     {
         // TODO: more info, check which files are added or missing
         test.fail(file, line);
+        KeepOutputDirectory(test, m_outputDirectoryPath);
         return;
     }
 
@@ -54,6 +70,7 @@ void DirectoryComparisonTestCheck::run(Test& test, const char* file, int line)
     {
         // TODO: more info, check which files are added or missing
         test.fail(file, line);
+        KeepOutputDirectory(test, m_outputDirectoryPath);
         return;
     }
 
@@ -64,11 +81,10 @@ void DirectoryComparisonTestCheck::run(Test& test, const char* file, int line)
         [this, &test, file, line, &allCheckPassed](const boost::filesystem::path& referenceFilePath)
         {
             boost::filesystem::path outputFilePath = m_outputDirectoryPath / referenceFilePath.filename();
-            std::shared_ptr<FileComparisonTestCheck> check = std::make_shared<FileComparisonTestCheck>(outputFilePath,
-                referenceFilePath);
+            FileComparisonTestCheck check(outputFilePath, referenceFilePath);
             // TODO: if I add this to the test then I get automatic reporting of each file
-            check->run(test, file, line);
-            if (check->result() == TestCheck::Result::failed)
+            check.run(test, file, line);
+            if (check.result() == TestCheck::Result::failed)
             {
                 allCheckPassed = false;
             }
@@ -79,6 +95,11 @@ void DirectoryComparisonTestCheck::run(Test& test, const char* file, int line)
     {
         m_result = Result::passed;
     }
+    else
+    {
+        // The files that differ have already been kept but the rest of the directory gives them context
+        KeepOutputDirectory(test, m_outputDirectoryPath);
+    }
 }
 
 const boost::filesystem::path& DirectoryComparisonTestCheck::outputDirectoryPath() const
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "FileComparisonTestCheck.hpp"
+#include "PersistentStorage.hpp"
 #include "Test.hpp"
 #include <Ishiko/BasePlatform.hpp>
 #include <Ishiko/Diff.hpp>
@@ -134,24 +135,20 @@ void FileComparisonTestCheck::run(Test& test, const char* file, int line)
             test.fail(m_firstDifferentLine, file, line);   
         }
 
-        // TODO: have a toggle on command line to explicitly enable this?
+        MemoryBackedOutputDirectory* memoryBackedOutputDirectory = test.context().getMemoryBackedOutputDirectory();
+        if (memoryBackedOutputDirectory)
+        {
+            memoryBackedOutputDirectory->keep(m_outputFilePath);
+        }
 
+        // TODO: have a toggle on command line to explicitly enable this?
+        // TODO: we need to keep more than the filename, the entire relative path from output dir needs to be used
         Error persistenceError;
-        boost::filesystem::path persistentStoragePath = test.context().getOutputDirectory("persistent-storage",
-            persistenceError);
-        // TODO: ignore error only if the error is not found
-        if (!persistenceError)
+        PersistentStorage::CopySingleFile(test, m_outputFilePath, persistenceError);
+        PersistentStorage::CopySingleFile(test, m_referenceFilePath, persistenceError);
+        if (persistenceError)
         {
-            boost::filesystem::path targetDirectory = persistentStoragePath / test.name();
-            // TODO: CopyFile option to do that
-            boost::filesystem::create_directories(targetDirectory);
-            // TODO: we need to keep more than the filename, the entire relative path from output dir needs to be used
-            FileSystem::CopySingleFile(m_outputFilePath, (targetDirectory / m_outputFilePath.filename()),
-                persistenceError);
-            FileSystem::CopySingleFile(m_referenceFilePath, (targetDirectory / m_referenceFilePath.filename()),
-                persistenceError);
-
-            // TODO: what do if we cannot copy the files?
+            test.fail("failed to copy the output and reference files to the persistent storage", file, line);
         }
     }
     else
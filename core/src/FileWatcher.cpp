@@ -0,0 +1,268 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "FileWatcher.hpp"
+#include "TestFrameworkErrorCategory.hpp"
+#include <boost/filesystem/operations.hpp>
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+#include <errno.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace Ishiko;
+
+namespace
+{
+
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+// IN_ATTRIB is included because some tools only change the modification time of a file, e.g. touch
+const uint32_t watchMask = (IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ATTRIB
+    | IN_DELETE_SELF | IN_ONLYDIR);
+#endif
+
+boost::filesystem::path Normalize(const boost::filesystem::path& path)
+{
+    boost::filesystem::path result = boost::filesystem::absolute(path).lexically_normal();
+    // lexically_normal leaves a trailing "." for paths that end with a separator
+    if (result.filename() == ".")
+    {
+        result = result.parent_path();
+    }
+    return result;
+}
+
+}
+
+FileWatcher::FileWatcher()
+    : m_descriptor(-1)
+{
+}
+
+FileWatcher::~FileWatcher()
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    if (m_descriptor != -1)
+    {
+        close(m_descriptor);
+    }
+#endif
+}
+
+bool FileWatcher::IsSupported() noexcept
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FileWatcher::addDirectory(const boost::filesystem::path& path, Error& error)
+{
+    addWatches(Normalize(path), error);
+}
+
+void FileWatcher::addFile(const boost::filesystem::path& path, Error& error)
+{
+    boost::filesystem::path normalizedPath = Normalize(path);
+    int watchDescriptor = addWatch(normalizedPath.parent_path(), error);
+    if (watchDescriptor != -1)
+    {
+        Watch& watch = m_watches[watchDescriptor];
+        if (!watch.recursive)
+        {
+            watch.files.insert(normalizedPath.filename());
+        }
+    }
+}
+
+std::vector<boost::filesystem::path> FileWatcher::wait(std::chrono::milliseconds quietPeriod, Error& error)
+{
+    std::set<boost::filesystem::path> changedPaths;
+    if (m_descriptor == -1)
+    {
+        // Nothing is watched so we would wait forever
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return {};
+    }
+
+    // Changes to the files of a directory that aren't watched wake us up too but don't count
+    while (changedPaths.empty())
+    {
+        readEvents(-1, changedPaths, error);
+        if (error)
+        {
+            return {};
+        }
+    }
+    while (readEvents(static_cast<int>(quietPeriod.count()), changedPaths, error))
+    {
+    }
+    if (error)
+    {
+        return {};
+    }
+
+    return std::vector<boost::filesystem::path>(changedPaths.begin(), changedPaths.end());
+}
+
+int FileWatcher::addWatch(const boost::filesystem::path& directory, Error& error)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    if (m_descriptor == -1)
+    {
+        m_descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_descriptor == -1)
+        {
+            Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+            return -1;
+        }
+    }
+
+    int watchDescriptor = inotify_add_watch(m_descriptor, directory.c_str(), watchMask);
+    if (watchDescriptor == -1)
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return -1;
+    }
+    // inotify returns the existing watch descriptor if the directory is already watched
+    std::map<int, Watch>::iterator it = m_watches.find(watchDescriptor);
+    if (it == m_watches.end())
+    {
+        m_watches[watchDescriptor] = Watch{directory, false, {}};
+    }
+    return watchDescriptor;
+#else
+    Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+    return -1;
+#endif
+}
+
+void FileWatcher::addWatches(const boost::filesystem::path& directory, Error& error)
+{
+    int watchDescriptor = addWatch(directory, error);
+    if (watchDescriptor == -1)
+    {
+        return;
+    }
+    Watch& watch = m_watches[watchDescriptor];
+    watch.recursive = true;
+    watch.files.clear();
+
+    boost::system::error_code ec;
+    for (boost::filesystem::directory_iterator it(directory, ec), end; !ec && (it != end); it.increment(ec))
+    {
+        // Symbolic links aren't followed so that we can't loop forever
+        if (boost::filesystem::is_directory(it->symlink_status()))
+        {
+            addWatches(it->path(), error);
+            if (error)
+            {
+                return;
+            }
+        }
+    }
+}
+
+bool FileWatcher::readEvents(int timeout, std::set<boost::filesystem::path>& changedPaths, Error& error)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    pollfd descriptor;
+    descriptor.fd = m_descriptor;
+    descriptor.events = POLLIN;
+    int result = poll(&descriptor, 1, timeout);
+    if (result == 0)
+    {
+        return false;
+    }
+    else if (result < 0)
+    {
+        if (errno == EINTR)
+        {
+            return true;
+        }
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return false;
+    }
+
+    alignas(inotify_event) char buffer[16384];
+    while (true)
+    {
+        ssize_t length = read(m_descriptor, buffer, sizeof(buffer));
+        if (length <= 0)
+        {
+            if ((length < 0) && (errno == EINTR))
+            {
+                continue;
+            }
+            // EAGAIN, all the pending events have been read
+            break;
+        }
+
+        for (char* ptr = buffer; ptr < (buffer + length); ptr += (sizeof(inotify_event) + ((inotify_event*)ptr)->len))
+        {
+            const inotify_event* event = (const inotify_event*)ptr;
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                // Some events were lost so we report everything that is watched as changed
+                for (const std::pair<const int, Watch>& watch : m_watches)
+                {
+                    if (watch.second.recursive)
+                    {
+                        changedPaths.insert(watch.second.directory);
+                    }
+                    for (const boost::filesystem::path& file : watch.second.files)
+                    {
+                        changedPaths.insert(watch.second.directory / file);
+                    }
+                }
+                continue;
+            }
+
+            std::map<int, Watch>::iterator it = m_watches.find(event->wd);
+            if (it == m_watches.end())
+            {
+                continue;
+            }
+            if (event->mask & IN_IGNORED)
+            {
+                // The directory was removed, the removal itself was reported by its parent if it's watched
+                m_watches.erase(it);
+                continue;
+            }
+
+            if (event->len == 0)
+            {
+                if (it->second.recursive)
+                {
+                    changedPaths.insert(it->second.directory);
+                }
+                continue;
+            }
+            boost::filesystem::path name = event->name;
+            boost::filesystem::path path = it->second.directory / name;
+            if (it->second.recursive)
+            {
+                changedPaths.insert(path);
+                if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO)))
+                {
+                    // The new directory may already have files in it by the time we watch it but they will be
+                    // reported as part of the directory
+                    Error ignoredError;
+                    addWatches(path, ignoredError);
+                }
+            }
+            else if (it->second.files.find(name) != it->second.files.end())
+            {
+                changedPaths.insert(path);
+            }
+        }
+    }
+    return true;
+#else
+    Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+    return false;
+#endif
+}
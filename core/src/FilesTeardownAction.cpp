@@ -5,6 +5,7 @@
 */
 
 #include "FilesTeardownAction.hpp"
+#include "Test.hpp"
 #include <boost/filesystem/operations.hpp>
 
 namespace Ishiko
@@ -18,6 +19,31 @@ void FilesTeardownAction::teardown()
     }
 }
 
+void FilesTeardownAction::teardown(const Test& test)
+{
+    BackgroundDeleter* deleter = test.context().getBackgroundDeleter();
+    if (deleter)
+    {
+        for (size_t i = 0; i < d_files.size(); ++i)
+        {
+            // The path is renamed first so that the test can be run again while the deletion is still pending
+            boost::filesystem::path tombstone;
+            if (BackgroundDeleter::RenameToTombstone(d_files[i], tombstone))
+            {
+                deleter->remove(tombstone);
+            }
+            else
+            {
+                boost::filesystem::remove(d_files[i]);
+            }
+        }
+    }
+    else
+    {
+        teardown();
+    }
+}
+
 void FilesTeardownAction::add(const boost::filesystem::path& path)
 {
     d_files.push_back(path);
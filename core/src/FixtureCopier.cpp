@@ -0,0 +1,408 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "FixtureCopier.hpp"
+#include "TestFrameworkErrorCategory.hpp"
+#include <boost/filesystem/operations.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <utility>
+#include <vector>
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Ishiko;
+
+namespace
+{
+
+// Below this number of files the cost of starting threads outweighs the benefits
+const size_t minFilesPerThread = 16;
+
+// Creates the destination directories and lists the files to copy
+bool CollectFiles(const boost::filesystem::path& source, const boost::filesystem::path& destination,
+    std::vector<std::pair<boost::filesystem::path, boost::filesystem::path>>& files)
+{
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(destination, ec);
+    if (ec)
+    {
+        return false;
+    }
+    for (boost::filesystem::directory_iterator it(source, ec); !ec && (it != boost::filesystem::directory_iterator());
+        it.increment(ec))
+    {
+        boost::filesystem::path destinationPath = destination / it->path().filename();
+        if (boost::filesystem::is_directory(it->path(), ec))
+        {
+            if (!CollectFiles(it->path(), destinationPath, files))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            files.emplace_back(it->path(), destinationPath);
+        }
+    }
+    return !ec;
+}
+
+// Whether both paths name the same directory entry. Hard links to the same file are different entries so a
+// destination linked to its source by a previous copy can still be replaced.
+bool IsSameEntry(const boost::filesystem::path& path1, const boost::filesystem::path& path2)
+{
+    if (path1.filename() != path2.filename())
+    {
+        return false;
+    }
+    boost::system::error_code ec;
+    bool result = boost::filesystem::equivalent(
+        (path1.has_parent_path() ? path1.parent_path() : boost::filesystem::path(".")),
+        (path2.has_parent_path() ? path2.parent_path() : boost::filesystem::path(".")), ec);
+    return (!ec && result);
+}
+
+// The file the data is written to before it replaces the destination. It is in the same directory so the rename is
+// atomic.
+boost::filesystem::path TemporaryPath(const boost::filesystem::path& destination)
+{
+    return destination.parent_path()
+        / boost::filesystem::unique_path(destination.filename().string() + ".%%%%-%%%%-%%%%.tmp");
+}
+
+// Copies the data with stdio, this works everywhere
+bool CopyFileData(const boost::filesystem::path& source, const boost::filesystem::path& destination)
+{
+    FILE* input = fopen(source.string().c_str(), "rb");
+    if (!input)
+    {
+        return false;
+    }
+    FILE* output = fopen(destination.string().c_str(), "wb");
+    if (!output)
+    {
+        fclose(input);
+        return false;
+    }
+
+    bool result = true;
+    std::vector<char> buffer(65536);
+    size_t n;
+    while ((n = fread(buffer.data(), 1, buffer.size(), input)) > 0)
+    {
+        if (fwrite(buffer.data(), 1, n, output) != n)
+        {
+            result = false;
+            break;
+        }
+    }
+    if (ferror(input))
+    {
+        result = false;
+    }
+    fclose(input);
+    if (fclose(output) != 0)
+    {
+        result = false;
+    }
+    return result;
+}
+
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+
+// Whether the error means the file system can't do this at all, as opposed to something about this particular file
+bool IsUnsupportedError(int err)
+{
+    return ((err == EOPNOTSUPP) || (err == ENOTTY) || (err == EXDEV) || (err == ENOSYS));
+}
+
+// Hard links the destination to the source. Sets unsupported if the file system doesn't support hard links.
+bool LinkFile(const boost::filesystem::path& source, const struct stat& sourceStatus,
+    const boost::filesystem::path& destination, const boost::filesystem::path& temporaryPath, bool& unsupported)
+{
+    struct stat destinationStatus;
+    if ((stat(destination.c_str(), &destinationStatus) == 0) && (destinationStatus.st_dev == sourceStatus.st_dev)
+        && (destinationStatus.st_ino == sourceStatus.st_ino))
+    {
+        // Already linked by a previous copy, renaming a link to the same file over it would do nothing
+        return true;
+    }
+    if (link(source.c_str(), temporaryPath.c_str()) != 0)
+    {
+        unsupported = IsUnsupportedError(errno);
+        return false;
+    }
+    if (rename(temporaryPath.c_str(), destination.c_str()) != 0)
+    {
+        unlink(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Copies the data in the kernel. Returns false with errno set if that isn't possible, in which case nothing has been
+// written yet unless errno is EIO.
+bool CopyFileRange(int sourceFD, int destinationFD, off_t size)
+{
+    off_t copied = 0;
+    while (copied < size)
+    {
+        ssize_t n = copy_file_range(sourceFD, nullptr, destinationFD, nullptr, (size_t)(size - copied), 0);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (copied == 0)
+            {
+                return false;
+            }
+            // Failing half way is a real error, not a lack of support
+            errno = EIO;
+            return false;
+        }
+        if (n == 0)
+        {
+            // The source was truncated while we were copying it
+            break;
+        }
+        copied += n;
+    }
+    return true;
+}
+
+#endif
+
+}
+
+FixtureCopier::FixtureCopier()
+    : m_readOnly(false), m_threadCount(std::max(1U, std::thread::hardware_concurrency())), m_cloneSupported(true),
+    m_linkSupported(true), m_clonedFileCount(0), m_linkedFileCount(0), m_copiedFileCount(0)
+{
+}
+
+void FixtureCopier::setReadOnly(bool readOnly)
+{
+    m_readOnly = readOnly;
+}
+
+void FixtureCopier::setThreadCount(size_t count)
+{
+    m_threadCount = std::max<size_t>(1, count);
+}
+
+void FixtureCopier::copy(const boost::filesystem::path& source, const boost::filesystem::path& destination,
+    Error& error)
+{
+    boost::system::error_code ec;
+    bool isDirectory = boost::filesystem::is_directory(source, ec);
+
+    // Replacing the files with themselves would at best do nothing and at worst lose their contents
+    if ((isDirectory && boost::filesystem::equivalent(source, destination, ec))
+        || (!isDirectory && IsSameEntry(source, destination)))
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return;
+    }
+
+    if (!isDirectory)
+    {
+        if (destination.has_parent_path())
+        {
+            boost::filesystem::create_directories(destination.parent_path(), ec);
+        }
+        if (!copyFile(source, destination))
+        {
+            Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        }
+        return;
+    }
+
+    std::vector<std::pair<boost::filesystem::path, boost::filesystem::path>> files;
+    if (!CollectFiles(source, destination, files))
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    auto copyFiles =
+        [this, &files, &next, &failed]()
+        {
+            size_t i;
+            while (!failed && ((i = next++) < files.size()))
+            {
+                if (!copyFile(files[i].first, files[i].second))
+                {
+                    failed = true;
+                }
+            }
+        };
+
+    size_t threadCount = std::min(m_threadCount, (files.size() / minFilesPerThread));
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; ++i)
+    {
+        threads.emplace_back(copyFiles);
+    }
+    copyFiles();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    if (failed)
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+    }
+}
+
+size_t FixtureCopier::clonedFileCount() const noexcept
+{
+    return m_clonedFileCount;
+}
+
+size_t FixtureCopier::linkedFileCount() const noexcept
+{
+    return m_linkedFileCount;
+}
+
+size_t FixtureCopier::copiedFileCount() const noexcept
+{
+    return m_copiedFileCount;
+}
+
+bool FixtureCopier::copyFile(const boost::filesystem::path& source, const boost::filesystem::path& destination)
+{
+    // The data is written to a temporary file that is then renamed over the destination. The destination is never
+    // opened for writing so a hard link to the source left by a previous copy can't be truncated, and it never ends up
+    // half written.
+    boost::filesystem::path temporaryPath = TemporaryPath(destination);
+
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    int sourceFD = open(source.c_str(), O_RDONLY | O_CLOEXEC);
+    if (sourceFD < 0)
+    {
+        return false;
+    }
+    struct stat sourceStatus;
+    if (fstat(sourceFD, &sourceStatus) != 0)
+    {
+        close(sourceFD);
+        return false;
+    }
+
+    bool unsupported = false;
+    if (m_readOnly && m_linkSupported && !m_cloneSupported)
+    {
+        // Once we know cloning isn't possible hard links are tried first so we don't create a file for nothing
+        if (LinkFile(source, sourceStatus, destination, temporaryPath, unsupported))
+        {
+            close(sourceFD);
+            ++m_linkedFileCount;
+            return true;
+        }
+        if (unsupported)
+        {
+            m_linkSupported = false;
+        }
+    }
+
+    int temporaryFD = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC,
+        sourceStatus.st_mode & 0777);
+    if (temporaryFD < 0)
+    {
+        close(sourceFD);
+        return false;
+    }
+
+    if (m_cloneSupported)
+    {
+        if (ioctl(temporaryFD, FICLONE, sourceFD) == 0)
+        {
+            close(temporaryFD);
+            close(sourceFD);
+            if (rename(temporaryPath.c_str(), destination.c_str()) != 0)
+            {
+                unlink(temporaryPath.c_str());
+                return false;
+            }
+            ++m_clonedFileCount;
+            return true;
+        }
+        if (IsUnsupportedError(errno))
+        {
+            m_cloneSupported = false;
+        }
+
+        if (m_readOnly && m_linkSupported)
+        {
+            close(temporaryFD);
+            unlink(temporaryPath.c_str());
+            if (LinkFile(source, sourceStatus, destination, temporaryPath, unsupported))
+            {
+                close(sourceFD);
+                ++m_linkedFileCount;
+                return true;
+            }
+            if (unsupported)
+            {
+                m_linkSupported = false;
+            }
+            temporaryFD = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC,
+                sourceStatus.st_mode & 0777);
+            if (temporaryFD < 0)
+            {
+                close(sourceFD);
+                return false;
+            }
+        }
+    }
+
+    bool copied = CopyFileRange(sourceFD, temporaryFD, sourceStatus.st_size);
+    // Whatever the reason, if nothing has been written yet stdio can have a go
+    bool retry = (!copied && (errno != EIO));
+    close(temporaryFD);
+    close(sourceFD);
+    if (!copied && !retry)
+    {
+        unlink(temporaryPath.c_str());
+        return false;
+    }
+    if (copied)
+    {
+        if (rename(temporaryPath.c_str(), destination.c_str()) != 0)
+        {
+            unlink(temporaryPath.c_str());
+            return false;
+        }
+        ++m_copiedFileCount;
+        return true;
+    }
+#endif
+
+    boost::system::error_code ec;
+    if (!CopyFileData(source, temporaryPath))
+    {
+        boost::filesystem::remove(temporaryPath, ec);
+        return false;
+    }
+    boost::filesystem::rename(temporaryPath, destination, ec);
+    if (ec)
+    {
+        boost::filesystem::remove(temporaryPath, ec);
+        return false;
+    }
+    ++m_copiedFileCount;
+    return true;
+}
@@ -0,0 +1,282 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ForkServer.hpp"
+#include "ForkServerChild.hpp"
+#include "TestFrameworkErrorCategory.hpp"
+#include <cstdint>
+#include <cstring>
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+#include <errno.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+using namespace Ishiko;
+
+ForkServer::ForkServer()
+    : m_socket(-1), m_serverPID(-1), m_startedPID(-1)
+{
+}
+
+ForkServer::~ForkServer()
+{
+    stop();
+}
+
+bool ForkServer::IsSupported() noexcept
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+int ForkServer::RunIfRequested(int argc, char* argv[], MainFunction mainFunction)
+{
+    return ForkServerChild::RunIfRequested(argc, argv, mainFunction);
+}
+
+void ForkServer::start(const boost::filesystem::path& executablePath, Error& error)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    stop();
+
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) != 0)
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return;
+    }
+
+    // dup2 clears the close-on-exec flag but not when the source and target are the same descriptor
+    int serverDescriptor = ((sockets[1] == 3) ? 4 : 3);
+    const char* socketVariableName = ForkServerChild::SocketVariableName;
+    std::string socketVariable = std::string(socketVariableName) + "=" + std::to_string(serverDescriptor);
+    std::vector<char*> environment;
+    for (char** variable = environ; *variable; ++variable)
+    {
+        if (strncmp(*variable, socketVariableName, strlen(socketVariableName)) != 0)
+        {
+            environment.push_back(*variable);
+        }
+    }
+    environment.push_back(&socketVariable[0]);
+    environment.push_back(nullptr);
+
+    std::string executable = executablePath.string();
+    char* argv[] = { &executable[0], nullptr };
+
+    posix_spawn_file_actions_t fileActions;
+    posix_spawn_file_actions_init(&fileActions);
+    posix_spawn_file_actions_adddup2(&fileActions, sockets[1], serverDescriptor);
+
+    pid_t pid = -1;
+    int err = posix_spawn(&pid, argv[0], &fileActions, nullptr, argv, environment.data());
+    posix_spawn_file_actions_destroy(&fileActions);
+    close(sockets[1]);
+
+    if (err != 0)
+    {
+        close(sockets[0]);
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return;
+    }
+
+    m_executablePath = executablePath;
+    m_socket = sockets[0];
+    m_serverPID = pid;
+#else
+    Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+#endif
+}
+
+void ForkServer::stop()
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    if (m_socket >= 0)
+    {
+        // The server exits when it sees the socket has been closed
+        close(m_socket);
+        m_socket = -1;
+    }
+    if (m_serverPID > 0)
+    {
+        while ((waitpid(m_serverPID, nullptr, 0) < 0) && (errno == EINTR))
+        {
+        }
+        m_serverPID = -1;
+    }
+#endif
+}
+
+bool ForkServer::isRunning() const noexcept
+{
+    return (m_socket >= 0);
+}
+
+const boost::filesystem::path& ForkServer::executablePath() const noexcept
+{
+    return m_executablePath;
+}
+
+int ForkServer::spawn(const std::vector<std::string>& arguments, int standardOutputFD, int standardErrorFD,
+    Error& error)
+{
+    return spawn(arguments, standardOutputFD, standardErrorFD, ChildProcessResourceLimits(), error);
+}
+
+int ForkServer::spawn(const std::vector<std::string>& arguments, int standardOutputFD, int standardErrorFD,
+    const ChildProcessResourceLimits& limits, Error& error)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    ForkServerChild::RequestHeader requestHeader;
+    requestHeader.maxCPUTime = (int64_t)limits.maxCPUTime.count();
+    requestHeader.maxMemorySize = (int64_t)limits.maxMemorySize;
+    std::string request((const char*)&requestHeader, sizeof(requestHeader));
+    for (const std::string& argument : arguments)
+    {
+        request.append(argument.c_str(), argument.size() + 1);
+    }
+    if (!isRunning() || arguments.empty() || (request.size() > ForkServerChild::MaxRequestSize))
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return -1;
+    }
+
+    iovec data;
+    data.iov_base = &request[0];
+    data.iov_len = request.size();
+    alignas(cmsghdr) char control[CMSG_SPACE(2 * sizeof(int))];
+    memset(control, 0, sizeof(control));
+    msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &data;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    cmsghdr* header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(2 * sizeof(int));
+    int descriptors[2] = { standardOutputFD, standardErrorFD };
+    memcpy(CMSG_DATA(header), descriptors, sizeof(descriptors));
+
+    ssize_t result;
+    do
+    {
+        result = sendmsg(m_socket, &message, MSG_NOSIGNAL);
+    } while ((result < 0) && (errno == EINTR));
+    if (result < 0)
+    {
+        if (errno == EPIPE)
+        {
+            // The server is gone
+            stop();
+        }
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return -1;
+    }
+
+    // Exit notifications for other processes may arrive before the reply to this request
+    m_startedPID = 0;
+    while (m_startedPID == 0)
+    {
+        if (!receiveReply(true))
+        {
+            break;
+        }
+    }
+    int pid = m_startedPID;
+    m_startedPID = -1;
+    if (pid <= 0)
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return -1;
+    }
+    return pid;
+#else
+    Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+    return -1;
+#endif
+}
+
+bool ForkServer::waitForExit(int pid, bool block, int& status, ChildProcessResourceUsage& resourceUsage)
+{
+    while (true)
+    {
+        std::map<int, ExitStatus>::iterator it = m_exitStatuses.find(pid);
+        if (it != m_exitStatuses.end())
+        {
+            status = it->second.status;
+            resourceUsage = it->second.resourceUsage;
+            m_exitStatuses.erase(it);
+            return true;
+        }
+        if (!isRunning())
+        {
+            status = -1;
+            resourceUsage = ChildProcessResourceUsage();
+            return true;
+        }
+        if (!receiveReply(block))
+        {
+            if (!isRunning())
+            {
+                continue;
+            }
+            return false;
+        }
+    }
+}
+
+int ForkServer::descriptor() const noexcept
+{
+    return m_socket;
+}
+
+bool ForkServer::receiveReply(bool block)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    ForkServerChild::Reply reply;
+    ssize_t size;
+    do
+    {
+        size = recv(m_socket, &reply, sizeof(reply), (block ? 0 : MSG_DONTWAIT));
+    } while ((size < 0) && (errno == EINTR));
+
+    if ((size < 0) && (errno == EAGAIN))
+    {
+        return false;
+    }
+    if (size != sizeof(reply))
+    {
+        // The server is gone
+        stop();
+        return false;
+    }
+
+    if (reply.type == ForkServerChild::startedReply)
+    {
+        m_startedPID = reply.pid;
+    }
+    else
+    {
+        ExitStatus& exitStatus = m_exitStatuses[reply.pid];
+        exitStatus.status = reply.status;
+        exitStatus.resourceUsage.userTime = std::chrono::microseconds(reply.userTime);
+        exitStatus.resourceUsage.systemTime = std::chrono::microseconds(reply.systemTime);
+        exitStatus.resourceUsage.maxResidentSetSize = (size_t)reply.maxResidentSetSize;
+        exitStatus.resourceUsage.blockInputOperations = (size_t)reply.blockInputOperations;
+        exitStatus.resourceUsage.blockOutputOperations = (size_t)reply.blockOutputOperations;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
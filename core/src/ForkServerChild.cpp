@@ -0,0 +1,214 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ForkServerChild.hpp"
+#include "ChildProcessResources.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace Ishiko;
+
+const char* const ForkServerChild::SocketVariableName = "ISHIKO_FORK_SERVER_FD";
+
+namespace
+{
+
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+
+void SendReply(int socket, const ForkServerChild::Reply& reply)
+{
+    ssize_t result;
+    do
+    {
+        result = send(socket, &reply, sizeof(reply), MSG_NOSIGNAL);
+    } while ((result < 0) && (errno == EINTR));
+}
+
+void SendExitStatuses(int socket)
+{
+    int status;
+    rusage usage;
+    pid_t pid;
+    while ((pid = wait4(-1, &status, WNOHANG, &usage)) > 0)
+    {
+        ForkServerChild::Reply reply;
+        memset(&reply, 0, sizeof(reply));
+        reply.type = ForkServerChild::exitedReply;
+        reply.pid = pid;
+        reply.status = status;
+        reply.userTime = (int64_t)usage.ru_utime.tv_sec * 1000000 + usage.ru_utime.tv_usec;
+        reply.systemTime = (int64_t)usage.ru_stime.tv_sec * 1000000 + usage.ru_stime.tv_usec;
+        // ru_maxrss is in kilobytes on Linux
+        reply.maxResidentSetSize = (int64_t)usage.ru_maxrss * 1024;
+        reply.blockInputOperations = usage.ru_inblock;
+        reply.blockOutputOperations = usage.ru_oublock;
+        SendReply(socket, reply);
+    }
+}
+
+// Returns false if the ForkServer has closed its end of the socket
+bool ServeRequest(int socket, int signalFD, const sigset_t& originalSignalMask,
+    ForkServerChild::MainFunction mainFunction)
+{
+    std::vector<char> buffer(ForkServerChild::MaxRequestSize);
+    iovec data;
+    data.iov_base = buffer.data();
+    data.iov_len = buffer.size();
+    alignas(cmsghdr) char control[CMSG_SPACE(2 * sizeof(int))];
+    msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &data;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    ssize_t size = recvmsg(socket, &message, MSG_CMSG_CLOEXEC);
+    if (size < 0)
+    {
+        return ((errno == EINTR) || (errno == EAGAIN));
+    }
+    if (size == 0)
+    {
+        return false;
+    }
+
+    int descriptors[2] = { -1, -1 };
+    cmsghdr* header = CMSG_FIRSTHDR(&message);
+    if (header && (header->cmsg_level == SOL_SOCKET) && (header->cmsg_type == SCM_RIGHTS)
+        && (header->cmsg_len == CMSG_LEN(2 * sizeof(int))))
+    {
+        memcpy(descriptors, CMSG_DATA(header), sizeof(descriptors));
+    }
+
+    ForkServerChild::Reply reply;
+    memset(&reply, 0, sizeof(reply));
+    reply.type = ForkServerChild::startedReply;
+    reply.pid = -1;
+    if ((descriptors[0] >= 0) && (descriptors[1] >= 0) && ((message.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) == 0)
+        && (size > (ssize_t)sizeof(ForkServerChild::RequestHeader)) && (buffer[size - 1] == '\0'))
+    {
+        ForkServerChild::RequestHeader requestHeader;
+        memcpy(&requestHeader, buffer.data(), sizeof(requestHeader));
+
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            close(socket);
+            close(signalFD);
+            sigprocmask(SIG_SETMASK, &originalSignalMask, nullptr);
+            dup2(descriptors[0], STDOUT_FILENO);
+            dup2(descriptors[1], STDERR_FILENO);
+
+            ChildProcessResourceLimits limits;
+            limits.maxCPUTime = std::chrono::milliseconds(requestHeader.maxCPUTime);
+            limits.maxMemorySize = (size_t)requestHeader.maxMemorySize;
+            limits.applyToCurrentProcess();
+
+            std::vector<char*> argv;
+            for (ssize_t i = sizeof(requestHeader); i < size; i += (strlen(&buffer[i]) + 1))
+            {
+                argv.push_back(&buffer[i]);
+            }
+            int argc = (int)argv.size();
+            argv.push_back(nullptr);
+
+            // exit rather than _exit so the output buffered by the helper is flushed
+            exit(mainFunction(argc, argv.data()));
+        }
+        reply.pid = pid;
+    }
+    for (int descriptor : descriptors)
+    {
+        if (descriptor >= 0)
+        {
+            close(descriptor);
+        }
+    }
+    SendReply(socket, reply);
+
+    return true;
+}
+
+int Serve(int socket, ForkServerChild::MainFunction mainFunction)
+{
+    // SIGCHLD is received through a descriptor so we can wait for requests and child exits at the same time
+    sigset_t childSignal;
+    sigemptyset(&childSignal);
+    sigaddset(&childSignal, SIGCHLD);
+    sigset_t originalSignalMask;
+    sigprocmask(SIG_BLOCK, &childSignal, &originalSignalMask);
+    int signalFD = signalfd(-1, &childSignal, SFD_CLOEXEC | SFD_NONBLOCK);
+    if (signalFD < 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    while (true)
+    {
+        pollfd fds[2];
+        fds[0].fd = socket;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = signalFD;
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+        if (poll(fds, 2, -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        if (fds[1].revents != 0)
+        {
+            // Several exits may be coalesced into one signal so the information is only used as a wake-up
+            signalfd_siginfo info;
+            while (read(signalFD, &info, sizeof(info)) > 0)
+            {
+            }
+            SendExitStatuses(socket);
+        }
+        if (fds[0].revents != 0)
+        {
+            if (!ServeRequest(socket, signalFD, originalSignalMask, mainFunction))
+            {
+                break;
+            }
+        }
+    }
+
+    close(signalFD);
+    close(socket);
+    return EXIT_SUCCESS;
+}
+
+#endif
+
+}
+
+int ForkServerChild::RunIfRequested(int argc, char* argv[], MainFunction mainFunction)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    const char* socketVariable = getenv(SocketVariableName);
+    if (socketVariable)
+    {
+        int socket = atoi(socketVariable);
+        // The forked processes shouldn't see the variable or they would think they are servers too
+        unsetenv(SocketVariableName);
+        return Serve(socket, mainFunction);
+    }
+#endif
+    return mainFunction(argc, argv);
+}
@@ -0,0 +1,452 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "FuzzTest.hpp"
+#include "PersistentStorage.hpp"
+#include <boost/filesystem/operations.hpp>
+#include <Ishiko/BasePlatform.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+using namespace Ishiko;
+
+namespace
+{
+
+// The edge counters are indexed by the value of the guard the instrumentation passes to the callback. Guard 0 is
+// reserved by the instrumentation to mean the edge is disabled. They are plain arrays because the callbacks are
+// called before the static constructors of the library have run.
+const size_t maxEdges = (1 << 16);
+uint8_t edgeCounters[maxEdges];
+size_t edgeCount = 0;
+
+// Only the number of times an edge is hit, rounded to these buckets, matters. Like libFuzzer we consider that going
+// through a loop 5 or 6 times is the same but that going through it 8 times is new.
+uint8_t CounterBucket(uint8_t counter)
+{
+    if (counter >= 128) return 128;
+    if (counter >= 32) return 64;
+    if (counter >= 16) return 32;
+    if (counter >= 8) return 16;
+    if (counter >= 4) return 8;
+    if (counter == 3) return 4;
+    return counter;
+}
+
+// The name under which an input is saved, so that the same input is only saved once (this is 64-bit FNV-1a)
+std::string InputHash(const std::string& input)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (char c : input)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001B3ULL;
+    }
+    char result[17];
+    snprintf(result, sizeof(result), "%016llx", static_cast<unsigned long long>(hash));
+    return result;
+}
+
+// A printable version of the input for the failure message. Long inputs are truncated, the full input is in the file
+// the failure message points to.
+std::string EscapeInput(const std::string& input)
+{
+    const size_t maxLength = 64;
+    std::string result = "\"";
+    for (size_t i = 0; (i < input.size()) && (i < maxLength); ++i)
+    {
+        unsigned char c = static_cast<unsigned char>(input[i]);
+        if ((c == '"') || (c == '\\'))
+        {
+            result.push_back('\\');
+            result.push_back(c);
+        }
+        else if ((c >= 0x20) && (c < 0x7F))
+        {
+            result.push_back(c);
+        }
+        else
+        {
+            char escaped[5];
+            snprintf(escaped, sizeof(escaped), "\\x%02x", c);
+            result.append(escaped);
+        }
+    }
+    result.push_back('"');
+    if (input.size() > maxLength)
+    {
+        result.append("... (" + std::to_string(input.size()) + " bytes)");
+    }
+    return result;
+}
+
+}
+
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+// These are the callbacks of clang's -fsanitize-coverage=trace-pc-guard instrumentation. They are weak so that they
+// give way to the ones of libFuzzer if it is linked in, in which case the fuzzing is blind. The library itself must
+// not be compiled with the instrumentation.
+extern "C" __attribute__((weak)) void __sanitizer_cov_trace_pc_guard_init(uint32_t* start, uint32_t* stop)
+{
+    // The callback is called once per module, possibly more than once for the same guards
+    if ((start == stop) || (*start != 0))
+    {
+        return;
+    }
+    for (uint32_t* guard = start; guard < stop; ++guard)
+    {
+        *guard = static_cast<uint32_t>((edgeCount % (maxEdges - 1)) + 1);
+        ++edgeCount;
+    }
+}
+
+extern "C" __attribute__((weak)) void __sanitizer_cov_trace_pc_guard(uint32_t* guard)
+{
+    uint8_t& counter = edgeCounters[*guard];
+    if (counter != 255)
+    {
+        ++counter;
+    }
+}
+#endif
+
+class FuzzTest::Coverage
+{
+public:
+    Coverage();
+
+    /// Clears the edge counters before an input is run.
+    void reset() noexcept;
+    /// Returns true if the input that was just run hit an edge, or hit it a number of times, that no input hit before.
+    bool update();
+
+private:
+    size_t usedEdges() const noexcept;
+
+private:
+    // The buckets each edge has been seen in so far, as a bit mask
+    std::vector<uint8_t> m_seenBuckets;
+};
+
+FuzzTest::Coverage::Coverage()
+    : m_seenBuckets(usedEdges(), 0)
+{
+}
+
+void FuzzTest::Coverage::reset() noexcept
+{
+    std::fill(edgeCounters, (edgeCounters + usedEdges()), 0);
+}
+
+bool FuzzTest::Coverage::update()
+{
+    bool result = false;
+    for (size_t i = 0; i < m_seenBuckets.size(); ++i)
+    {
+        uint8_t bucket = CounterBucket(edgeCounters[i]);
+        if ((bucket & ~m_seenBuckets[i]) != 0)
+        {
+            m_seenBuckets[i] |= bucket;
+            result = true;
+        }
+    }
+    return result;
+}
+
+size_t FuzzTest::Coverage::usedEdges() const noexcept
+{
+    if (edgeCount == 0)
+    {
+        return 0;
+    }
+    return std::min((edgeCount + 1), maxEdges);
+}
+
+FuzzTest::FuzzTest(const TestNumber& number, const std::string& name, Body body)
+    : FuzzTest(number, name, std::move(body), TestContext::DefaultTestContext())
+{
+}
+
+FuzzTest::FuzzTest(const TestNumber& number, const std::string& name, Body body, const TestContext& context)
+    : Test(number, name, context), m_body(std::move(body)), m_seed(0), m_seedIsSet(false), m_maxIterations(10000),
+    m_maxDuration(10000), m_maxInputSize(4096), m_iterations(0), m_corpusSize(0)
+{
+}
+
+bool FuzzTest::IsCoverageGuided() noexcept
+{
+    return (edgeCount != 0);
+}
+
+uint64_t FuzzTest::seed() const noexcept
+{
+    return m_seed;
+}
+
+void FuzzTest::setSeed(uint64_t seed) noexcept
+{
+    m_seed = seed;
+    m_seedIsSet = true;
+}
+
+void FuzzTest::setCorpusDirectory(const boost::filesystem::path& path)
+{
+    m_corpusDirectory = path;
+}
+
+void FuzzTest::setMaxIterations(size_t count) noexcept
+{
+    m_maxIterations = count;
+}
+
+void FuzzTest::setMaxDuration(std::chrono::milliseconds duration) noexcept
+{
+    m_maxDuration = duration;
+}
+
+void FuzzTest::setMaxInputSize(size_t size) noexcept
+{
+    m_maxInputSize = size;
+}
+
+size_t FuzzTest::iterations() const noexcept
+{
+    return m_iterations;
+}
+
+size_t FuzzTest::corpusSize() const noexcept
+{
+    return m_corpusSize;
+}
+
+void FuzzTest::doRun()
+{
+    if (!m_seedIsSet)
+    {
+        std::random_device randomDevice;
+        m_seed = ((static_cast<uint64_t>(randomDevice()) << 32) | randomDevice());
+    }
+    std::mt19937_64 random(m_seed);
+    m_iterations = 0;
+
+    std::vector<std::string> corpus;
+    loadCorpus(corpus);
+    m_corpusSize = corpus.size();
+
+    RepeatedTestCase test(*this);
+    Coverage coverage;
+
+    // Run the corpus first, it contains the previous crashes and it gives the coverage the mutations need to improve on
+    for (const std::string& input : corpus)
+    {
+        coverage.reset();
+        if (!execute(test, input))
+        {
+            reportFailure(input, 0, test);
+            return;
+        }
+        coverage.update();
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::string input;
+    while (((m_maxIterations == 0) || (m_iterations < m_maxIterations))
+        && ((m_maxDuration.count() == 0) || ((std::chrono::steady_clock::now() - start) < m_maxDuration)))
+    {
+        std::uniform_int_distribution<size_t> corpusDistribution(0, (corpus.size() - 1));
+        input = corpus[corpusDistribution(random)];
+        mutate(input, corpus, random);
+        ++m_iterations;
+
+        coverage.reset();
+        if (!execute(test, input))
+        {
+            reportFailure(input, m_iterations, test);
+            return;
+        }
+        if (coverage.update())
+        {
+            corpus.push_back(input);
+            m_corpusSize = corpus.size();
+            boost::filesystem::path path;
+            saveInput(input, "", path);
+        }
+    }
+
+    pass();
+}
+
+bool FuzzTest::execute(RepeatedTestCase& test, const std::string& input) const
+{
+    return test.check(
+        [this, &input](Test& test)
+        {
+            m_body(test, input);
+        });
+}
+
+void FuzzTest::loadCorpus(std::vector<std::string>& corpus) const
+{
+    std::vector<boost::filesystem::path> directories;
+    if (!m_corpusDirectory.empty())
+    {
+        directories.push_back(context().getReferencePath(m_corpusDirectory));
+    }
+    boost::filesystem::path persistentStoragePath = PersistentStorage::GetTestDirectory(*this);
+    if (!persistentStoragePath.empty())
+    {
+        directories.push_back(persistentStoragePath);
+    }
+
+    for (const boost::filesystem::path& directory : directories)
+    {
+        if (!boost::filesystem::is_directory(directory))
+        {
+            continue;
+        }
+
+        // Sort the files so that the run only depends on the seed and the content of the directories
+        std::vector<boost::filesystem::path> files;
+        for (const boost::filesystem::directory_entry& entry : boost::filesystem::directory_iterator(directory))
+        {
+            if (boost::filesystem::is_regular_file(entry.status()))
+            {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+
+        for (const boost::filesystem::path& file : files)
+        {
+            std::ifstream stream(file.string(), std::ios::binary);
+            corpus.emplace_back(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        }
+    }
+
+    if (corpus.empty())
+    {
+        corpus.emplace_back();
+    }
+}
+
+void FuzzTest::mutate(std::string& input, const std::vector<std::string>& corpus, std::mt19937_64& random) const
+{
+    static const unsigned char interestingBytes[] = { 0x00, 0x01, 0x7F, 0x80, 0xFF };
+
+    auto pick =
+        [&random](size_t count) -> size_t
+        {
+            std::uniform_int_distribution<size_t> distribution(0, (count - 1));
+            return distribution(random);
+        };
+
+    size_t mutationCount = (1 + pick(4));
+    for (size_t i = 0; i < mutationCount; ++i)
+    {
+        size_t operation = pick(7);
+        // Only insertions and splicing make sense for an empty input
+        if (input.empty() && (operation < 4))
+        {
+            operation = 4;
+        }
+        switch (operation)
+        {
+        case 0:
+            input[pick(input.size())] ^= static_cast<char>(1 << pick(8));
+            break;
+
+        case 1:
+            input[pick(input.size())] = static_cast<char>(pick(256));
+            break;
+
+        case 2:
+            input[pick(input.size())] = static_cast<char>(interestingBytes[pick(sizeof(interestingBytes))]);
+            break;
+
+        case 3:
+            {
+                size_t position = pick(input.size());
+                input.erase(position, (1 + pick(input.size() - position)));
+            }
+            break;
+
+        case 4:
+            input.insert(pick(input.size() + 1), 1, static_cast<char>(pick(256)));
+            break;
+
+        case 5:
+            // Copy part of the input elsewhere in it, this helps with formats that repeat structures
+            if (!input.empty())
+            {
+                size_t position = pick(input.size());
+                std::string chunk = input.substr(position, (1 + pick(input.size() - position)));
+                input.insert(pick(input.size() + 1), chunk);
+            }
+            break;
+
+        case 6:
+            // Splice in part of another input of the corpus
+            {
+                const std::string& other = corpus[pick(corpus.size())];
+                if (!other.empty())
+                {
+                    size_t position = pick(other.size());
+                    input.insert(pick(input.size() + 1), other, position, (1 + pick(other.size() - position)));
+                }
+            }
+            break;
+        }
+    }
+
+    if (input.size() > m_maxInputSize)
+    {
+        input.resize(m_maxInputSize);
+    }
+}
+
+void FuzzTest::saveInput(const std::string& input, const std::string& prefix, boost::filesystem::path& path) const
+{
+    Error error;
+    boost::filesystem::path targetDirectory = PersistentStorage::CreateTestDirectory(*this, error);
+    if (!error && !targetDirectory.empty())
+    {
+        path = targetDirectory / (prefix + InputHash(input));
+        std::ofstream stream(path.string(), std::ios::binary);
+        stream.write(input.data(), input.size());
+    }
+}
+
+void FuzzTest::reportFailure(const std::string& input, size_t iteration, const RepeatedTestCase& test)
+{
+    boost::filesystem::path path;
+    saveInput(input, "crash-", path);
+
+    std::string message = ("Fuzzing failed for input " + EscapeInput(input) + " (seed: " + std::to_string(m_seed));
+    if (iteration == 0)
+    {
+        message += ", corpus input";
+    }
+    else
+    {
+        message += ", iteration: " + std::to_string(iteration);
+    }
+    if (!path.empty())
+    {
+        message += ", saved to: " + path.string();
+    }
+    message += ")";
+    if (!test.failureMessage().empty())
+    {
+        message += ": " + test.failureMessage();
+    }
+    if (test.failureLine() != 0)
+    {
+        fail(message, test.failureFile(), test.failureLine());
+    }
+    else
+    {
+        fail(message, __FILE__, __LINE__);
+    }
+}
@@ -25,6 +25,12 @@ HeapAllocationErrorsTest::HeapAllocationErrorsTest(const TestNumber& number, con
     m_test->observers().add(m_innerObserver);
 }
 
+void HeapAllocationErrorsTest::reset()
+{
+    Test::reset();
+    m_test->reset();
+}
+
 void HeapAllocationErrorsTest::addToJUnitXMLTestReport(JUnitXMLWriter& writer) const
 {
     m_test->addToJUnitXMLTestReport(writer);
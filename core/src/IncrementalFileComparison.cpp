@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "IncrementalFileComparison.hpp"
+#include "TestFrameworkErrorCategory.hpp"
+#include <algorithm>
+#include <cstring>
+
+using namespace Ishiko;
+
+IncrementalFileComparison::IncrementalFileComparison()
+    : m_referenceFile(nullptr), m_offset(0), m_line(1), m_mismatch(false)
+{
+}
+
+IncrementalFileComparison::~IncrementalFileComparison()
+{
+    close();
+}
+
+void IncrementalFileComparison::open(const boost::filesystem::path& referenceFilePath, Error& error)
+{
+    close();
+
+    m_referenceFilePath = referenceFilePath;
+    m_offset = 0;
+    m_line = 1;
+    m_mismatch = false;
+
+    m_referenceFile = fopen(m_referenceFilePath.string().c_str(), "rb");
+    if (!m_referenceFile)
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+    }
+}
+
+void IncrementalFileComparison::close()
+{
+    if (m_referenceFile)
+    {
+        fclose(m_referenceFile);
+        m_referenceFile = nullptr;
+    }
+}
+
+bool IncrementalFileComparison::isOpen() const noexcept
+{
+    return (m_referenceFile != nullptr);
+}
+
+bool IncrementalFileComparison::compare(const char* data, size_t size)
+{
+    if (m_mismatch)
+    {
+        return false;
+    }
+    if (!m_referenceFile)
+    {
+        m_mismatch = true;
+        return false;
+    }
+
+    if (m_buffer.size() < size)
+    {
+        m_buffer.resize(size);
+    }
+    size_t n = fread(m_buffer.data(), 1, size, m_referenceFile);
+    if (memcmp(m_buffer.data(), data, n) != 0)
+    {
+        size_t i = 0;
+        while (m_buffer[i] == data[i])
+        {
+            ++i;
+        }
+        setMismatch(i, data);
+        return false;
+    }
+    if (n < size)
+    {
+        // The output is longer than the reference
+        setMismatch(n, data);
+        return false;
+    }
+
+    m_line += std::count(data, data + size, '\n');
+    m_offset += size;
+
+    return true;
+}
+
+bool IncrementalFileComparison::finish()
+{
+    if (m_mismatch)
+    {
+        return false;
+    }
+    if (!m_referenceFile)
+    {
+        m_mismatch = true;
+        return false;
+    }
+
+    char c;
+    if (fread(&c, 1, 1, m_referenceFile) == 1)
+    {
+        // The reference is longer than the output
+        m_mismatch = true;
+        return false;
+    }
+
+    return true;
+}
+
+bool IncrementalFileComparison::mismatch() const noexcept
+{
+    return m_mismatch;
+}
+
+size_t IncrementalFileComparison::mismatchOffset() const noexcept
+{
+    return m_offset;
+}
+
+size_t IncrementalFileComparison::mismatchLine() const noexcept
+{
+    return m_line;
+}
+
+const boost::filesystem::path& IncrementalFileComparison::referenceFilePath() const noexcept
+{
+    return m_referenceFilePath;
+}
+
+void IncrementalFileComparison::setMismatch(size_t relativeOffset, const char* data)
+{
+    m_mismatch = true;
+    m_line += std::count(data, data + relativeOffset, '\n');
+    m_offset += relativeOffset;
+}
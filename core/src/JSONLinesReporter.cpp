@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "JSONLinesReporter.hpp"
+#include <cstdio>
+
+using namespace Ishiko;
+
+JSONLinesReporter::JSONLinesReporter(std::ostream& output)
+    : m_output(output)
+{
+}
+
+void JSONLinesReporter::onTestCaseCompleted(const Test& test, std::chrono::microseconds duration,
+    const std::vector<Failure>& failures)
+{
+    m_output << "{\"number\":";
+    WriteNumber(m_output, test.number());
+    m_output << ",\"name\":";
+    WriteString(m_output, test.name());
+    m_output << ",\"result\":";
+    WriteString(m_output, ToString(test.result()));
+    m_output << ",\"duration\":" << duration.count() << ",\"failures\":[";
+    for (size_t i = 0; i < failures.size(); ++i)
+    {
+        const Failure& failure = failures[i];
+        if (i != 0)
+        {
+            m_output << ',';
+        }
+        m_output << "{\"message\":";
+        WriteString(m_output, failure.message);
+        if (!failure.file.empty())
+        {
+            m_output << ",\"file\":";
+            WriteString(m_output, failure.file);
+            m_output << ",\"line\":" << failure.line;
+        }
+        m_output << '}';
+    }
+    // No std::endl, the output is only flushed at the end of the run
+    m_output << "]}\n";
+}
+
+void JSONLinesReporter::onRunCompleted()
+{
+    m_output.flush();
+}
+
+void JSONLinesReporter::WriteNumber(std::ostream& output, const TestNumber& number)
+{
+    output << '"';
+    for (size_t i = 0; i < number.depth(); ++i)
+    {
+        if (i != 0)
+        {
+            output << '.';
+        }
+        output << number.part(i);
+    }
+    output << '"';
+}
+
+void JSONLinesReporter::WriteString(std::ostream& output, const std::string& value)
+{
+    output << '"';
+    for (char c : value)
+    {
+        switch (c)
+        {
+        case '"':
+            output << "\\\"";
+            break;
+
+        case '\\':
+            output << "\\\\";
+            break;
+
+        case '\n':
+            output << "\\n";
+            break;
+
+        case '\r':
+            output << "\\r";
+            break;
+
+        case '\t':
+            output << "\\t";
+            break;
+
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char escaped[7];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                output << escaped;
+            }
+            else
+            {
+                output << c;
+            }
+            break;
+        }
+    }
+    output << '"';
+}
@@ -82,6 +82,30 @@ void JUnitXMLWriter::writeTestCaseEnd()
     m_xmlWriter.writeElementEnd();
 }
 
+void JUnitXMLWriter::writePropertiesStart()
+{
+    m_testCaseHasChild = true;
+    m_xmlWriter.writeNewlineAndIndentation();
+    m_xmlWriter.writeElementStart("properties");
+    m_xmlWriter.increaseIndentation();
+}
+
+void JUnitXMLWriter::writePropertiesEnd()
+{
+    m_xmlWriter.decreaseIndentation();
+    m_xmlWriter.writeNewlineAndIndentation();
+    m_xmlWriter.writeElementEnd();
+}
+
+void JUnitXMLWriter::writeProperty(const std::string& name, const std::string& value)
+{
+    m_xmlWriter.writeNewlineAndIndentation();
+    m_xmlWriter.writeElementStart("property");
+    m_xmlWriter.writeAttribute("name", name);
+    m_xmlWriter.writeAttribute("value", value);
+    m_xmlWriter.writeElementEnd();
+}
+
 void JUnitXMLWriter::writeFailureStart()
 {
     m_testCaseHasChild = true;
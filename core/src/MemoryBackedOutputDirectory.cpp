@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "MemoryBackedOutputDirectory.hpp"
+#include "FixtureCopier.hpp"
+#include "TestFrameworkErrorCategory.hpp"
+#include <boost/filesystem/operations.hpp>
+
+using namespace Ishiko;
+
+MemoryBackedOutputDirectory::MemoryBackedOutputDirectory()
+{
+}
+
+MemoryBackedOutputDirectory::~MemoryBackedOutputDirectory()
+{
+    remove();
+}
+
+void MemoryBackedOutputDirectory::create(const boost::filesystem::path& root, const boost::filesystem::path& diskPath,
+    Error& error)
+{
+    boost::system::error_code ec;
+    boost::filesystem::path path = root / boost::filesystem::unique_path("ishiko-test-output-%%%%-%%%%-%%%%-%%%%", ec);
+    if (!ec)
+    {
+        boost::filesystem::create_directories(path, ec);
+    }
+    if (ec)
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return;
+    }
+    m_path = path;
+    m_diskPath = diskPath;
+}
+
+void MemoryBackedOutputDirectory::remove()
+{
+    if (!m_path.empty())
+    {
+        boost::system::error_code ec;
+        boost::filesystem::remove_all(m_path, ec);
+        m_path.clear();
+    }
+}
+
+const boost::filesystem::path& MemoryBackedOutputDirectory::path() const noexcept
+{
+    return m_path;
+}
+
+const boost::filesystem::path& MemoryBackedOutputDirectory::diskPath() const noexcept
+{
+    return m_diskPath;
+}
+
+void MemoryBackedOutputDirectory::keep(const boost::filesystem::path& path)
+{
+    boost::filesystem::path relativePath = path.lexically_normal().lexically_relative(m_path);
+    if (relativePath.empty() || (*relativePath.begin() == ".."))
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_keptPaths.insert(relativePath);
+}
+
+size_t MemoryBackedOutputDirectory::keptCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_keptPaths.size();
+}
+
+std::vector<boost::filesystem::path> MemoryBackedOutputDirectory::copyOut(Error& error)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<boost::filesystem::path> failedPaths;
+    FixtureCopier copier;
+    for (const boost::filesystem::path& relativePath : m_keptPaths)
+    {
+        boost::filesystem::path sourcePath = m_path / relativePath;
+        boost::system::error_code ec;
+        if (boost::filesystem::exists(sourcePath, ec))
+        {
+            Error copyError;
+            copier.copy(sourcePath, m_diskPath / relativePath, copyError);
+            if (copyError)
+            {
+                failedPaths.push_back(relativePath);
+            }
+        }
+    }
+    if (!failedPaths.empty())
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+    }
+    return failedPaths;
+}
@@ -0,0 +1,269 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ParameterizedTest.hpp"
+
+using namespace Ishiko;
+
+class ParameterizedTestBase::Case : public Test
+{
+public:
+    Case(ParameterizedTestBase& owner);
+
+    void prepare(const TestNumber& number, const std::string& name);
+
+protected:
+    void doRun() override;
+
+private:
+    ParameterizedTestBase& m_owner;
+};
+
+class ParameterizedTestBase::CaseObserver : public Test::Observer
+{
+public:
+    CaseObserver(ParameterizedTestBase& owner);
+
+    const std::string& failure() const noexcept;
+    void clearFailure() noexcept;
+
+    void onLifecycleEvent(const Test& source, EventType type) override;
+    void onCheckFailed(const Test& source, const std::string& message, const char* file, int line) override;
+    void onExceptionThrown(const Test& source, std::exception_ptr exception) override;
+
+private:
+    ParameterizedTestBase& m_owner;
+    std::string m_failure;
+};
+
+ParameterizedTestBase::Case::Case(ParameterizedTestBase& owner)
+    : Test(TestNumber(), "", owner.context()), m_owner(owner)
+{
+}
+
+void ParameterizedTestBase::Case::prepare(const TestNumber& number, const std::string& name)
+{
+    reuse(number, name);
+    // Start from a fresh context so that nothing the previous case did to it, like isolating its output directory,
+    // carries over
+    context() = TestContext(&m_owner.context());
+}
+
+void ParameterizedTestBase::Case::doRun()
+{
+    m_owner.runCase(*this);
+}
+
+ParameterizedTestBase::CaseObserver::CaseObserver(ParameterizedTestBase& owner)
+    : m_owner(owner)
+{
+}
+
+const std::string& ParameterizedTestBase::CaseObserver::failure() const noexcept
+{
+    return m_failure;
+}
+
+void ParameterizedTestBase::CaseObserver::clearFailure() noexcept
+{
+    m_failure.clear();
+}
+
+void ParameterizedTestBase::CaseObserver::onLifecycleEvent(const Test& source, EventType type)
+{
+    m_owner.observers().notifyLifecycleEvent(source, type);
+}
+
+void ParameterizedTestBase::CaseObserver::onCheckFailed(const Test& source, const std::string& message,
+    const char* file, int line)
+{
+    if (m_failure.empty())
+    {
+        m_failure = (message + " [file: " + file + ", line: " + std::to_string(line) + "]");
+    }
+    m_owner.observers().notifyCheckFailed(source, message, file, line);
+}
+
+void ParameterizedTestBase::CaseObserver::onExceptionThrown(const Test& source, std::exception_ptr exception)
+{
+    if (m_failure.empty())
+    {
+        m_failure = "Exception thrown";
+    }
+    m_owner.observers().notifyExceptionThrown(source, exception);
+}
+
+ParameterizedTestBase::ParameterizedTestBase(const TestNumber& number, const std::string& name,
+    const TestContext& context)
+    : Test(number, name, context)
+{
+}
+
+size_t ParameterizedTestBase::caseCount() const noexcept
+{
+    return m_cases.size();
+}
+
+const std::string& ParameterizedTestBase::caseName(size_t pos) const
+{
+    return m_cases[pos].name;
+}
+
+TestResult ParameterizedTestBase::caseResult(size_t pos) const
+{
+    return m_cases[pos].result;
+}
+
+void ParameterizedTestBase::getPassRate(size_t& unknown, size_t& passed, size_t& passedButMemoryLeaks,
+    size_t& exception, size_t& failed, size_t& skipped, size_t& total) const
+{
+    if (m_cases.empty())
+    {
+        // Same as an empty sequence, the test counts as a single test case so that it doesn't go unnoticed
+        Test::getPassRate(unknown, passed, passedButMemoryLeaks, exception, failed, skipped, total);
+        return;
+    }
+
+    unknown = 0;
+    passed = 0;
+    passedButMemoryLeaks = 0;
+    exception = 0;
+    failed = 0;
+    skipped = 0;
+    total = m_cases.size();
+    for (const CaseResult& c : m_cases)
+    {
+        switch (c.result)
+        {
+        case TestResult::unknown:
+            ++unknown;
+            break;
+
+        case TestResult::passed:
+            ++passed;
+            break;
+
+        case TestResult::passed_but_memory_leaks:
+            ++passedButMemoryLeaks;
+            break;
+
+        case TestResult::exception:
+            ++exception;
+            break;
+
+        case TestResult::failed:
+            ++failed;
+            break;
+
+        case TestResult::skipped:
+            ++skipped;
+            break;
+        }
+    }
+}
+
+void ParameterizedTestBase::addToJUnitXMLTestReport(JUnitXMLWriter& writer) const
+{
+    if (m_cases.empty())
+    {
+        Test::addToJUnitXMLTestReport(writer);
+        return;
+    }
+
+    for (const CaseResult& c : m_cases)
+    {
+        writer.writeTestCaseStart("unknown", c.name);
+        switch (c.result)
+        {
+        case TestResult::passed:
+            // Do nothing
+            break;
+
+        case TestResult::skipped:
+            writer.writeSkippedStart();
+            writer.writeSkippedEnd();
+            break;
+
+        default:
+            writer.writeFailureStart();
+            if (!c.failure.empty())
+            {
+                writer.writeText(c.failure);
+            }
+            writer.writeFailureEnd();
+        }
+        writer.writeTestCaseEnd();
+    }
+}
+
+bool ParameterizedTestBase::hasIsolatedOutputDirectory() const
+{
+    return false;
+}
+
+void ParameterizedTestBase::doRun()
+{
+    m_cases.clear();
+    rewindCases();
+
+    Case currentCase(*this);
+    std::shared_ptr<CaseObserver> observer = std::make_shared<CaseObserver>(*this);
+    currentCase.observers().add(observer);
+
+    TestNumber caseNumber = number().getDeeperNumber();
+    std::string caseName;
+    while (nextCase(caseName))
+    {
+        observer->clearFailure();
+        currentCase.prepare(caseNumber, caseName);
+        currentCase.run();
+
+        // The results are kept until the end of the run, they are not a leak of the test
+        DebugHeap::TrackingState trackingState;
+        trackingState.disableTracking();
+        m_cases.push_back(CaseResult{caseName, currentCase.result(), observer->failure()});
+        trackingState.restore();
+
+        ++caseNumber;
+    }
+
+    // The result is the same as the one a sequence of the cases would have
+    TestResult result = TestResult::unknown;
+    size_t unknown = 0;
+    size_t passed = 0;
+    size_t passedButMemoryLeaks = 0;
+    size_t exception = 0;
+    size_t failed = 0;
+    size_t skipped = 0;
+    size_t total = 0;
+    getPassRate(unknown, passed, passedButMemoryLeaks, exception, failed, skipped, total);
+    if (m_cases.empty())
+    {
+        result = TestResult::unknown;
+    }
+    else if (failed > 0)
+    {
+        result = TestResult::failed;
+    }
+    else if (exception > 0)
+    {
+        result = TestResult::exception;
+    }
+    else if (unknown > 0)
+    {
+        result = TestResult::unknown;
+    }
+    else if (passedButMemoryLeaks > 0)
+    {
+        result = TestResult::passed_but_memory_leaks;
+    }
+    else if (passed > 0)
+    {
+        result = TestResult::passed;
+    }
+    else
+    {
+        result = TestResult::skipped;
+    }
+    setResult(result);
+}
@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PersistentStorage.hpp"
+#include "TestFrameworkErrorCategory.hpp"
+#include <boost/filesystem/operations.hpp>
+#include <Ishiko/FileSystem.hpp>
+
+using namespace Ishiko;
+
+boost::filesystem::path PersistentStorage::GetTestDirectory(const Test& test)
+{
+    // The only reason this can fail is that there is no such directory
+    Error error;
+    boost::filesystem::path persistentStoragePath = test.context().getOutputDirectory("persistent-storage", error);
+    if (error)
+    {
+        return boost::filesystem::path();
+    }
+    return (persistentStoragePath / test.name());
+}
+
+boost::filesystem::path PersistentStorage::CreateTestDirectory(const Test& test, Error& error)
+{
+    boost::filesystem::path result = GetTestDirectory(test);
+    if (!result.empty())
+    {
+        boost::system::error_code ec;
+        boost::filesystem::create_directories(result, ec);
+        if (ec)
+        {
+            Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        }
+    }
+    return result;
+}
+
+void PersistentStorage::CopySingleFile(const Test& test, const boost::filesystem::path& path, Error& error)
+{
+    boost::filesystem::path targetDirectory = CreateTestDirectory(test, error);
+    if (!error && !targetDirectory.empty())
+    {
+        FileSystem::CopySingleFile(path, (targetDirectory / path.filename()), error);
+    }
+}
@@ -0,0 +1,574 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PipedChildProcess.hpp"
+#include "TestFrameworkErrorCategory.hpp"
+#include <vector>
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+using namespace Ishiko;
+
+void PipedChildProcess::Callbacks::onStandardOutput(const char* data, size_t size)
+{
+}
+
+void PipedChildProcess::Callbacks::onStandardError(const char* data, size_t size)
+{
+}
+
+PipedChildProcess::PipedChildProcess()
+    : m_callbacks(nullptr), m_pid(-1), m_standardOutputFD(-1), m_standardErrorFD(-1), m_exitFD(-1),
+    m_exited(false), m_exitCode(-1)
+{
+}
+
+PipedChildProcess::~PipedChildProcess()
+{
+    stopReading();
+    if ((m_pid > 0) && !m_exited)
+    {
+        kill();
+        waitForExit();
+    }
+}
+
+bool PipedChildProcess::IsSupported() noexcept
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::vector<std::string> PipedChildProcess::SplitCommandLine(const std::string& commandLine)
+{
+    std::vector<std::string> result;
+
+    std::string current;
+    bool inArgument = false;
+    char quote = 0;
+    for (size_t i = 0; i < commandLine.size(); ++i)
+    {
+        char c = commandLine[i];
+        if (quote == '\'')
+        {
+            if (c == quote)
+            {
+                quote = 0;
+            }
+            else
+            {
+                current += c;
+            }
+        }
+        else if (quote == '"')
+        {
+            if (c == quote)
+            {
+                quote = 0;
+            }
+            else if ((c == '\\') && ((i + 1) < commandLine.size())
+                && ((commandLine[i + 1] == '"') || (commandLine[i + 1] == '\\')))
+            {
+                current += commandLine[++i];
+            }
+            else
+            {
+                current += c;
+            }
+        }
+        else if ((c == '"') || (c == '\''))
+        {
+            quote = c;
+            inArgument = true;
+        }
+        else if (c == '\\')
+        {
+            // A backslash at the end of the command line is kept as is
+            if ((i + 1) < commandLine.size())
+            {
+                ++i;
+            }
+            current += commandLine[i];
+            inArgument = true;
+        }
+        else if ((c == ' ') || (c == '\t'))
+        {
+            if (inArgument)
+            {
+                result.push_back(current);
+                current.clear();
+                inArgument = false;
+            }
+        }
+        else
+        {
+            current += c;
+            inArgument = true;
+        }
+    }
+    if (inArgument)
+    {
+        result.push_back(current);
+    }
+
+    return result;
+}
+
+void PipedChildProcess::setResourceLimits(const ChildProcessResourceLimits& limits)
+{
+    m_resourceLimits = limits;
+}
+
+void PipedChildProcess::setForkServer(std::shared_ptr<ForkServer> server)
+{
+    m_forkServer = server;
+}
+
+void PipedChildProcess::start(const std::string& commandLine, Callbacks& callbacks, Error& error)
+{
+    spawn(commandLine, &callbacks, error);
+}
+
+void PipedChildProcess::start(const std::string& commandLine, Error& error)
+{
+    spawn(commandLine, nullptr, error);
+}
+
+void PipedChildProcess::spawn(const std::string& commandLine, Callbacks* callbacks, Error& error)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    std::vector<std::string> arguments = SplitCommandLine(commandLine);
+    if (arguments.empty())
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return;
+    }
+    std::vector<char*> argv;
+    for (std::string& argument : arguments)
+    {
+        argv.push_back(&argument[0]);
+    }
+    argv.push_back(nullptr);
+
+    int standardOutputPipe[2] = { -1, -1 };
+    int standardErrorPipe[2] = { -1, -1 };
+    if (callbacks)
+    {
+        if (pipe2(standardOutputPipe, O_CLOEXEC) != 0)
+        {
+            Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+            return;
+        }
+        if (pipe2(standardErrorPipe, O_CLOEXEC) != 0)
+        {
+            close(standardOutputPipe[0]);
+            close(standardOutputPipe[1]);
+            Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+            return;
+        }
+    }
+
+    pid_t pid = -1;
+    int err = 0;
+    if (m_forkServer)
+    {
+        Error spawnError;
+        pid = m_forkServer->spawn(arguments, (callbacks ? standardOutputPipe[1] : STDOUT_FILENO),
+            (callbacks ? standardErrorPipe[1] : STDERR_FILENO), m_resourceLimits, spawnError);
+        if (spawnError)
+        {
+            err = -1;
+        }
+    }
+    else if ((m_resourceLimits.maxCPUTime.count() > 0) || (m_resourceLimits.maxMemorySize > 0))
+    {
+        // posix_spawn has no way to set limits on the child so we fork and set them before exec. The error of a failed
+        // exec is reported through a pipe that is closed automatically by a successful one.
+        int execErrorPipe[2];
+        if (pipe2(execErrorPipe, O_CLOEXEC) != 0)
+        {
+            err = errno;
+        }
+        else
+        {
+            pid = fork();
+            if (pid == 0)
+            {
+                // This process may have other threads so only async-signal-safe calls are made until exec
+                if (callbacks)
+                {
+                    dup2(standardOutputPipe[1], STDOUT_FILENO);
+                    dup2(standardErrorPipe[1], STDERR_FILENO);
+                }
+                m_resourceLimits.applyToCurrentProcess();
+                execvp(argv[0], argv.data());
+                int execError = errno;
+                ssize_t written = write(execErrorPipe[1], &execError, sizeof(execError));
+                (void)written;
+                _exit(127);
+            }
+            close(execErrorPipe[1]);
+            if (pid < 0)
+            {
+                err = errno;
+            }
+            else
+            {
+                int execError = 0;
+                ssize_t size;
+                do
+                {
+                    size = read(execErrorPipe[0], &execError, sizeof(execError));
+                } while ((size < 0) && (errno == EINTR));
+                if (size == sizeof(execError))
+                {
+                    err = execError;
+                    while ((waitpid(pid, nullptr, 0) < 0) && (errno == EINTR))
+                    {
+                    }
+                }
+            }
+            close(execErrorPipe[0]);
+        }
+    }
+    else
+    {
+        // dup2 clears the close-on-exec flag on the target descriptors so only the write ends survive in the child
+        posix_spawn_file_actions_t fileActions;
+        posix_spawn_file_actions_init(&fileActions);
+        if (callbacks)
+        {
+            posix_spawn_file_actions_adddup2(&fileActions, standardOutputPipe[1], STDOUT_FILENO);
+            posix_spawn_file_actions_adddup2(&fileActions, standardErrorPipe[1], STDERR_FILENO);
+        }
+
+        err = posix_spawnp(&pid, argv[0], &fileActions, nullptr, argv.data(), environ);
+        posix_spawn_file_actions_destroy(&fileActions);
+    }
+
+    if (callbacks)
+    {
+        close(standardOutputPipe[1]);
+        close(standardErrorPipe[1]);
+    }
+
+    if (err != 0)
+    {
+        if (callbacks)
+        {
+            close(standardOutputPipe[0]);
+            close(standardErrorPipe[0]);
+        }
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return;
+    }
+
+    m_callbacks = callbacks;
+    m_pid = pid;
+    m_standardOutputFD = standardOutputPipe[0];
+    m_standardErrorFD = standardErrorPipe[0];
+    m_exited = false;
+    m_exitCode = -1;
+    m_resourceUsage = ChildProcessResourceUsage();
+    m_startTime = std::chrono::steady_clock::now();
+
+#ifdef SYS_pidfd_open
+    if (!m_forkServer)
+    {
+        // The descriptor is created with the close-on-exec flag set. This fails on kernels older than 5.3, users of
+        // exitDescriptor() then have to poll with tryWaitForExit(). A child forked by a ForkServer is not ours, its
+        // exit is reported by the server instead.
+        m_exitFD = (int)syscall(SYS_pidfd_open, pid, 0);
+    }
+#endif
+#else
+    Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+#endif
+}
+
+bool PipedChildProcess::readOutput(int timeout)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    if ((m_standardOutputFD < 0) && (m_standardErrorFD < 0))
+    {
+        return false;
+    }
+
+    pollfd fds[2];
+    nfds_t n = 0;
+    if (m_standardOutputFD >= 0)
+    {
+        fds[n].fd = m_standardOutputFD;
+        fds[n].events = POLLIN;
+        fds[n].revents = 0;
+        ++n;
+    }
+    if (m_standardErrorFD >= 0)
+    {
+        fds[n].fd = m_standardErrorFD;
+        fds[n].events = POLLIN;
+        fds[n].revents = 0;
+        ++n;
+    }
+
+    int ready = poll(fds, n, timeout);
+    if (ready < 0)
+    {
+        if (errno != EINTR)
+        {
+            stopReading();
+            return false;
+        }
+    }
+    else if (ready > 0)
+    {
+        for (nfds_t i = 0; i < n; ++i)
+        {
+            if (fds[i].revents != 0)
+            {
+                if (fds[i].fd == m_standardOutputFD)
+                {
+                    readStream(m_standardOutputFD, true);
+                }
+                else if (fds[i].fd == m_standardErrorFD)
+                {
+                    // The callbacks may have closed the streams so we check the descriptor is still ours
+                    readStream(m_standardErrorFD, false);
+                }
+            }
+        }
+    }
+
+    return ((m_standardOutputFD >= 0) || (m_standardErrorFD >= 0));
+#else
+    return false;
+#endif
+}
+
+void PipedChildProcess::readDescriptor(int descriptor)
+{
+    if (descriptor < 0)
+    {
+        return;
+    }
+    if (descriptor == m_standardOutputFD)
+    {
+        readStream(m_standardOutputFD, true);
+    }
+    else if (descriptor == m_standardErrorFD)
+    {
+        readStream(m_standardErrorFD, false);
+    }
+}
+
+void PipedChildProcess::readAllOutput()
+{
+    while (readOutput(-1))
+    {
+    }
+}
+
+void PipedChildProcess::stopReading()
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    if (m_standardOutputFD >= 0)
+    {
+        close(m_standardOutputFD);
+        m_standardOutputFD = -1;
+    }
+    if (m_standardErrorFD >= 0)
+    {
+        close(m_standardErrorFD);
+        m_standardErrorFD = -1;
+    }
+#endif
+}
+
+int PipedChildProcess::standardOutputDescriptor() const noexcept
+{
+    return m_standardOutputFD;
+}
+
+int PipedChildProcess::standardErrorDescriptor() const noexcept
+{
+    return m_standardErrorFD;
+}
+
+int PipedChildProcess::exitDescriptor() const noexcept
+{
+    if (m_forkServer && (m_pid > 0) && !m_exited)
+    {
+        return m_forkServer->descriptor();
+    }
+    return m_exitFD;
+}
+
+void PipedChildProcess::kill()
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    if ((m_pid > 0) && !m_exited)
+    {
+        ::kill(m_pid, SIGKILL);
+    }
+#endif
+}
+
+void PipedChildProcess::waitForExit()
+{
+    reap(true);
+}
+
+bool PipedChildProcess::tryWaitForExit()
+{
+    return reap(false);
+}
+
+bool PipedChildProcess::hasExited() const noexcept
+{
+    return m_exited;
+}
+
+int PipedChildProcess::exitCode() const noexcept
+{
+    return m_exitCode;
+}
+
+const ChildProcessResourceUsage& PipedChildProcess::resourceUsage() const noexcept
+{
+    return m_resourceUsage;
+}
+
+bool PipedChildProcess::readStream(int& fd, bool standardOutput)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    char buffer[65536];
+    ssize_t n = read(fd, buffer, sizeof(buffer));
+    if (n > 0)
+    {
+        if (standardOutput)
+        {
+            m_callbacks->onStandardOutput(buffer, n);
+        }
+        else
+        {
+            m_callbacks->onStandardError(buffer, n);
+        }
+        return true;
+    }
+    else if ((n < 0) && (errno == EINTR))
+    {
+        return true;
+    }
+    else
+    {
+        close(fd);
+        fd = -1;
+        return false;
+    }
+#else
+    return false;
+#endif
+}
+
+bool PipedChildProcess::reap(bool block)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    if ((m_pid <= 0) || m_exited)
+    {
+        return m_exited;
+    }
+
+    if (m_forkServer)
+    {
+        int status = 0;
+        if (!m_forkServer->waitForExit(m_pid, block, status, m_resourceUsage))
+        {
+            return false;
+        }
+        m_exited = true;
+        m_resourceUsage.wallTime = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - m_startTime);
+        // The server reports a status of -1 if it terminated before the child
+        if (status == -1)
+        {
+            m_exitCode = -1;
+        }
+        else
+        {
+            setExitStatus(status);
+        }
+        return true;
+    }
+
+    int status = 0;
+    rusage usage;
+    pid_t result;
+    do
+    {
+        result = wait4(m_pid, &status, (block ? 0 : WNOHANG), &usage);
+    } while ((result < 0) && (errno == EINTR));
+
+    if (result == 0)
+    {
+        // The child is still running
+        return false;
+    }
+
+    m_exited = true;
+    if (result > 0)
+    {
+        m_resourceUsage.userTime = std::chrono::seconds(usage.ru_utime.tv_sec)
+            + std::chrono::microseconds(usage.ru_utime.tv_usec);
+        m_resourceUsage.systemTime = std::chrono::seconds(usage.ru_stime.tv_sec)
+            + std::chrono::microseconds(usage.ru_stime.tv_usec);
+        m_resourceUsage.wallTime = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - m_startTime);
+        // ru_maxrss is in kilobytes on Linux
+        m_resourceUsage.maxResidentSetSize = (size_t)usage.ru_maxrss * 1024;
+        m_resourceUsage.blockInputOperations = usage.ru_inblock;
+        m_resourceUsage.blockOutputOperations = usage.ru_oublock;
+        setExitStatus(status);
+    }
+    else
+    {
+        m_exitCode = -1;
+    }
+    if (m_exitFD >= 0)
+    {
+        close(m_exitFD);
+        m_exitFD = -1;
+    }
+    return true;
+#else
+    return m_exited;
+#endif
+}
+
+void PipedChildProcess::setExitStatus(int status)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    if (WIFEXITED(status))
+    {
+        m_exitCode = WEXITSTATUS(status);
+    }
+    else if (WIFSIGNALED(status))
+    {
+        // Same convention as the shell
+        m_exitCode = 128 + WTERMSIG(status);
+    }
+#endif
+}
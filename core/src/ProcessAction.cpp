@@ -21,10 +21,22 @@ ProcessAction::~ProcessAction()
 {
 }
 
+void ProcessAction::setForkServer(std::shared_ptr<ForkServer> server)
+{
+    m_process.setForkServer(server);
+}
+
 void ProcessAction::setup(const Test& test)
 {
     Error error;
-    m_processHandle = ChildProcess::Spawn(m_commandLine, error);
+    if (PipedChildProcess::IsSupported())
+    {
+        m_process.start(m_commandLine, error);
+    }
+    else
+    {
+        m_processHandle = ChildProcess::Spawn(m_commandLine, error);
+    }
     if (error)
     {
         throw TestException("ProcessAction::setup failed to execute: " + m_commandLine);
@@ -33,12 +45,29 @@ void ProcessAction::setup(const Test& test)
 
 void ProcessAction::teardown()
 {
-    if (m_mode == eTerminate)
+    if (PipedChildProcess::IsSupported())
     {
-        m_processHandle.kill(0);
+        if (m_mode == eTerminate)
+        {
+            m_process.kill();
+        }
+
+        m_process.waitForExit();
+    }
+    else
+    {
+        if (m_mode == eTerminate)
+        {
+            m_processHandle.kill(0);
+        }
+
+        m_processHandle.waitForExit();
     }
+}
 
-    m_processHandle.waitForExit();
+const ChildProcessResourceUsage& ProcessAction::resourceUsage() const
+{
+    return m_process.resourceUsage();
 }
 
 }
@@ -0,0 +1,168 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PropertyTest.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace Ishiko;
+
+namespace
+{
+
+// Spreads consecutive values over the whole range so that the generators of consecutive cases don't start from
+// similar states (this is the splitmix64 finalizer)
+uint64_t MixBits(uint64_t value)
+{
+    value = ((value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL);
+    value = ((value ^ (value >> 27)) * 0x94D049BB133111EBULL);
+    return (value ^ (value >> 31));
+}
+
+}
+
+PropertyTestBase::PropertyTestBase(const TestNumber& number, const std::string& name, const TestContext& context)
+    : Test(number, name, context), m_seed(0), m_seedIsSet(false), m_caseCount(100),
+    m_parallelism(std::max(std::thread::hardware_concurrency(), 1U))
+{
+}
+
+uint64_t PropertyTestBase::seed() const noexcept
+{
+    return m_seed;
+}
+
+void PropertyTestBase::setSeed(uint64_t seed) noexcept
+{
+    m_seed = seed;
+    m_seedIsSet = true;
+}
+
+size_t PropertyTestBase::caseCount() const noexcept
+{
+    return m_caseCount;
+}
+
+void PropertyTestBase::setCaseCount(size_t count) noexcept
+{
+    m_caseCount = count;
+}
+
+size_t PropertyTestBase::parallelism() const noexcept
+{
+    return m_parallelism;
+}
+
+void PropertyTestBase::setParallelism(size_t parallelism) noexcept
+{
+    m_parallelism = std::max(parallelism, size_t(1));
+}
+
+std::mt19937_64 PropertyTestBase::caseRandom(size_t index) const
+{
+    return std::mt19937_64(MixBits(m_seed + index));
+}
+
+void PropertyTestBase::reportCounterexample(const std::string& input, size_t index, size_t shrinkSteps,
+    const Case& test)
+{
+    std::string message = ("Property failed for input " + input + " (seed: " + std::to_string(m_seed) + ", case: "
+        + std::to_string(index + 1) + " of " + std::to_string(m_caseCount) + ", shrunk " + std::to_string(shrinkSteps)
+        + " times)");
+    if (!test.failureMessage().empty())
+    {
+        message += ": " + test.failureMessage();
+    }
+    if (test.failureLine() != 0)
+    {
+        fail(message, test.failureFile(), test.failureLine());
+    }
+    else
+    {
+        fail(message, __FILE__, __LINE__);
+    }
+}
+
+void PropertyTestBase::doRun()
+{
+    if (!m_seedIsSet)
+    {
+        std::random_device randomDevice;
+        m_seed = ((static_cast<uint64_t>(randomDevice()) << 32) | randomDevice());
+    }
+
+    // The cases are handed out in order so all the cases before the first one that fails are run whatever the number
+    // of threads. This makes the reported counterexample depend only on the seed.
+    std::atomic<size_t> nextIndex(0);
+    std::atomic<size_t> firstFailedIndex(m_caseCount);
+    std::exception_ptr generatorException;
+    std::mutex generatorExceptionMutex;
+    auto work =
+        [this, &nextIndex, &firstFailedIndex, &generatorException, &generatorExceptionMutex](Case& test)
+        {
+            try
+            {
+                while (true)
+                {
+                    size_t index = nextIndex++;
+                    if ((index >= m_caseCount) || (index > firstFailedIndex))
+                    {
+                        break;
+                    }
+                    if (!checkGeneratedCase(test, index))
+                    {
+                        size_t current = firstFailedIndex;
+                        while ((index < current) && !firstFailedIndex.compare_exchange_weak(current, index))
+                        {
+                        }
+                    }
+                }
+            }
+            catch (...)
+            {
+                // The property's exceptions are caught by Case::check so this comes from a generator
+                std::lock_guard<std::mutex> lock(generatorExceptionMutex);
+                if (!generatorException)
+                {
+                    generatorException = std::current_exception();
+                }
+                firstFailedIndex = 0;
+                nextIndex = m_caseCount;
+            }
+        };
+
+    size_t threadCount = std::max(std::min(m_parallelism, m_caseCount), size_t(1));
+    std::vector<std::unique_ptr<Case>> cases;
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        cases.emplace_back(new Case(*this));
+    }
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; ++i)
+    {
+        threads.emplace_back(work, std::ref(*cases[i]));
+    }
+    work(*cases[0]);
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    if (generatorException)
+    {
+        std::rethrow_exception(generatorException);
+    }
+
+    if (firstFailedIndex < m_caseCount)
+    {
+        shrinkAndReport(*cases[0], firstFailedIndex);
+    }
+    else
+    {
+        pass();
+    }
+}
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "RepeatedTestCase.hpp"
+
+using namespace Ishiko;
+
+void RepeatedTestCase::FailureRecorder::onCheckFailed(const Test& source, const std::string& message,
+    const char* file, int line)
+{
+    // Only the first failure is kept, the ones that follow are often a consequence of it
+    if (m_message.empty() && (m_line == 0))
+    {
+        m_message = message;
+        m_file = file;
+        m_line = line;
+    }
+}
+
+RepeatedTestCase::RepeatedTestCase(const Test& owner)
+    : Test(owner.number(), owner.name(), owner.context()), m_failureRecorder(std::make_shared<FailureRecorder>())
+{
+    observers().add(m_failureRecorder);
+}
+
+const std::string& RepeatedTestCase::failureMessage() const noexcept
+{
+    return m_failureRecorder->m_message;
+}
+
+const char* RepeatedTestCase::failureFile() const noexcept
+{
+    return m_failureRecorder->m_file;
+}
+
+int RepeatedTestCase::failureLine() const noexcept
+{
+    return m_failureRecorder->m_line;
+}
+
+void RepeatedTestCase::prepare()
+{
+    reuse(number(), name());
+    m_failureRecorder->m_message.clear();
+    m_failureRecorder->m_file = "";
+    m_failureRecorder->m_line = 0;
+}
+
+bool RepeatedTestCase::completed()
+{
+    releaseChecks();
+    return ((result() != TestResult::failed) && (result() != TestResult::exception));
+}
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "SharedFixture.hpp"
+
+using namespace Ishiko;
+
+SharedFixture::SharedFixture(const std::string& name, std::shared_ptr<TestSetupAction> setupAction,
+    std::shared_ptr<TestTeardownAction> teardownAction)
+    : m_name(name), m_setupAction(setupAction), m_teardownAction(teardownAction), m_actionRunning(false),
+    m_dependentCount(0), m_remainingDependentCount(0), m_setUp(false), m_keptSetUp(false)
+{
+}
+
+const std::string& SharedFixture::name() const noexcept
+{
+    return m_name;
+}
+
+void SharedFixture::addDependent()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_dependentCount;
+    ++m_remainingDependentCount;
+}
+
+size_t SharedFixture::dependentCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dependentCount;
+}
+
+size_t SharedFixture::remainingDependentCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_remainingDependentCount;
+}
+
+bool SharedFixture::isSetUp() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_setUp;
+}
+
+void SharedFixture::setKeptSetUp(bool kept)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_keptSetUp = kept;
+}
+
+void SharedFixture::setup(const Test& test)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    waitForAction(lock);
+    if (m_setupException)
+    {
+        std::exception_ptr exception = m_setupException;
+        releaseDependent(lock, test);
+        std::rethrow_exception(exception);
+    }
+    if (m_setUp)
+    {
+        return;
+    }
+
+    // Other tests wait for the fixture to be ready but the action itself is free to use the fixture
+    m_actionRunning = true;
+    lock.unlock();
+    std::exception_ptr exception;
+    try
+    {
+        if (m_setupAction)
+        {
+            m_setupAction->setup(test);
+        }
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+    lock.lock();
+    m_actionRunning = false;
+    if (exception)
+    {
+        m_setupException = exception;
+    }
+    else
+    {
+        m_setUp = true;
+    }
+    m_actionCompleted.notify_all();
+    if (exception)
+    {
+        releaseDependent(lock, test);
+        std::rethrow_exception(exception);
+    }
+}
+
+void SharedFixture::teardown(const Test& test)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    waitForAction(lock);
+    releaseDependent(lock, test);
+}
+
+void SharedFixture::forceTeardown()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    waitForAction(lock);
+    doTeardown(lock, nullptr);
+}
+
+void SharedFixture::waitForAction(std::unique_lock<std::mutex>& lock)
+{
+    m_actionCompleted.wait(lock, [this]() { return !m_actionRunning; });
+}
+
+void SharedFixture::releaseDependent(std::unique_lock<std::mutex>& lock, const Test& test)
+{
+    if (m_remainingDependentCount > 0)
+    {
+        --m_remainingDependentCount;
+    }
+    if (m_remainingDependentCount == 0)
+    {
+        if (m_keptSetUp)
+        {
+            // A failed setup is tried again the next time the fixture is needed
+            m_setupException = nullptr;
+            m_remainingDependentCount = m_dependentCount;
+        }
+        else
+        {
+            doTeardown(lock, &test);
+        }
+    }
+}
+
+void SharedFixture::doTeardown(std::unique_lock<std::mutex>& lock, const Test* test)
+{
+    m_setupException = nullptr;
+    if (m_setUp)
+    {
+        m_setUp = false;
+        if (m_teardownAction)
+        {
+            m_actionRunning = true;
+            lock.unlock();
+            std::exception_ptr exception;
+            try
+            {
+                if (test)
+                {
+                    m_teardownAction->teardown(*test);
+                }
+                else
+                {
+                    m_teardownAction->teardown();
+                }
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+            lock.lock();
+            m_actionRunning = false;
+            m_remainingDependentCount = m_dependentCount;
+            m_actionCompleted.notify_all();
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+    }
+    // The count is re-armed so that the fixture is set up and torn down again if the tests are run again
+    m_remainingDependentCount = m_dependentCount;
+}
@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "SharedFixtureRegistry.hpp"
+
+using namespace Ishiko;
+
+SharedFixtureRegistry::SharedFixtureRegistry()
+    : m_keptSetUp(false)
+{
+}
+
+SharedFixtureRegistry::~SharedFixtureRegistry()
+{
+    try
+    {
+        teardownAll();
+    }
+    catch (...)
+    {
+        // There is nowhere to report the error
+    }
+}
+
+std::shared_ptr<SharedFixture> SharedFixtureRegistry::get(const std::string& name,
+    std::shared_ptr<TestSetupAction> setupAction, std::shared_ptr<TestTeardownAction> teardownAction)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_ptr<SharedFixture>& result = m_fixtures[name];
+    if (!result)
+    {
+        result = std::make_shared<SharedFixture>(name, setupAction, teardownAction);
+        result->setKeptSetUp(m_keptSetUp);
+    }
+    return result;
+}
+
+std::shared_ptr<SharedFixture> SharedFixtureRegistry::find(const std::string& name) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::map<std::string, std::shared_ptr<SharedFixture>>::const_iterator it = m_fixtures.find(name);
+    if (it != m_fixtures.end())
+    {
+        return it->second;
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+void SharedFixtureRegistry::teardownAll()
+{
+    std::map<std::string, std::shared_ptr<SharedFixture>> fixtures;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        fixtures = m_fixtures;
+    }
+    // The registry lock is not held while the teardown actions run as they are free to use the registry
+    for (std::pair<const std::string, std::shared_ptr<SharedFixture>>& fixture : fixtures)
+    {
+        fixture.second->forceTeardown();
+    }
+}
+
+void SharedFixtureRegistry::setKeptSetUp(bool kept)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_keptSetUp = kept;
+    for (std::pair<const std::string, std::shared_ptr<SharedFixture>>& fixture : m_fixtures)
+    {
+        fixture.second->setKeptSetUp(kept);
+    }
+}
@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "SummaryProgressObserver.hpp"
+#include <cstdio>
+
+using namespace Ishiko;
+
+namespace
+{
+
+std::string FormatNumber(const TestNumber& number)
+{
+    std::string result;
+    for (size_t i = 0; i < number.depth(); ++i)
+    {
+        result += std::to_string(number.part(i));
+        result += '.';
+    }
+    return result;
+}
+
+void AppendDuration(std::string& output, long long seconds)
+{
+    char formatted[32];
+    if (seconds >= 3600)
+    {
+        snprintf(formatted, sizeof(formatted), "%lldh%02lldm%02llds", seconds / 3600, (seconds % 3600) / 60,
+            seconds % 60);
+    }
+    else if (seconds >= 60)
+    {
+        snprintf(formatted, sizeof(formatted), "%lldm%02llds", seconds / 60, seconds % 60);
+    }
+    else
+    {
+        snprintf(formatted, sizeof(formatted), "%llds", seconds);
+    }
+    output += formatted;
+}
+
+}
+
+SummaryProgressObserver::SummaryProgressObserver(std::ostream& output, size_t expectedTestCases)
+    : m_output(output), m_expectedTestCases(expectedTestCases), m_refreshInterval(250),
+    m_runStart(std::chrono::steady_clock::now()), m_lastRefresh(m_runStart), m_completedTestCases(0),
+    m_failedTestCases(0), m_progressLineLength(0)
+{
+}
+
+void SummaryProgressObserver::setRefreshInterval(std::chrono::milliseconds interval)
+{
+    m_refreshInterval = interval;
+}
+
+size_t SummaryProgressObserver::completedTestCases() const noexcept
+{
+    return m_completedTestCases;
+}
+
+size_t SummaryProgressObserver::failedTestCases() const noexcept
+{
+    return m_failedTestCases;
+}
+
+void SummaryProgressObserver::onTestCaseCompleted(const Test& test, std::chrono::microseconds duration,
+    const std::vector<Failure>& failures)
+{
+    ++m_completedTestCases;
+
+    TestResult result = test.result();
+    if ((result != TestResult::passed) && (result != TestResult::skipped))
+    {
+        ++m_failedTestCases;
+
+        if (m_buffer.empty())
+        {
+            clearProgressLine();
+        }
+        m_buffer += FormatNumber(test.number());
+        m_buffer += ' ';
+        m_buffer += test.name();
+        m_buffer += ": ";
+        m_buffer += ToString(result);
+        m_buffer += '\n';
+        for (const Failure& failure : failures)
+        {
+            m_buffer += "    ";
+            m_buffer += (failure.message.empty() ? "Check failed" : failure.message);
+            if (!failure.file.empty())
+            {
+                m_buffer += " [file: ";
+                m_buffer += failure.file;
+                m_buffer += ", line: ";
+                m_buffer += std::to_string(failure.line);
+                m_buffer += ']';
+            }
+            m_buffer += '\n';
+        }
+    }
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if ((now - m_lastRefresh) >= m_refreshInterval)
+    {
+        if (m_buffer.empty())
+        {
+            clearProgressLine();
+        }
+        writeProgressLine(now);
+        flushBuffer();
+        m_lastRefresh = now;
+    }
+}
+
+void SummaryProgressObserver::onRunCompleted()
+{
+    if (m_buffer.empty())
+    {
+        clearProgressLine();
+    }
+    writeProgressLine(std::chrono::steady_clock::now());
+    m_buffer += '\n';
+    m_progressLineLength = 0;
+    flushBuffer();
+}
+
+void SummaryProgressObserver::clearProgressLine()
+{
+    if (m_progressLineLength > 0)
+    {
+        m_buffer += '\r';
+        m_buffer.append(m_progressLineLength, ' ');
+        m_buffer += '\r';
+        m_progressLineLength = 0;
+    }
+}
+
+void SummaryProgressObserver::writeProgressLine(std::chrono::steady_clock::time_point now)
+{
+    double elapsed = std::chrono::duration<double>(now - m_runStart).count();
+    double rate = ((elapsed > 0) ? (m_completedTestCases / elapsed) : 0);
+
+    std::string line = std::to_string(m_completedTestCases);
+    if (m_expectedTestCases != 0)
+    {
+        line += '/';
+        line += std::to_string(m_expectedTestCases);
+    }
+    line += " tests, ";
+    char formattedRate[32];
+    snprintf(formattedRate, sizeof(formattedRate), "%.1f", rate);
+    line += formattedRate;
+    line += " tests/s, ";
+    if ((m_expectedTestCases != 0) && (rate > 0))
+    {
+        size_t remaining =
+            ((m_expectedTestCases > m_completedTestCases) ? (m_expectedTestCases - m_completedTestCases) : 0);
+        line += "ETA ";
+        AppendDuration(line, static_cast<long long>(remaining / rate));
+        line += ", ";
+    }
+    line += std::to_string(m_failedTestCases);
+    line += ((m_failedTestCases == 1) ? " failure" : " failures");
+
+    m_buffer += line;
+    m_progressLineLength = line.size();
+}
+
+void SummaryProgressObserver::flushBuffer()
+{
+    m_output.write(m_buffer.data(), m_buffer.size());
+    m_output.flush();
+    m_buffer.clear();
+}
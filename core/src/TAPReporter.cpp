@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "TAPReporter.hpp"
+#include "JSONLinesReporter.hpp"
+
+using namespace Ishiko;
+
+namespace
+{
+
+// A '#' in the description would start a directive, e.g. a test named "case # SKIP" would be reported as skipped.
+// The escapes are the ones TAP version 13 defines and line breaks would end the test line so they are replaced.
+void WriteDescription(std::ostream& output, const std::string& description)
+{
+    for (char c : description)
+    {
+        switch (c)
+        {
+        case '#':
+            output << "\\#";
+            break;
+
+        case '\\':
+            output << "\\\\";
+            break;
+
+        case '\r':
+        case '\n':
+            output << ' ';
+            break;
+
+        default:
+            output << c;
+            break;
+        }
+    }
+}
+
+}
+
+TAPReporter::TAPReporter(std::ostream& output)
+    : m_output(output), m_headerWritten(false), m_count(0)
+{
+}
+
+void TAPReporter::onLifecycleEvent(const Test& source, EventType type)
+{
+    if (!m_headerWritten)
+    {
+        m_output << "TAP version 13\n";
+        m_headerWritten = true;
+    }
+    TestReporter::onLifecycleEvent(source, type);
+}
+
+void TAPReporter::onTestCaseCompleted(const Test& test, std::chrono::microseconds duration,
+    const std::vector<Failure>& failures)
+{
+    ++m_count;
+
+    TestResult result = test.result();
+    if ((result == TestResult::passed) || (result == TestResult::skipped))
+    {
+        m_output << "ok ";
+    }
+    else
+    {
+        m_output << "not ok ";
+    }
+    m_output << m_count << " - ";
+    WriteDescription(m_output, test.name());
+    if (result == TestResult::skipped)
+    {
+        m_output << " # SKIP";
+    }
+    m_output << '\n';
+
+    m_output << "  ---\n";
+    m_output << "  duration_ms: " << (duration.count() / 1000.0) << '\n';
+    if (!failures.empty())
+    {
+        m_output << "  failures:\n";
+        for (const Failure& failure : failures)
+        {
+            m_output << "    - message: ";
+            JSONLinesReporter::WriteString(m_output, failure.message);
+            m_output << '\n';
+            if (!failure.file.empty())
+            {
+                m_output << "      at: ";
+                JSONLinesReporter::WriteString(m_output, (failure.file + ":" + std::to_string(failure.line)));
+                m_output << '\n';
+            }
+        }
+    }
+    m_output << "  ...\n";
+}
+
+void TAPReporter::onRunCompleted()
+{
+    m_output << "1.." << m_count << '\n';
+    m_output.flush();
+}
@@ -2,13 +2,33 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "Test.hpp"
-#include "TestSequence.hpp"
-#include <Ishiko/FileSystem.hpp>
+#include "FixtureCopier.hpp"
+#include "TestException.hpp"
 #include <boost/filesystem/operations.hpp>
 #include <boost/range/algorithm.hpp>
 
 using namespace Ishiko;
 
+namespace
+{
+
+// The name of the output subdirectory of a test when isolated output directories are enabled, e.g. "1.2.3"
+std::string IsolatedOutputDirectoryName(const TestNumber& number)
+{
+    std::string result;
+    for (size_t i = 0; i < number.depth(); ++i)
+    {
+        if (i != 0)
+        {
+            result.push_back('.');
+        }
+        result.append(std::to_string(number.part(i)));
+    }
+    return result;
+}
+
+}
+
 void Test::Observer::onLifecycleEvent(const Test& source, EventType type)
 {
 }
@@ -59,6 +79,8 @@ void Test::Observers::remove(std::shared_ptr<Observer> observer)
 
 void Test::Observers::notifyLifecycleEvent(const Test& source, Observer::EventType type)
 {
+    // The deleted observers are only removed once we are done iterating over them
+    bool hasDeletedObservers = false;
     for (std::pair<std::weak_ptr<Observer>, size_t>& o : m_observers)
     {
         std::shared_ptr<Observer> observer = o.first.lock();
@@ -68,13 +90,18 @@ void Test::Observers::notifyLifecycleEvent(const Test& source, Observer::EventTy
         }
         else
         {
-            removeDeletedObservers();
+            hasDeletedObservers = true;
         }
     }
+    if (hasDeletedObservers)
+    {
+        removeDeletedObservers();
+    }
 }
 
 void Test::Observers::notifyCheckFailed(const Test& source, const std::string& message, const char* file, int line)
 {
+    bool hasDeletedObservers = false;
     for (std::pair<std::weak_ptr<Observer>, size_t>& o : m_observers)
     {
         std::shared_ptr<Observer> observer = o.first.lock();
@@ -84,13 +111,18 @@ void Test::Observers::notifyCheckFailed(const Test& source, const std::string& m
         }
         else
         {
-            removeDeletedObservers();
+            hasDeletedObservers = true;
         }
     }
+    if (hasDeletedObservers)
+    {
+        removeDeletedObservers();
+    }
 }
 
 void Test::Observers::notifyExceptionThrown(const Test& source, std::exception_ptr exception)
 {
+    bool hasDeletedObservers = false;
     for (std::pair<std::weak_ptr<Observer>, size_t>& o : m_observers)
     {
         std::shared_ptr<Observer> observer = o.first.lock();
@@ -100,9 +132,13 @@ void Test::Observers::notifyExceptionThrown(const Test& source, std::exception_p
         }
         else
         {
-            removeDeletedObservers();
+            hasDeletedObservers = true;
         }
     }
+    if (hasDeletedObservers)
+    {
+        removeDeletedObservers();
+    }
 }
 
 void Test::Observers::removeDeletedObservers()
@@ -125,43 +161,63 @@ void Test::Utilities::copy(const InterpolatedString& source, const InterpolatedS
 {
     boost::filesystem::path source_path = source.expand(m_test.context());
     boost::filesystem::path destination_path = destination.expand(m_test.context());
-    FileSystem::Copy(source_path, destination_path,
-        FileSystem::CopyOption::create_directories | FileSystem::CopyOption::recursive);
+    FixtureCopier copier;
+    Error error;
+    copier.copy(source_path, destination_path, error);
+    if (error)
+    {
+        throw TestException("failed to copy " + source_path.string() + " to " + destination_path.string());
+    }
+}
+
+void Test::Utilities::copyReadOnly(const InterpolatedString& source, const InterpolatedString& destination)
+{
+    boost::filesystem::path source_path = source.expand(m_test.context());
+    boost::filesystem::path destination_path = destination.expand(m_test.context());
+    FixtureCopier copier;
+    copier.setReadOnly(true);
+    Error error;
+    copier.copy(source_path, destination_path, error);
+    if (error)
+    {
+        throw TestException("failed to copy " + source_path.string() + " to " + destination_path.string());
+    }
 }
 
 Test::Test(const TestNumber& number, const std::string& name)
-    : m_number(number), m_name(name), m_result(TestResult::unknown),
-    m_context(&TestContext::DefaultTestContext()), m_memoryLeakCheck(true), m_runFct(0)
+    : m_number(number), m_name(name), m_result(TestResult::unknown), m_memoryLeakCheck(true),
+    m_context(&TestContext::DefaultTestContext()), m_runFct(0), m_children(nullptr)
 {
 }
 
 Test::Test(const TestNumber& number, const std::string& name, const TestContext& context)
-    : m_number(number), m_name(name), m_result(TestResult::unknown), m_context(&context),
-    m_memoryLeakCheck(true), m_runFct(0)
+    : m_number(number), m_name(name), m_result(TestResult::unknown), m_memoryLeakCheck(true),
+    m_context(&context), m_runFct(0), m_children(nullptr)
 {
 }
 
 Test::Test(const TestNumber& number, const std::string& name, TestResult result)
-    : m_number(number), m_name(name), m_result(result), m_context(&TestContext::DefaultTestContext()),
-    m_memoryLeakCheck(true), m_runFct(0)
+    : m_number(number), m_name(name), m_result(result), m_memoryLeakCheck(true),
+    m_context(&TestContext::DefaultTestContext()), m_runFct(0), m_children(nullptr)
 {
 }
 
 Test::Test(const TestNumber& number, const std::string& name, TestResult result, const TestContext& context)
-    : m_number(number), m_name(name), m_result(result), m_context(&context), m_memoryLeakCheck(true), m_runFct(0)
+    : m_number(number), m_name(name), m_result(result), m_memoryLeakCheck(true), m_context(&context),
+    m_runFct(0), m_children(nullptr)
 {
 }
 
 Test::Test(const TestNumber& number, const std::string& name, std::function<void(Test& test)> runFct)
-    : m_number(number), m_name(name), m_result(TestResult::unknown),
-    m_context(&TestContext::DefaultTestContext()), m_memoryLeakCheck(true), m_runFct(runFct)
+    : m_number(number), m_name(name), m_result(TestResult::unknown), m_memoryLeakCheck(true),
+    m_context(&TestContext::DefaultTestContext()), m_runFct(std::move(runFct)), m_children(nullptr)
 {
 }
 
 Test::Test(const TestNumber& number, const std::string& name, std::function<void(Test& test)> runFct,
     const TestContext& context)
-    : m_number(number), m_name(name), m_result(TestResult::unknown), m_context(&context), m_memoryLeakCheck(true),
-    m_runFct(runFct)
+    : m_number(number), m_name(name), m_result(TestResult::unknown), m_memoryLeakCheck(true),
+    m_context(&context), m_runFct(std::move(runFct)), m_children(nullptr)
 {
 }
 
@@ -302,7 +358,14 @@ Test::Utilities Test::utils() const
 
 void Test::appendCheck(std::shared_ptr<TestCheck> check)
 {
-    m_checks.push_back(check);
+    Extras& e = extras();
+    e.checks.push_back(check.get());
+    e.appendedChecks.push_back(std::move(check));
+}
+
+size_t Test::checkCount() const noexcept
+{
+    return (m_extras ? m_extras->checks.size() : 0);
 }
 
 size_t Test::allocationCount() const
@@ -358,19 +421,70 @@ void Test::run()
     }
 
     teardown();
+    releaseChecks();
 
     m_executionEndTime = SystemTime::Now();
     notify(Observer::test_end);
 }
 
+void Test::reset()
+{
+    m_result = TestResult::unknown;
+    if (m_extras)
+    {
+        // The failed checks kept by the previous run are not relevant anymore
+        m_extras->checks.clear();
+        m_extras->appendedChecks.clear();
+        m_extras->checkArena.clear();
+    }
+}
+
+bool Test::launch(ChildProcessPool& pool)
+{
+    return false;
+}
+
 void Test::addSetupAction(std::shared_ptr<TestSetupAction> action)
 {
-    m_setupActions.push_back(action);
+    extras().setupActions.push_back(action);
 }
 
 void Test::addTeardownAction(std::shared_ptr<TestTeardownAction> action)
 {
-    m_teardownActions.push_back(action);
+    extras().teardownActions.push_back(action);
+}
+
+void Test::addSharedFixture(const std::string& name, std::shared_ptr<TestSetupAction> setupAction,
+    std::shared_ptr<TestTeardownAction> teardownAction)
+{
+    std::shared_ptr<SharedFixture> fixture;
+    SharedFixtureRegistry* registry = m_context.getSharedFixtureRegistry();
+    if (registry)
+    {
+        fixture = registry->get(name, setupAction, teardownAction);
+    }
+    else
+    {
+        fixture = std::make_shared<SharedFixture>(name, setupAction, teardownAction);
+    }
+    fixture->addDependent();
+    addSetupAction(fixture);
+    addTeardownAction(fixture);
+}
+
+size_t Test::childCount() const noexcept
+{
+    return (m_children ? m_children->size() : 0);
+}
+
+const Test& Test::child(size_t pos) const
+{
+    return *(*m_children)[pos];
+}
+
+Test& Test::child(size_t pos)
+{
+    return *(*m_children)[pos];
 }
 
 void Test::traverse(std::function<void(const Test& test)> function) const
@@ -386,6 +500,7 @@ Test::Observers& Test::observers()
 void Test::addToJUnitXMLTestReport(JUnitXMLWriter& writer) const
 {
     writer.writeTestCaseStart("unknown", m_name);
+    addPropertiesToJUnitXMLTestReport(writer);
     switch (m_result)
     {
     case TestResult::passed:
@@ -397,15 +512,18 @@ void Test::addToJUnitXMLTestReport(JUnitXMLWriter& writer) const
             // TODO: this assume we enforce consistency between test failure and check->result(). Need to enforce that
             // in Test::run().
             bool atLeastOneTestCheckFailed = false;
-            for (const std::shared_ptr<TestCheck>& check : m_checks)
+            if (m_extras)
             {
-                if (check->result() != TestCheck::Result::passed)
+                for (const TestCheck* check : m_extras->checks)
                 {
-                    writer.writeFailureStart();
-                    check->addToJUnitXMLTestReport(writer);
-                    writer.writeFailureEnd();
-
-                    atLeastOneTestCheckFailed = true;
+                    if (check->result() != TestCheck::Result::passed)
+                    {
+                        writer.writeFailureStart();
+                        check->addToJUnitXMLTestReport(writer);
+                        writer.writeFailureEnd();
+
+                        atLeastOneTestCheckFailed = true;
+                    }
                 }
             }
             // If the failure is not due to one the checks, we still want to make sure we mark the test as failed.
@@ -429,17 +547,45 @@ void Test::addToJUnitXMLTestReport(JUnitXMLWriter& writer) const
     writer.writeTestCaseEnd();
 }
 
+void Test::addPropertiesToJUnitXMLTestReport(JUnitXMLWriter& writer) const
+{
+}
+
+bool Test::hasIsolatedOutputDirectory() const
+{
+    return true;
+}
+
+void Test::setChildren(const std::vector<std::shared_ptr<Test>>* children) noexcept
+{
+    m_children = children;
+}
+
+bool Test::hasSetupActions() const noexcept
+{
+    return (m_extras && !m_extras->setupActions.empty());
+}
+
 void Test::setup()
 {
+    // Tests without a number are typically run from within another test and share its subdirectory
+    if ((m_number.depth() > 0) && hasIsolatedOutputDirectory())
+    {
+        m_context.isolateOutputDirectory(IsolatedOutputDirectoryName(m_number));
+    }
+
     boost::filesystem::path outputDirectory = m_context.getOutputDirectory();
     if (outputDirectory != "")
     {
         boost::filesystem::create_directories(outputDirectory);
     }
 
-    for (size_t i = 0; i < m_setupActions.size(); ++i)
+    if (m_extras)
     {
-        m_setupActions[i]->setup(*this);
+        for (size_t i = 0; i < m_extras->setupActions.size(); ++i)
+        {
+            m_extras->setupActions[i]->setup(*this);
+        }
     }
 }
 
@@ -453,10 +599,64 @@ void Test::doRun()
 
 void Test::teardown()
 {
-    for (size_t i = 0; i < m_teardownActions.size(); ++i)
+    if (m_extras)
+    {
+        for (size_t i = 0; i < m_extras->teardownActions.size(); ++i)
+        {
+            m_extras->teardownActions[i]->teardown(*this);
+        }
+    }
+}
+
+void Test::releaseChecks()
+{
+    if (!m_extras)
+    {
+        return;
+    }
+
+    // The checks that didn't pass stay alive so that they can describe the failure in the JUnit XML report, most tests
+    // pass so this is rarely needed
+    std::vector<TestCheck*> failedChecks;
+    std::vector<std::shared_ptr<TestCheck>> failedAppendedChecks;
+    for (TestCheck* check : m_extras->checks)
+    {
+        if (check->result() != TestCheck::Result::passed)
+        {
+            failedChecks.push_back(check);
+        }
+    }
+    for (std::shared_ptr<TestCheck>& check : m_extras->appendedChecks)
+    {
+        if (check->result() != TestCheck::Result::passed)
+        {
+            failedAppendedChecks.push_back(std::move(check));
+        }
+    }
+    // The arena can only be cleared as a whole so it is kept if one of its checks failed
+    if (failedChecks.size() == failedAppendedChecks.size())
+    {
+        m_extras->checkArena.clear();
+    }
+    // Swapping is the only way to be sure the memory is given back
+    m_extras->checks.swap(failedChecks);
+    m_extras->appendedChecks.swap(failedAppendedChecks);
+}
+
+void Test::reuse(const TestNumber& number, const std::string& name)
+{
+    m_number = number;
+    m_name = name;
+    Test::reset();
+}
+
+Test::Extras& Test::extras()
+{
+    if (!m_extras)
     {
-        m_teardownActions[i]->teardown();
+        m_extras.reset(new Extras());
     }
+    return *m_extras;
 }
 
 void Test::notify(Observer::EventType type)
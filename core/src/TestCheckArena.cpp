@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "TestCheckArena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+using namespace Ishiko;
+
+namespace
+{
+
+// Large enough for a dozen FileComparisonTestCheck objects
+const size_t defaultBlockCapacity = 4096;
+
+}
+
+struct TestCheckArena::Block
+{
+    Block* previous;
+    size_t capacity;
+    size_t used;
+
+    char* data()
+    {
+        return reinterpret_cast<char*>(this + 1);
+    }
+};
+
+TestCheckArena::TestCheckArena() noexcept
+    : m_currentBlock(nullptr), m_lastEntry(nullptr), m_size(0)
+{
+}
+
+TestCheckArena::~TestCheckArena()
+{
+    clear();
+}
+
+void TestCheckArena::clear() noexcept
+{
+    while (m_lastEntry)
+    {
+        Entry* entry = m_lastEntry;
+        m_lastEntry = entry->previous;
+        entry->check->~TestCheck();
+    }
+    while (m_currentBlock)
+    {
+        Block* block = m_currentBlock;
+        m_currentBlock = block->previous;
+        ::operator delete(block);
+    }
+    m_size = 0;
+}
+
+size_t TestCheckArena::size() const noexcept
+{
+    return m_size;
+}
+
+void* TestCheckArena::allocate(size_t size, size_t alignment)
+{
+    if (m_currentBlock)
+    {
+        uintptr_t start = reinterpret_cast<uintptr_t>(m_currentBlock->data() + m_currentBlock->used);
+        size_t padding = ((alignment - (start % alignment)) % alignment);
+        if ((m_currentBlock->used + padding + size) <= m_currentBlock->capacity)
+        {
+            void* result = m_currentBlock->data() + m_currentBlock->used + padding;
+            m_currentBlock->used += (padding + size);
+            return result;
+        }
+    }
+
+    // The block header keeps the data aligned for fundamental types, the extra bytes cover over-aligned ones
+    size_t capacity = std::max(defaultBlockCapacity, (size + alignment));
+    Block* block = static_cast<Block*>(::operator new(sizeof(Block) + capacity));
+    block->previous = m_currentBlock;
+    block->capacity = capacity;
+    block->used = 0;
+    m_currentBlock = block;
+    return allocate(size, alignment);
+}
@@ -3,6 +3,7 @@
 
 #include "TestContext.hpp"
 #include "TestException.hpp"
+#include "TestFileDependencies.hpp"
 #include "TestFrameworkErrorCategory.hpp"
 #include <Ishiko/BasePlatform.hpp>
 #include <Ishiko/FileSystem.hpp>
@@ -10,25 +11,109 @@
 
 using namespace Ishiko;
 
+namespace
+{
+
+// Incremented whenever a directory is set in any context. The cached paths of a context were resolved with the
+// directories of its ancestors too, comparing a single counter is cheaper than walking them on every lookup.
+std::atomic<unsigned long> PathEpoch(0);
+
+}
+
 TestContext::TestContext()
-    : m_parent(nullptr)
+    : m_parent(nullptr), m_resolvedPaths(nullptr)
 {
-    m_dataDirectories["(default)"] = boost::filesystem::path();
-    m_referenceDirectories["(default)"] = boost::filesystem::path();
-    m_outputDirectories["(default)"] = boost::filesystem::path();
+    settings().dataDirectories["(default)"] = boost::filesystem::path();
+    settings().referenceDirectories["(default)"] = boost::filesystem::path();
+    settings().outputDirectories["(default)"] = boost::filesystem::path();
 }
 
 TestContext::TestContext(const TestContext* parent)
-    : m_parent(parent)
+    : m_parent(parent), m_resolvedPaths(nullptr)
 {
 }
 
+TestContext::TestContext(const TestContext& other)
+    : m_parent(other.m_parent), m_resolvedPaths(nullptr)
+{
+    if (other.m_settings)
+    {
+        m_settings.reset(new Settings(*other.m_settings));
+    }
+    if (other.m_services)
+    {
+        m_services.reset(new Services(*other.m_services));
+    }
+}
+
+TestContext& TestContext::operator=(const TestContext& other)
+{
+    if (this != &other)
+    {
+        m_parent = other.m_parent;
+        if (other.m_settings)
+        {
+            m_settings.reset(new Settings(*other.m_settings));
+        }
+        else
+        {
+            m_settings.reset();
+        }
+        if (other.m_services)
+        {
+            m_services.reset(new Services(*other.m_services));
+        }
+        else
+        {
+            m_services.reset();
+        }
+        delete m_resolvedPaths.exchange(nullptr);
+        // The children of this context may have cached paths resolved with the old settings
+        ++PathEpoch;
+    }
+    return *this;
+}
+
+TestContext::TestContext(TestContext&& other) noexcept
+    : m_parent(other.m_parent), m_settings(std::move(other.m_settings)), m_services(std::move(other.m_services)),
+    m_resolvedPaths(other.m_resolvedPaths.exchange(nullptr))
+{
+}
+
+TestContext& TestContext::operator=(TestContext&& other) noexcept
+{
+    if (this != &other)
+    {
+        m_parent = other.m_parent;
+        m_settings = std::move(other.m_settings);
+        m_services = std::move(other.m_services);
+        delete m_resolvedPaths.exchange(other.m_resolvedPaths.exchange(nullptr));
+        ++PathEpoch;
+    }
+    return *this;
+}
+
+TestContext::~TestContext() noexcept
+{
+    delete m_resolvedPaths.load();
+}
+
 const TestContext& TestContext::DefaultTestContext()
 {
     static TestContext defaultContext;
     return defaultContext;
 }
 
+void TestContext::clearPathCache() const
+{
+    ResolvedPaths* paths = m_resolvedPaths.load(std::memory_order_acquire);
+    if (paths)
+    {
+        std::lock_guard<std::mutex> lock(paths->mutex);
+        paths->clear();
+    }
+}
+
 void TestContext::expand(boost::string_view variable, std::string& result, Error& error) const
 {
     if (variable == "context.data")
@@ -54,10 +139,16 @@ boost::filesystem::path TestContext::getDataDirectory() const
 boost::filesystem::path TestContext::getDataDirectory(const std::string& id) const
 {
     boost::filesystem::path result;
-    std::map<std::string, boost::filesystem::path>::const_iterator it = m_dataDirectories.find(id);
+    if (findResolvedPath(&ResolvedPaths::dataDirectories, id, result))
+    {
+        return result;
+    }
+
+    const std::map<std::string, boost::filesystem::path>& directories = settings().dataDirectories;
+    std::map<std::string, boost::filesystem::path>::const_iterator it = directories.find(id);
     if (m_parent)
     {
-        if (it != m_dataDirectories.end())
+        if (it != directories.end())
         {
             result = (m_parent->getDataDirectory(id) / it->second);
         }
@@ -68,21 +159,28 @@ boost::filesystem::path TestContext::getDataDirectory(const std::string& id) con
     }
     else
     {
-        if (it != m_dataDirectories.end())
+        if (it != directories.end())
         {
-            return it->second;
+            result = it->second;
         }
         else
         {
             throw TestException("getDataDirectory: no directory found with id " + id);
         }
     }
+    storeResolvedPath(&ResolvedPaths::dataDirectories, id, result);
     return result;
 }
 
 boost::filesystem::path TestContext::getDataPath(const boost::filesystem::path& path) const
 {
-    return getDataDirectory() / path;
+    boost::filesystem::path result = getDataDirectory() / path;
+    TestFileDependencies* dependencies = getFileDependencies();
+    if (dependencies)
+    {
+        dependencies->record(result);
+    }
+    return result;
 }
 
 void TestContext::setDataDirectory(const boost::filesystem::path& path)
@@ -95,7 +193,8 @@ void TestContext::setDataDirectory(const std::string& id, const boost::filesyste
     std::string expandedPath = CurrentEnvironment::ExpandVariablesInString(path.string(),
         CurrentEnvironment::SubstitutionFormat::DollarAndCurlyBrackets);
 
-    m_dataDirectories[id] = expandedPath;
+    settings().dataDirectories[id] = expandedPath;
+    ++PathEpoch;
 }
 
 boost::filesystem::path TestContext::getReferenceDirectory() const
@@ -106,10 +205,16 @@ boost::filesystem::path TestContext::getReferenceDirectory() const
 boost::filesystem::path TestContext::getReferenceDirectory(const std::string& id) const
 {
     boost::filesystem::path result;
-    std::map<std::string, boost::filesystem::path>::const_iterator it = m_referenceDirectories.find(id);
+    if (findResolvedPath(&ResolvedPaths::referenceDirectories, id, result))
+    {
+        return result;
+    }
+
+    const std::map<std::string, boost::filesystem::path>& directories = settings().referenceDirectories;
+    std::map<std::string, boost::filesystem::path>::const_iterator it = directories.find(id);
     if (m_parent)
     {
-        if (it != m_referenceDirectories.end())
+        if (it != directories.end())
         {
             result = (m_parent->getReferenceDirectory(id) / it->second);
         }
@@ -120,20 +225,33 @@ boost::filesystem::path TestContext::getReferenceDirectory(const std::string& id
     }
     else
     {
-        if (it != m_referenceDirectories.end())
+        if (it != directories.end())
         {
-            return it->second;
+            result = it->second;
         }
         else
         {
             throw TestException("getReferenceDirectory: no directory found with id " + id);
         }
     }
+    storeResolvedPath(&ResolvedPaths::referenceDirectories, id, result);
     return result;
 }
 
 boost::filesystem::path TestContext::getReferencePath(const boost::filesystem::path& path,
     PathResolution path_resolution) const
+{
+    boost::filesystem::path result = resolveReferencePath(path, path_resolution);
+    TestFileDependencies* dependencies = getFileDependencies();
+    if (dependencies)
+    {
+        dependencies->record(result);
+    }
+    return result;
+}
+
+boost::filesystem::path TestContext::resolveReferencePath(const boost::filesystem::path& path,
+    PathResolution path_resolution) const
 {
     if (path_resolution == PathResolution::none)
     {
@@ -141,6 +259,12 @@ boost::filesystem::path TestContext::getReferencePath(const boost::filesystem::p
     }
     else
     {
+        boost::filesystem::path cached;
+        if (findResolvedPath(&ResolvedPaths::platformSpecificReferencePaths, path.string(), cached))
+        {
+            return cached;
+        }
+
         const std::string& os_family = OS::Family();
         boost::filesystem::path platform_specific_path = path;
         if (platform_specific_path.has_extension())
@@ -177,6 +301,7 @@ boost::filesystem::path TestContext::getReferencePath(const boost::filesystem::p
                 proposed_reference_path = getReferenceDirectory() / path;
             }
         }
+        storeResolvedPath(&ResolvedPaths::platformSpecificReferencePaths, path.string(), proposed_reference_path);
         return proposed_reference_path;
     }
 }
@@ -191,7 +316,8 @@ void TestContext::setReferenceDirectory(const std::string& id, const boost::file
     std::string expandedPath = CurrentEnvironment::ExpandVariablesInString(path.string(),
         CurrentEnvironment::SubstitutionFormat::DollarAndCurlyBrackets);
 
-    m_referenceDirectories[id] = expandedPath;
+    settings().referenceDirectories[id] = expandedPath;
+    ++PathEpoch;
 }
 
 boost::filesystem::path TestContext::getOutputDirectory() const
@@ -202,10 +328,16 @@ boost::filesystem::path TestContext::getOutputDirectory() const
 boost::filesystem::path TestContext::getOutputDirectory(const std::string& id) const
 {
     boost::filesystem::path result;
-    std::map<std::string, boost::filesystem::path>::const_iterator it = m_outputDirectories.find(id);
+    if (findResolvedPath(&ResolvedPaths::outputDirectories, id, result))
+    {
+        return result;
+    }
+
+    const std::map<std::string, boost::filesystem::path>& directories = settings().outputDirectories;
+    std::map<std::string, boost::filesystem::path>::const_iterator it = directories.find(id);
     if (m_parent)
     {
-        if (it != m_outputDirectories.end())
+        if (it != directories.end())
         {
             result = (m_parent->getOutputDirectory(id) / it->second);
         }
@@ -216,25 +348,32 @@ boost::filesystem::path TestContext::getOutputDirectory(const std::string& id) c
     }
     else
     {
-        if (it != m_outputDirectories.end())
+        if (it != directories.end())
         {
-            return it->second;
+            result = it->second;
         }
         else
         {
             throw TestException("getOutputDirectory: no directory found with id " + id);
         }
     }
+    storeResolvedPath(&ResolvedPaths::outputDirectories, id, result);
     return result;
 }
 
 boost::filesystem::path TestContext::getOutputDirectory(const std::string& id, Error& error) const
 {
     boost::filesystem::path result;
-    std::map<std::string, boost::filesystem::path>::const_iterator it = m_outputDirectories.find(id);
+    if (findResolvedPath(&ResolvedPaths::outputDirectories, id, result))
+    {
+        return result;
+    }
+
+    const std::map<std::string, boost::filesystem::path>& directories = settings().outputDirectories;
+    std::map<std::string, boost::filesystem::path>::const_iterator it = directories.find(id);
     if (m_parent)
     {
-        if (it != m_outputDirectories.end())
+        if (it != directories.end())
         {
             result = (m_parent->getOutputDirectory(id) / it->second);
         }
@@ -245,7 +384,7 @@ boost::filesystem::path TestContext::getOutputDirectory(const std::string& id, E
     }
     else
     {
-        if (it != m_outputDirectories.end())
+        if (it != directories.end())
         {
             return it->second;
         }
@@ -272,15 +411,47 @@ void TestContext::setOutputDirectory(const std::string& id, const boost::filesys
     std::string expandedPath = CurrentEnvironment::ExpandVariablesInString(path.string(),
         CurrentEnvironment::SubstitutionFormat::DollarAndCurlyBrackets);
 
-    m_outputDirectories[id] = expandedPath;
+    settings().outputDirectories[id] = expandedPath;
+    ++PathEpoch;
+}
+
+bool TestContext::isolatedOutputDirectories() const
+{
+    if (m_settings && m_settings->isolatedOutputDirectories)
+    {
+        return *m_settings->isolatedOutputDirectories;
+    }
+    else if (m_parent)
+    {
+        return m_parent->isolatedOutputDirectories();
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void TestContext::setIsolatedOutputDirectories(bool isolated)
+{
+    settings().isolatedOutputDirectories = isolated;
+}
+
+void TestContext::isolateOutputDirectory(const std::string& name)
+{
+    if (m_parent && isolatedOutputDirectories()
+        && (!m_settings || (m_settings->outputDirectories.find("(default)") == m_settings->outputDirectories.end())))
+    {
+        settings().outputDirectories["(default)"] = name;
+        ++PathEpoch;
+    }
 }
 
 boost::filesystem::path TestContext::getApplicationPath() const
 {
     boost::filesystem::path result;
-    if (m_application_path)
+    if (m_settings && m_settings->applicationPath)
     {
-        result = *m_application_path;
+        result = *m_settings->applicationPath;
     }
     else
     {
@@ -298,5 +469,196 @@ boost::filesystem::path TestContext::getApplicationPath() const
 
 void TestContext::setApplicationPath(const boost::filesystem::path& path)
 {
-    m_application_path = path;
+    settings().applicationPath = path;
+}
+
+ChildProcessPool* TestContext::getChildProcessPool() const
+{
+    if (m_services && m_services->childProcessPool)
+    {
+        return m_services->childProcessPool.get();
+    }
+    else if (m_parent)
+    {
+        return m_parent->getChildProcessPool();
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+void TestContext::setChildProcessPool(std::shared_ptr<ChildProcessPool> pool)
+{
+    services().childProcessPool = pool;
+}
+
+SharedFixtureRegistry* TestContext::getSharedFixtureRegistry() const
+{
+    if (m_services && m_services->sharedFixtureRegistry)
+    {
+        return m_services->sharedFixtureRegistry.get();
+    }
+    else if (m_parent)
+    {
+        return m_parent->getSharedFixtureRegistry();
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+void TestContext::setSharedFixtureRegistry(std::shared_ptr<SharedFixtureRegistry> registry)
+{
+    services().sharedFixtureRegistry = registry;
+}
+
+BackgroundDeleter* TestContext::getBackgroundDeleter() const
+{
+    if (m_services && m_services->backgroundDeleter)
+    {
+        return m_services->backgroundDeleter.get();
+    }
+    else if (m_parent)
+    {
+        return m_parent->getBackgroundDeleter();
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+void TestContext::setBackgroundDeleter(std::shared_ptr<BackgroundDeleter> deleter)
+{
+    services().backgroundDeleter = deleter;
+}
+
+MemoryBackedOutputDirectory* TestContext::getMemoryBackedOutputDirectory() const
+{
+    if (m_services && m_services->memoryBackedOutputDirectory)
+    {
+        return m_services->memoryBackedOutputDirectory.get();
+    }
+    else if (m_parent)
+    {
+        return m_parent->getMemoryBackedOutputDirectory();
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+void TestContext::setMemoryBackedOutputDirectory(std::shared_ptr<MemoryBackedOutputDirectory> directory)
+{
+    services().memoryBackedOutputDirectory = directory;
+}
+
+TestFileDependencies* TestContext::getFileDependencies() const
+{
+    if (m_services && m_services->fileDependencies)
+    {
+        return m_services->fileDependencies.get();
+    }
+    else if (m_parent)
+    {
+        return m_parent->getFileDependencies();
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+void TestContext::setFileDependencies(std::shared_ptr<TestFileDependencies> dependencies)
+{
+    services().fileDependencies = dependencies;
+}
+
+const TestContext::Settings& TestContext::settings() const
+{
+    static const Settings defaultSettings;
+    if (m_settings)
+    {
+        return *m_settings;
+    }
+    else
+    {
+        return defaultSettings;
+    }
+}
+
+TestContext::Settings& TestContext::settings()
+{
+    if (!m_settings)
+    {
+        m_settings.reset(new Settings());
+    }
+    return *m_settings;
+}
+
+TestContext::ResolvedPaths& TestContext::resolvedPaths() const
+{
+    // Tests running on different threads may get here at the same time, the first cache to be published is used
+    ResolvedPaths* paths = m_resolvedPaths.load(std::memory_order_acquire);
+    if (!paths)
+    {
+        std::unique_ptr<ResolvedPaths> newPaths(new ResolvedPaths());
+        if (m_resolvedPaths.compare_exchange_strong(paths, newPaths.get(), std::memory_order_acq_rel))
+        {
+            paths = newPaths.release();
+        }
+    }
+    return *paths;
+}
+
+unsigned long TestContext::pathVersion() const
+{
+    return PathEpoch.load(std::memory_order_acquire);
+}
+
+bool TestContext::findResolvedPath(PathMap map, const std::string& key, boost::filesystem::path& result) const
+{
+    unsigned long version = pathVersion();
+    ResolvedPaths& paths = resolvedPaths();
+    std::lock_guard<std::mutex> lock(paths.mutex);
+    if (paths.version != version)
+    {
+        paths.clear();
+        paths.version = version;
+        return false;
+    }
+    std::map<std::string, boost::filesystem::path>::const_iterator it = (paths.*map).find(key);
+    if (it == (paths.*map).end())
+    {
+        return false;
+    }
+    result = it->second;
+    return true;
+}
+
+void TestContext::storeResolvedPath(PathMap map, const std::string& key, const boost::filesystem::path& path) const
+{
+    ResolvedPaths& paths = resolvedPaths();
+    std::lock_guard<std::mutex> lock(paths.mutex);
+    (paths.*map)[key] = path;
+}
+
+void TestContext::ResolvedPaths::clear()
+{
+    dataDirectories.clear();
+    referenceDirectories.clear();
+    outputDirectories.clear();
+    platformSpecificReferencePaths.clear();
+}
+
+TestContext::Services& TestContext::services()
+{
+    if (!m_services)
+    {
+        m_services.reset(new Services());
+    }
+    return *m_services;
 }
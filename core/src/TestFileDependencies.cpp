@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "TestFileDependencies.hpp"
+#include <boost/filesystem/operations.hpp>
+#include <algorithm>
+
+using namespace Ishiko;
+
+namespace
+{
+
+// Returns true if path is parent or one of its descendants, parent must be normalized
+bool IsSameOrDescendant(const boost::filesystem::path& path, const boost::filesystem::path& parent)
+{
+    boost::filesystem::path::const_iterator pathIt = path.begin();
+    for (const boost::filesystem::path& element : parent)
+    {
+        if ((pathIt == path.end()) || (*pathIt != element))
+        {
+            return false;
+        }
+        ++pathIt;
+    }
+    return true;
+}
+
+}
+
+TestFileDependencies::TestFileDependencies()
+    : m_depth(0), m_currentTest(nullptr)
+{
+}
+
+void TestFileDependencies::onLifecycleEvent(const Test& source, EventType type)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    switch (type)
+    {
+    case test_start:
+        if (m_depth == 0)
+        {
+            // The observer only gets const tests but it's the harness that runs them again, which owns them
+            m_currentTest = const_cast<Test*>(&source);
+            std::map<const Test*, std::set<boost::filesystem::path>>::iterator it =
+                m_dependencies.find(m_currentTest);
+            if (it == m_dependencies.end())
+            {
+                m_tests.push_back(m_currentTest);
+                m_dependencies[m_currentTest];
+            }
+            else
+            {
+                it->second.clear();
+            }
+        }
+        ++m_depth;
+        break;
+
+    case test_end:
+        if (m_depth > 0)
+        {
+            --m_depth;
+            if (m_depth == 0)
+            {
+                m_currentTest = nullptr;
+            }
+        }
+        break;
+    }
+}
+
+void TestFileDependencies::record(const boost::filesystem::path& path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_currentTest)
+    {
+        m_dependencies[m_currentTest].insert(Normalize(path));
+    }
+}
+
+std::vector<Test*> TestFileDependencies::findAffectedTests(
+    const std::vector<boost::filesystem::path>& changedPaths) const
+{
+    std::vector<boost::filesystem::path> normalizedPaths;
+    for (const boost::filesystem::path& path : changedPaths)
+    {
+        normalizedPaths.push_back(Normalize(path));
+    }
+
+    std::vector<Test*> result;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (Test* test : m_tests)
+    {
+        const std::set<boost::filesystem::path>& dependencies = m_dependencies.find(test)->second;
+        bool affected = std::any_of(dependencies.begin(), dependencies.end(),
+            [&normalizedPaths](const boost::filesystem::path& dependency)
+            {
+                return std::any_of(normalizedPaths.begin(), normalizedPaths.end(),
+                    [&dependency](const boost::filesystem::path& changedPath)
+                    {
+                        return IsSameOrDescendant(changedPath, dependency);
+                    });
+            });
+        if (affected)
+        {
+            result.push_back(test);
+        }
+    }
+    return result;
+}
+
+boost::filesystem::path TestFileDependencies::Normalize(const boost::filesystem::path& path)
+{
+    boost::filesystem::path result = boost::filesystem::absolute(path).lexically_normal();
+    // lexically_normal leaves a trailing "." for paths that end with a separator
+    if (result.filename() == ".")
+    {
+        result = result.parent_path();
+    }
+    return result;
+}
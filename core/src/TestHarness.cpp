@@ -2,17 +2,114 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "TestHarness.hpp"
+#include "BinaryResultLogObserver.hpp"
+#include "FileWatcher.hpp"
+#include "JSONLinesReporter.hpp"
 #include "JUnitXMLWriter.hpp"
+#include "SummaryProgressObserver.hpp"
+#include "TAPReporter.hpp"
+#include "TestException.hpp"
+#include "TestFileDependencies.hpp"
 #include "TestProgressObserver.hpp"
+#include "TestRegistry.hpp"
+#include "TestResultSummary.hpp"
+#include "TestServer.hpp"
+#include "TestTraversal.hpp"
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/filesystem.hpp>
+#include <Ishiko/BasePlatform.hpp>
 #include <Ishiko/Errors.hpp>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <limits>
 #include <memory>
+#include <vector>
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+#include <unistd.h>
+#endif
 
 using namespace Ishiko;
 
+namespace
+{
+
+void OpenReportFile(const boost::filesystem::path& path, std::ios::openmode mode, const char* description,
+    std::ofstream& stream)
+{
+    if (path.has_parent_path())
+    {
+        boost::filesystem::create_directories(path.parent_path());
+    }
+    stream.open(path.string(), std::ios::out | mode);
+    if (!stream)
+    {
+        throw TestException(std::string("Failed to create ") + description + " " + path.string());
+    }
+}
+
+// Parses a non-negative number, returns false if the value has anything other than digits or doesn't fit in a size_t
+bool ParseCount(const std::string& value, size_t& count)
+{
+    if (value.empty())
+    {
+        return false;
+    }
+    size_t result = 0;
+    for (char c : value)
+    {
+        if ((c < '0') || (c > '9'))
+        {
+            return false;
+        }
+        size_t digit = (c - '0');
+        if (result > ((std::numeric_limits<size_t>::max() - digit) / 10))
+        {
+            return false;
+        }
+        result = ((result * 10) + digit);
+    }
+    count = result;
+    return true;
+}
+
+// How long the files must stay unchanged before the tests are run again in watch mode. Builds and editors often
+// write several files, or the same file several times, in quick succession.
+const std::chrono::milliseconds watchQuietPeriod(200);
+
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+boost::filesystem::path GetExecutablePath()
+{
+    boost::system::error_code ec;
+    return boost::filesystem::read_symlink("/proc/self/exe", ec);
+}
+
+// Replaces this process with a new one running the executable with the same arguments. Only returns if that failed.
+void Restart(const boost::filesystem::path& executablePath)
+{
+    std::vector<std::string> arguments;
+    std::ifstream commandLine("/proc/self/cmdline", std::ios::binary);
+    std::string argument;
+    while (std::getline(commandLine, argument, '\0'))
+    {
+        arguments.push_back(argument);
+    }
+    std::vector<char*> argv;
+    for (std::string& argument : arguments)
+    {
+        argv.push_back(&argument[0]);
+    }
+    argv.push_back(nullptr);
+
+    std::cout.flush();
+    execv(executablePath.c_str(), argv.data());
+}
+#endif
+
+}
+
 TestHarness::CommandLineSpecification::CommandLineSpecification()
 {
     addNamedOption("context.data", {Ishiko::CommandLineSpecification::OptionType::single_value});
@@ -21,6 +118,18 @@ TestHarness::CommandLineSpecification::CommandLineSpecification()
     addNamedOption("context.application-path", {Ishiko::CommandLineSpecification::OptionType::single_value});
     addNamedOption("persistent-storage", {Ishiko::CommandLineSpecification::OptionType::single_value});
     addNamedOption("junit-xml-test-report", {Ishiko::CommandLineSpecification::OptionType::single_value});
+    addNamedOption("binary-result-log", {Ishiko::CommandLineSpecification::OptionType::single_value});
+    addNamedOption("json-lines-report", {Ishiko::CommandLineSpecification::OptionType::single_value});
+    addNamedOption("tap-report", {Ishiko::CommandLineSpecification::OptionType::single_value});
+    addNamedOption("console-output", {Ishiko::CommandLineSpecification::OptionType::single_value});
+    addNamedOption("list-tests", {Ishiko::CommandLineSpecification::OptionType::toggle});
+    addNamedOption("watch", {Ishiko::CommandLineSpecification::OptionType::toggle});
+    addNamedOption("server", {Ishiko::CommandLineSpecification::OptionType::single_value});
+    addNamedOption("child-process-pool-size", {Ishiko::CommandLineSpecification::OptionType::single_value});
+    addNamedOption("background-deleter-thread-count",
+        {Ishiko::CommandLineSpecification::OptionType::single_value});
+    addNamedOption("memory-backed-output", {Ishiko::CommandLineSpecification::OptionType::single_value});
+    addNamedOption("isolated-output-directories", {Ishiko::CommandLineSpecification::OptionType::single_value});
 }
 
 TestHarness::Configuration::Configuration(const Ishiko::Configuration& configuration)
@@ -97,6 +206,152 @@ TestHarness::Configuration::Configuration(const Ishiko::Configuration& configura
             // TODO: error
         }
     }
+    const Ishiko::Configuration::Value* binaryResultLog = configuration.valueOrNull("binary-result-log");
+    if (binaryResultLog)
+    {
+        if (binaryResultLog->type() == Ishiko::Configuration::Value::Type::string)
+        {
+            m_binaryResultLog = binaryResultLog->asString();
+        }
+        else
+        {
+            // TODO: error
+        }
+    }
+    const Ishiko::Configuration::Value* jsonLinesReport = configuration.valueOrNull("json-lines-report");
+    if (jsonLinesReport)
+    {
+        if (jsonLinesReport->type() == Ishiko::Configuration::Value::Type::string)
+        {
+            m_jsonLinesReport = jsonLinesReport->asString();
+        }
+        else
+        {
+            // TODO: error
+        }
+    }
+    const Ishiko::Configuration::Value* tapReport = configuration.valueOrNull("tap-report");
+    if (tapReport)
+    {
+        if (tapReport->type() == Ishiko::Configuration::Value::Type::string)
+        {
+            m_tapReport = tapReport->asString();
+        }
+        else
+        {
+            // TODO: error
+        }
+    }
+    const Ishiko::Configuration::Value* consoleOutput = configuration.valueOrNull("console-output");
+    if (consoleOutput)
+    {
+        if (consoleOutput->type() == Ishiko::Configuration::Value::Type::string)
+        {
+            m_summaryConsoleOutput = (consoleOutput->asString() == "summary");
+        }
+        else
+        {
+            // TODO: error
+        }
+    }
+    const Ishiko::Configuration::Value* listTests = configuration.valueOrNull("list-tests");
+    if (listTests)
+    {
+        if (listTests->type() == Ishiko::Configuration::Value::Type::string)
+        {
+            m_listTests = (listTests->asString() == "true");
+        }
+        else
+        {
+            // TODO: error
+        }
+    }
+    const Ishiko::Configuration::Value* watch = configuration.valueOrNull("watch");
+    if (watch)
+    {
+        if (watch->type() == Ishiko::Configuration::Value::Type::string)
+        {
+            m_watch = (watch->asString() == "true");
+        }
+        else
+        {
+            // TODO: error
+        }
+    }
+    const Ishiko::Configuration::Value* serverSocketPath = configuration.valueOrNull("server");
+    if (serverSocketPath)
+    {
+        if (serverSocketPath->type() == Ishiko::Configuration::Value::Type::string)
+        {
+            m_serverSocketPath = serverSocketPath->asString();
+        }
+        else
+        {
+            // TODO: error
+        }
+    }
+    const Ishiko::Configuration::Value* childProcessPoolSize = configuration.valueOrNull("child-process-pool-size");
+    if (childProcessPoolSize)
+    {
+        size_t size;
+        if ((childProcessPoolSize->type() == Ishiko::Configuration::Value::Type::string)
+            && ParseCount(childProcessPoolSize->asString(), size))
+        {
+            m_childProcessPoolSize = size;
+        }
+        else if (!m_error)
+        {
+            m_error = "Invalid value for child-process-pool-size, a number was expected";
+        }
+        else
+        {
+            // TODO: error
+        }
+    }
+    const Ishiko::Configuration::Value* backgroundDeleterThreadCount =
+        configuration.valueOrNull("background-deleter-thread-count");
+    if (backgroundDeleterThreadCount)
+    {
+        size_t count;
+        if ((backgroundDeleterThreadCount->type() == Ishiko::Configuration::Value::Type::string)
+            && ParseCount(backgroundDeleterThreadCount->asString(), count))
+        {
+            m_backgroundDeleterThreadCount = count;
+        }
+        else if (!m_error)
+        {
+            m_error = "Invalid value for background-deleter-thread-count, a number was expected";
+        }
+        else
+        {
+            // TODO: error
+        }
+    }
+    const Ishiko::Configuration::Value* memoryBackedOutputRoot = configuration.valueOrNull("memory-backed-output");
+    if (memoryBackedOutputRoot)
+    {
+        if (memoryBackedOutputRoot->type() == Ishiko::Configuration::Value::Type::string)
+        {
+            m_memoryBackedOutputRoot = memoryBackedOutputRoot->asString();
+        }
+        else
+        {
+            // TODO: error
+        }
+    }
+    const Ishiko::Configuration::Value* isolatedOutputDirectories =
+        configuration.valueOrNull("isolated-output-directories");
+    if (isolatedOutputDirectories)
+    {
+        if (isolatedOutputDirectories->type() == Ishiko::Configuration::Value::Type::string)
+        {
+            m_isolatedOutputDirectories = (isolatedOutputDirectories->asString() == "true");
+        }
+        else
+        {
+            // TODO: error
+        }
+    }
 }
 
 const boost::optional<std::string>& TestHarness::Configuration::contextData() const
@@ -129,16 +384,85 @@ const boost::optional<std::string>& TestHarness::Configuration::junitXMLTestRepo
     return m_junitXMLTestReport;
 }
 
+const boost::optional<std::string>& TestHarness::Configuration::binaryResultLog() const
+{
+    return m_binaryResultLog;
+}
+
+const boost::optional<std::string>& TestHarness::Configuration::jsonLinesReport() const
+{
+    return m_jsonLinesReport;
+}
+
+const boost::optional<std::string>& TestHarness::Configuration::tapReport() const
+{
+    return m_tapReport;
+}
+
+const boost::optional<bool>& TestHarness::Configuration::summaryConsoleOutput() const
+{
+    return m_summaryConsoleOutput;
+}
+
+const boost::optional<bool>& TestHarness::Configuration::listTests() const
+{
+    return m_listTests;
+}
+
+const boost::optional<bool>& TestHarness::Configuration::watch() const
+{
+    return m_watch;
+}
+
+const boost::optional<std::string>& TestHarness::Configuration::serverSocketPath() const
+{
+    return m_serverSocketPath;
+}
+
+const boost::optional<std::string>& TestHarness::Configuration::error() const
+{
+    return m_error;
+}
+
+const boost::optional<size_t>& TestHarness::Configuration::childProcessPoolSize() const
+{
+    return m_childProcessPoolSize;
+}
+
+const boost::optional<size_t>& TestHarness::Configuration::backgroundDeleterThreadCount() const
+{
+    return m_backgroundDeleterThreadCount;
+}
+
+const boost::optional<std::string>& TestHarness::Configuration::memoryBackedOutputRoot() const
+{
+    return m_memoryBackedOutputRoot;
+}
+
+const boost::optional<bool>& TestHarness::Configuration::isolatedOutputDirectories() const
+{
+    return m_isolatedOutputDirectories;
+}
+
 TestHarness::TestHarness(const std::string& title)
-    : m_context(TestContext::DefaultTestContext()), m_topSequence(title, m_context),
+    : m_summaryConsoleOutput(false), m_listTests(false), m_watch(false), m_context(TestContext::DefaultTestContext()),
+    m_topSequence(title, m_context), m_testRegistry(nullptr), m_appendedTestRegistry(nullptr),
     m_timestampOutputDirectory(true)
 {
+    m_context.setSharedFixtureRegistry(std::make_shared<SharedFixtureRegistry>());
 }
 
 TestHarness::TestHarness(const std::string& title, const Configuration& configuration)
-    : m_junitXMLTestReport(configuration.junitXMLTestReport()), m_context(TestContext::DefaultTestContext()),
-    m_topSequence(title, m_context), m_timestampOutputDirectory(true)
+    : m_junitXMLTestReport(configuration.junitXMLTestReport()), m_binaryResultLog(configuration.binaryResultLog()),
+    m_jsonLinesReport(configuration.jsonLinesReport()), m_tapReport(configuration.tapReport()),
+    m_summaryConsoleOutput(configuration.summaryConsoleOutput().value_or(false)),
+    m_listTests(configuration.listTests().value_or(false)), m_watch(configuration.watch().value_or(false)),
+    m_serverSocketPath(configuration.serverSocketPath()), m_configurationError(configuration.error()),
+    m_context(TestContext::DefaultTestContext()), m_topSequence(title, m_context),
+    m_testRegistry(nullptr), m_appendedTestRegistry(nullptr), m_timestampOutputDirectory(true)
 {
+    m_context.setSharedFixtureRegistry(std::make_shared<SharedFixtureRegistry>());
+
     const boost::optional<std::string> contextDataPath = configuration.contextData();
     if (contextDataPath)
     {
@@ -164,18 +488,69 @@ TestHarness::TestHarness(const std::string& title, const Configuration& configur
     {
         m_context.setOutputDirectory("persistent-storage", *persistentStoragePath);
     }
+    const boost::optional<bool> isolatedOutputDirectories = configuration.isolatedOutputDirectories();
+    if (isolatedOutputDirectories)
+    {
+        m_context.setIsolatedOutputDirectories(*isolatedOutputDirectories);
+    }
+    const boost::optional<size_t> childProcessPoolSize = configuration.childProcessPoolSize();
+    if (childProcessPoolSize && (*childProcessPoolSize > 1))
+    {
+        m_context.setChildProcessPool(std::make_shared<ChildProcessPool>(*childProcessPoolSize));
+    }
+    const boost::optional<size_t> backgroundDeleterThreadCount = configuration.backgroundDeleterThreadCount();
+    if (backgroundDeleterThreadCount && (*backgroundDeleterThreadCount > 0))
+    {
+        m_context.setBackgroundDeleter(std::make_shared<BackgroundDeleter>(*backgroundDeleterThreadCount));
+    }
     if (m_context.getOutputDirectory() != "")
     {
         prepareOutputDirectory();
-    }
 
+        const boost::optional<std::string> memoryBackedOutputRoot = configuration.memoryBackedOutputRoot();
+        if (memoryBackedOutputRoot)
+        {
+            prepareMemoryBackedOutputDirectory(*memoryBackedOutputRoot);
+        }
+    }
 }
 
 int TestHarness::run()
 {
+    if (m_configurationError)
+    {
+        std::cout << *m_configurationError << std::endl;
+        return TestApplicationReturnCode::configurationProblem;
+    }
+
+    // run() may be called more than once, the registered tests must not be appended again
+    if (m_testRegistry && (m_testRegistry != m_appendedTestRegistry))
+    {
+        m_testRegistry->appendTo(m_topSequence);
+        m_appendedTestRegistry = m_testRegistry;
+    }
+
+    if (m_listTests)
+    {
+        listTests();
+        return TestApplicationReturnCode::ok;
+    }
+
     std::cout << "Test Suite: " << m_topSequence.name() << std::endl;
 
-    int result = runTests();
+    int result;
+    if (m_serverSocketPath)
+    {
+        result = serveTests(*m_serverSocketPath);
+    }
+    else if (m_watch)
+    {
+        result = watchTests();
+    }
+    else
+    {
+        result = runTests();
+    }
 
     return result;
 }
@@ -190,6 +565,11 @@ TestSequence& TestHarness::tests()
     return m_topSequence;
 }
 
+void TestHarness::setTestRegistry(const TestRegistry* registry)
+{
+    m_testRegistry = registry;
+}
+
 void TestHarness::prepareOutputDirectory()
 {
     if (m_timestampOutputDirectory)
@@ -207,19 +587,137 @@ void TestHarness::prepareOutputDirectory()
     }
 }
 
+void TestHarness::prepareMemoryBackedOutputDirectory(const boost::filesystem::path& root)
+{
+    std::shared_ptr<MemoryBackedOutputDirectory> directory = std::make_shared<MemoryBackedOutputDirectory>();
+    Error error;
+    directory->create(root, m_context.getOutputDirectory(), error);
+    if (error)
+    {
+        throw TestException("Failed to create memory-backed output directory under " + root.string());
+    }
+    m_context.setOutputDirectory(directory->path());
+    m_context.setMemoryBackedOutputDirectory(directory);
+}
+
+void TestHarness::copyOutMemoryBackedOutputDirectory()
+{
+    MemoryBackedOutputDirectory* directory = m_context.getMemoryBackedOutputDirectory();
+    if (directory)
+    {
+        if (directory->keptCount() > 0)
+        {
+            Error error;
+            std::vector<boost::filesystem::path> failedPaths = directory->copyOut(error);
+            if (error)
+            {
+                std::cout << "Failed to copy the output of failed checks to " << directory->diskPath().string()
+                    << ", the following paths couldn't be copied:" << std::endl;
+                for (const boost::filesystem::path& path : failedPaths)
+                {
+                    std::cout << "    " << path.string() << std::endl;
+                }
+            }
+            else
+            {
+                std::cout << "Output of failed checks copied to " << directory->diskPath().string() << std::endl;
+            }
+            std::cout << std::endl;
+        }
+        directory->remove();
+    }
+}
+
 int TestHarness::runTests()
 {
     try
     {
-        std::shared_ptr<TestProgressObserver> progressObserver = std::make_shared<TestProgressObserver>(std::cout);
+        std::shared_ptr<TestResultSummary::Observer> resultSummaryObserver =
+            std::make_shared<TestResultSummary::Observer>(m_resultSummary);
+        m_topSequence.observers().add(resultSummaryObserver);
+
+        std::shared_ptr<Test::Observer> progressObserver;
+        std::shared_ptr<SummaryProgressObserver> summaryProgressObserver;
+        if (m_summaryConsoleOutput)
+        {
+            size_t testCaseCount = 0;
+            TestTraversal::Leaves(m_topSequence,
+                [&testCaseCount](const Test& test) -> void
+                {
+                    ++testCaseCount;
+                });
+            summaryProgressObserver = std::make_shared<SummaryProgressObserver>(std::cout, testCaseCount);
+            progressObserver = summaryProgressObserver;
+        }
+        else
+        {
+            progressObserver = std::make_shared<TestProgressObserver>(std::cout);
+        }
         m_topSequence.observers().add(progressObserver);
 
+        std::ofstream binaryResultLogStream;
+        std::shared_ptr<BinaryResultLogObserver> binaryResultLogObserver;
+        if (m_binaryResultLog)
+        {
+            OpenReportFile(*m_binaryResultLog, std::ios::binary | std::ios::trunc, "binary result log",
+                binaryResultLogStream);
+            binaryResultLogObserver = std::make_shared<BinaryResultLogObserver>(binaryResultLogStream);
+            m_topSequence.observers().add(binaryResultLogObserver);
+        }
+
+        std::ofstream jsonLinesReportStream;
+        std::shared_ptr<JSONLinesReporter> jsonLinesReporter;
+        if (m_jsonLinesReport)
+        {
+            OpenReportFile(*m_jsonLinesReport, std::ios::trunc, "JSON Lines report", jsonLinesReportStream);
+            jsonLinesReporter = std::make_shared<JSONLinesReporter>(jsonLinesReportStream);
+            m_topSequence.observers().add(jsonLinesReporter);
+        }
+
+        std::ofstream tapReportStream;
+        std::shared_ptr<TAPReporter> tapReporter;
+        if (m_tapReport)
+        {
+            OpenReportFile(*m_tapReport, std::ios::trunc, "TAP report", tapReportStream);
+            tapReporter = std::make_shared<TAPReporter>(tapReportStream);
+            m_topSequence.observers().add(tapReporter);
+        }
+
         std::cout << std::endl;
         m_topSequence.run();
+        if (m_topSequence.size() == 0)
+        {
+            // Special case. The top sequence sends no events so if it is empty we add it as a single test case
+            // ourselves else this case would go unreported.
+            m_resultSummary.add(m_topSequence);
+        }
+        if (summaryProgressObserver)
+        {
+            summaryProgressObserver->endRun();
+        }
+        if (jsonLinesReporter)
+        {
+            jsonLinesReporter->endRun();
+        }
+        if (tapReporter)
+        {
+            tapReporter->endRun();
+        }
         std::cout << std::endl;
 
-        printDetailedResults();
-        printSummary();
+        // Tests that were not run, or that threw during their setup, leave their shared fixtures set up
+        m_context.getSharedFixtureRegistry()->teardownAll();
+
+        // Make sure nothing is left behind when we exit
+        BackgroundDeleter* backgroundDeleter = m_context.getBackgroundDeleter();
+        if (backgroundDeleter)
+        {
+            backgroundDeleter->drain();
+        }
+        copyOutMemoryBackedOutputDirectory();
+
+        printDetailedResults(m_resultSummary);
+        printSummary(m_resultSummary, (m_topSequence.passed() || m_topSequence.skipped()));
         if (m_junitXMLTestReport)
         {
             writeJUnitXMLTestReport(*m_junitXMLTestReport);
@@ -240,58 +738,225 @@ int TestHarness::runTests()
     }
 }
 
-void TestHarness::printDetailedResults()
+int TestHarness::watchTests()
+{
+    if (!FileWatcher::IsSupported())
+    {
+        std::cout << "Watch mode is not supported on this platform" << std::endl;
+        return TestApplicationReturnCode::configurationProblem;
+    }
+
+    std::shared_ptr<TestFileDependencies> fileDependencies = std::make_shared<TestFileDependencies>();
+    m_context.setFileDependencies(fileDependencies);
+    m_topSequence.observers().add(fileDependencies);
+
+    runTests();
+
+    FileWatcher watcher;
+    std::vector<boost::filesystem::path> directories = { m_context.getDataDirectory(),
+        m_context.getReferenceDirectory() };
+    for (const boost::filesystem::path& directory : directories)
+    {
+        if (!directory.empty() && boost::filesystem::is_directory(directory))
+        {
+            Error error;
+            watcher.addDirectory(directory, error);
+            if (error)
+            {
+                std::cout << "Failed to watch " << directory.string() << std::endl;
+            }
+        }
+    }
+    boost::filesystem::path executablePath;
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    executablePath = GetExecutablePath();
+    if (!executablePath.empty())
+    {
+        Error error;
+        watcher.addFile(executablePath, error);
+        if (error)
+        {
+            executablePath.clear();
+        }
+    }
+#endif
+
+    while (true)
+    {
+        std::cout << "Watching for changes..." << std::endl;
+
+        Error error;
+        std::vector<boost::filesystem::path> changedPaths = watcher.wait(watchQuietPeriod, error);
+        if (error)
+        {
+            std::cout << "Failed to watch for changes" << std::endl;
+            return TestApplicationReturnCode::exception;
+        }
+
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+        if (!executablePath.empty()
+            && (std::find(changedPaths.begin(), changedPaths.end(), executablePath) != changedPaths.end()))
+        {
+            std::cout << "Test executable changed, restarting" << std::endl << std::endl;
+            Restart(executablePath);
+            // The new executable may not be complete yet, in which case we will try again at the next change
+            std::cout << "Failed to restart " << executablePath.string() << std::endl;
+            continue;
+        }
+#endif
+
+        std::vector<Test*> tests = fileDependencies->findAffectedTests(changedPaths);
+        if (!tests.empty())
+        {
+            rerunTests(tests);
+        }
+    }
+}
+
+int TestHarness::serveTests(const std::string& socketPath)
+{
+    TestServer server(m_topSequence);
+    Error error;
+    server.start(socketPath, error);
+    if (error)
+    {
+        std::cout << "Failed to start the test server on " << socketPath << std::endl;
+        return TestApplicationReturnCode::configurationProblem;
+    }
+    std::cout << "Serving tests on " << socketPath << std::endl;
+
+    // The setup of the shared fixtures is only paid for by the first request that needs them
+    m_context.getSharedFixtureRegistry()->setKeptSetUp(true);
+    server.serve(error);
+    server.stop();
+
+    m_context.getSharedFixtureRegistry()->teardownAll();
+    BackgroundDeleter* backgroundDeleter = m_context.getBackgroundDeleter();
+    if (backgroundDeleter)
+    {
+        backgroundDeleter->drain();
+    }
+    copyOutMemoryBackedOutputDirectory();
+
+    if (error)
+    {
+        std::cout << "The test server failed" << std::endl;
+        return TestApplicationReturnCode::exception;
+    }
+    return TestApplicationReturnCode::ok;
+}
+
+void TestHarness::rerunTests(const std::vector<Test*>& tests)
 {
-    m_topSequence.traverse(
-        [](const Test& test) -> void
+    TestResultSummary resultSummary;
+    std::shared_ptr<TestResultSummary::Observer> resultSummaryObserver =
+        std::make_shared<TestResultSummary::Observer>(resultSummary);
+    m_topSequence.observers().add(resultSummaryObserver);
+
+    std::shared_ptr<Test::Observer> progressObserver;
+    std::shared_ptr<SummaryProgressObserver> summaryProgressObserver;
+    if (m_summaryConsoleOutput)
+    {
+        size_t testCaseCount = 0;
+        for (Test* test : tests)
+        {
+            TestTraversal::Leaves(*test,
+                [&testCaseCount](const Test& test) -> void
+                {
+                    ++testCaseCount;
+                });
+        }
+        summaryProgressObserver = std::make_shared<SummaryProgressObserver>(std::cout, testCaseCount);
+        progressObserver = summaryProgressObserver;
+    }
+    else
+    {
+        progressObserver = std::make_shared<TestProgressObserver>(std::cout);
+    }
+    m_topSequence.observers().add(progressObserver);
+
+    std::cout << std::endl;
+    bool passed = true;
+    for (Test* test : tests)
+    {
+        try
         {
-            if (!test.passed())
+            test->reset();
+            test->run();
+        }
+        catch (...)
+        {
+            // The test is reported as not passed below, we keep watching regardless
+        }
+        passed = (passed && (test->passed() || test->skipped()));
+    }
+    if (summaryProgressObserver)
+    {
+        summaryProgressObserver->endRun();
+    }
+    std::cout << std::endl;
+
+    m_topSequence.observers().remove(progressObserver);
+    m_topSequence.observers().remove(resultSummaryObserver);
+
+    m_context.getSharedFixtureRegistry()->teardownAll();
+    BackgroundDeleter* backgroundDeleter = m_context.getBackgroundDeleter();
+    if (backgroundDeleter)
+    {
+        backgroundDeleter->drain();
+    }
+
+    printDetailedResults(resultSummary);
+    printSummary(resultSummary, passed);
+    std::cout << std::endl;
+}
+
+void TestHarness::listTests()
+{
+    // The whole tree is listed in the same order as TestServer lists it, with the numbers the tests are run with
+    for (size_t i = 0; i < m_topSequence.childCount(); ++i)
+    {
+        TestTraversal::PreOrder(m_topSequence.child(i),
+            [](const Test& test)
             {
-                const TestSequence* sequence = dynamic_cast<const TestSequence*>(&test);
-                // Special case. If the sequence is empty we consider it to be a single unknown test case. If we didn't
-                // do that this case would go unreported.
-                if (!sequence || (sequence->size() == 0))
+                const TestNumber& number = test.number();
+                for (size_t j = 0; j < number.depth(); ++j)
                 {
-                    std::cout << test.name() << " " << ToString(test.result()) << std::endl;
+                    std::cout << number.part(j) << ".";
                 }
-            }
-        });
+                std::cout << " " << test.name() << "\n";
+            });
+    }
+    std::cout.flush();
 }
 
-void TestHarness::printSummary()
-{
-    size_t unknown = 0;
-    size_t passed = 0;
-    size_t passedButMemoryLeaks = 0;
-    size_t exception = 0;
-    size_t failed = 0;
-    size_t skipped = 0;
-    size_t total = 0;
-    m_topSequence.getPassRate(unknown, passed, passedButMemoryLeaks, exception, failed, skipped, total);
-    if (!m_topSequence.passed() && !m_topSequence.skipped())
-    {
-        std::cout << "Pass rate: " << std::fixed << std::setprecision(2) << (100 * (double)passed / (double)total)
-            << "% (" << unknown << " unknown, "
-            << passed << " passed, "
-            << passedButMemoryLeaks << " passed but with memory leaks, "
-            << exception << " threw exceptions, "
-            << failed << " failed, "
-            << skipped << " skipped, "
-            << total << " total)" << std::endl;
-        std::cout << std::endl;
+void TestHarness::printDetailedResults(const TestResultSummary& summary)
+{
+    for (const std::pair<std::string, TestResult>& test : summary.notPassed())
+    {
+        std::cout << test.first << " " << ToString(test.second) << std::endl;
+    }
+}
+
+void TestHarness::printSummary(const TestResultSummary& summary, bool passed)
+{
+    size_t total = summary.total();
+    double passRate = ((total == 0) ? 0 : (100 * (double)summary.passed() / (double)total));
+    std::cout << "Pass rate: " << std::fixed << std::setprecision(2) << passRate
+        << "% (" << summary.unknown() << " unknown, "
+        << summary.passed() << " passed, "
+        << summary.passedButMemoryLeaks() << " passed but with memory leaks, "
+        << summary.exception() << " threw exceptions, "
+        << summary.failed() << " failed, "
+        << summary.skipped() << " skipped, "
+        << total << " total)" << std::endl;
+    std::cout << std::endl;
+    if (!passed)
+    {
         std::cout << "Test Suite FAILED!!!" << std::endl;
     }
     else
     {
-        std::cout << "Pass rate: " << std::fixed << std::setprecision(2) << (100 * (double)passed / (double)total)
-            << "% (" << unknown << " unknown, "
-            << passed << " passed, "
-            << passedButMemoryLeaks << " passed but with memory leaks, "
-            << exception << " threw exceptions, "
-            << failed << " failed, "
-            << skipped << " skipped, "
-            << total << " total)" << std::endl;
-        std::cout << std::endl;
         std::cout << "Test Suite passed" << std::endl;
     }
 }
@@ -308,21 +973,12 @@ void TestHarness::writeJUnitXMLTestReport(const std::string& path)
         boost::filesystem::create_directories(reportPath.parent_path());
     }
 
-    size_t unknown = 0;
-    size_t passed = 0;
-    size_t passedButMemoryLeaks = 0;
-    size_t exception = 0;
-    size_t failed = 0;
-    size_t skipped = 0;
-    size_t total = 0;
-    m_topSequence.getPassRate(unknown, passed, passedButMemoryLeaks, exception, failed, skipped, total);
-
     JUnitXMLWriter writer;
     writer.create(reportPath, error);
     writer.writeTestSuitesStart();
-    writer.writeTestSuiteStart(total);
+    writer.writeTestSuiteStart(m_resultSummary.total());
 
-    m_topSequence.traverse(
+    TestTraversal::PreOrder(m_topSequence,
         [&writer](const Test& test)
         {
             test.addToJUnitXMLTestReport(writer);
@@ -5,69 +5,192 @@
 */
 
 #include "TestNumber.hpp"
+#include <boost/functional/hash.hpp>
+#include <algorithm>
 
 namespace Ishiko
 {
 
-TestNumber::TestNumber()
+const size_t TestNumber::inlineCapacity;
+
+TestNumber::TestNumber() noexcept
+    : m_depth(0), m_capacity(inlineCapacity)
 {
 }
 
-TestNumber::TestNumber(int major)
+TestNumber::TestNumber(int major) noexcept
+    : m_depth(1), m_capacity(inlineCapacity)
 {
-    m_number.push_back(major);
+    m_inlineParts[0] = major;
 }
 
-TestNumber::TestNumber(int major, int minor)
+TestNumber::TestNumber(int major, int minor) noexcept
+    : m_depth(2), m_capacity(inlineCapacity)
 {
-    m_number.push_back(major);
-    m_number.push_back(minor);
+    m_inlineParts[0] = major;
+    m_inlineParts[1] = minor;
 }
 
-size_t TestNumber::depth() const
+TestNumber::TestNumber(const int* parts, size_t depth)
+    : m_depth(0), m_capacity(inlineCapacity)
 {
-    return m_number.size();
+    reserve(depth);
+    std::copy(parts, parts + depth, this->parts());
+    m_depth = static_cast<uint32_t>(depth);
 }
 
-int TestNumber::part(size_t i) const
+TestNumber::TestNumber(const TestNumber& other)
+    : m_depth(0), m_capacity(inlineCapacity)
 {
-    return m_number[i];
+    reserve(other.m_depth);
+    std::copy(other.parts(), other.parts() + other.m_depth, parts());
+    m_depth = other.m_depth;
 }
 
-bool TestNumber::operator ==(const TestNumber& other) const
+TestNumber::TestNumber(TestNumber&& other) noexcept
+    : m_depth(other.m_depth), m_capacity(other.m_capacity)
 {
-    return (m_number == other.m_number);
+    if (other.isInline())
+    {
+        std::copy(other.m_inlineParts, other.m_inlineParts + m_depth, m_inlineParts);
+    }
+    else
+    {
+        m_heapParts = other.m_heapParts;
+        other.m_depth = 0;
+        other.m_capacity = inlineCapacity;
+    }
 }
 
-bool TestNumber::operator !=(const TestNumber& other) const
+TestNumber::~TestNumber()
 {
-    return (m_number != other.m_number);
+    if (!isInline())
+    {
+        delete[] m_heapParts;
+    }
 }
 
-TestNumber& TestNumber::operator ++()
+TestNumber& TestNumber::operator =(const TestNumber& other)
 {
-    if (!m_number.empty())
+    if (this != &other)
     {
-        ++m_number.back();
+        reserve(other.m_depth);
+        std::copy(other.parts(), other.parts() + other.m_depth, parts());
+        m_depth = other.m_depth;
     }
     return *this;
 }
 
-TestNumber TestNumber::operator ++(int)
+TestNumber& TestNumber::operator =(TestNumber&& other) noexcept
 {
-    TestNumber result(*this);
-    if (!m_number.empty())
+    if (this != &other)
     {
-        ++m_number.back();
+        if (other.isInline())
+        {
+            // Keep our own buffer if we have one, the parts fit in it
+            std::copy(other.m_inlineParts, other.m_inlineParts + other.m_depth, parts());
+            m_depth = other.m_depth;
+        }
+        else
+        {
+            if (!isInline())
+            {
+                delete[] m_heapParts;
+            }
+            m_heapParts = other.m_heapParts;
+            m_depth = other.m_depth;
+            m_capacity = other.m_capacity;
+            other.m_depth = 0;
+            other.m_capacity = inlineCapacity;
+        }
     }
+    return *this;
+}
+
+size_t TestNumber::depth() const noexcept
+{
+    return m_depth;
+}
+
+int TestNumber::part(size_t i) const noexcept
+{
+    return parts()[i];
+}
+
+bool TestNumber::operator ==(const TestNumber& other) const noexcept
+{
+    return ((m_depth == other.m_depth) && std::equal(parts(), parts() + m_depth, other.parts()));
+}
+
+bool TestNumber::operator !=(const TestNumber& other) const noexcept
+{
+    return !(*this == other);
+}
+
+bool TestNumber::operator <(const TestNumber& other) const noexcept
+{
+    return std::lexicographical_compare(parts(), parts() + m_depth, other.parts(), other.parts() + other.m_depth);
+}
+
+size_t TestNumber::hash() const noexcept
+{
+    return boost::hash_range(parts(), parts() + m_depth);
+}
+
+TestNumber& TestNumber::operator ++() noexcept
+{
+    if (m_depth != 0)
+    {
+        ++parts()[m_depth - 1];
+    }
+    return *this;
+}
+
+TestNumber TestNumber::operator ++(int)
+{
+    TestNumber result(*this);
+    ++(*this);
     return result;
 }
 
 TestNumber TestNumber::getDeeperNumber() const
 {
-    TestNumber result = *this;
-    result.m_number.push_back(1);
+    TestNumber result;
+    result.reserve(m_depth + 1);
+    std::copy(parts(), parts() + m_depth, result.parts());
+    result.parts()[m_depth] = 1;
+    result.m_depth = (m_depth + 1);
     return result;
 }
 
+const int* TestNumber::parts() const noexcept
+{
+    return (isInline() ? m_inlineParts : m_heapParts);
+}
+
+int* TestNumber::parts() noexcept
+{
+    return (isInline() ? m_inlineParts : m_heapParts);
+}
+
+bool TestNumber::isInline() const noexcept
+{
+    return (m_capacity == inlineCapacity);
+}
+
+void TestNumber::reserve(size_t capacity)
+{
+    if (capacity > m_capacity)
+    {
+        int* newParts = new int[capacity];
+        std::copy(parts(), parts() + m_depth, newParts);
+        if (!isInline())
+        {
+            delete[] m_heapParts;
+        }
+        m_heapParts = newParts;
+        m_capacity = (uint32_t)capacity;
+    }
+}
+
 }
@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "TestRegistry.hpp"
+#include <algorithm>
+#include <cstring>
+
+using namespace Ishiko;
+
+TestRegistry::Entry::Entry(TestRegistry& registry, const char* name, const char* file, int line,
+    Factory factory) noexcept
+    : m_name(name), m_file(file), m_line(line), m_factory(factory), m_function(nullptr), m_next(nullptr)
+{
+    registry.add(*this);
+}
+
+TestRegistry::Entry::Entry(TestRegistry& registry, const char* name, const char* file, int line,
+    void (*function)(Test& test)) noexcept
+    : m_name(name), m_file(file), m_line(line), m_factory(nullptr), m_function(function), m_next(nullptr)
+{
+    registry.add(*this);
+}
+
+const char* TestRegistry::Entry::name() const noexcept
+{
+    return m_name;
+}
+
+const char* TestRegistry::Entry::file() const noexcept
+{
+    return m_file;
+}
+
+int TestRegistry::Entry::line() const noexcept
+{
+    return m_line;
+}
+
+std::shared_ptr<Test> TestRegistry::Entry::createTest(const TestNumber& number, const TestContext& context) const
+{
+    if (m_factory)
+    {
+        return m_factory(*this, number, context);
+    }
+    else
+    {
+        return std::make_shared<Test>(number, m_name, m_function, context);
+    }
+}
+
+TestRegistry& TestRegistry::DefaultTestRegistry()
+{
+    // A function local static so that it is initialized before the first entry registers itself, whatever the order
+    // the static entries are initialized in
+    static TestRegistry registry;
+    return registry;
+}
+
+TestRegistry::TestRegistry() noexcept
+    : m_first(nullptr), m_last(nullptr), m_size(0)
+{
+}
+
+size_t TestRegistry::size() const noexcept
+{
+    return m_size;
+}
+
+std::vector<const TestRegistry::Entry*> TestRegistry::entries() const
+{
+    std::vector<const Entry*> result;
+    result.reserve(m_size);
+    for (const Entry* entry = m_first; entry; entry = entry->m_next)
+    {
+        result.push_back(entry);
+    }
+    std::stable_sort(result.begin(), result.end(),
+        [](const Entry* left, const Entry* right)
+        {
+            int comparison = strcmp(left->file(), right->file());
+            return ((comparison < 0) || ((comparison == 0) && (left->line() < right->line())));
+        });
+    return result;
+}
+
+void TestRegistry::appendTo(TestSequence& sequence) const
+{
+    for (const Entry* entry : entries())
+    {
+        // The test number is a dummy that will be replaced by the append function
+        sequence.append(entry->createTest(TestNumber(1), sequence.context()));
+    }
+}
+
+void TestRegistry::add(Entry& entry) noexcept
+{
+    if (m_last)
+    {
+        m_last->m_next = &entry;
+    }
+    else
+    {
+        m_first = &entry;
+    }
+    m_last = &entry;
+    ++m_size;
+}
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "TestReporter.hpp"
+
+using namespace Ishiko;
+
+void TestReporter::endRun()
+{
+    onRunCompleted();
+}
+
+void TestReporter::onLifecycleEvent(const Test& source, EventType type)
+{
+    switch (type)
+    {
+    case test_start:
+        if (!m_runningTests.empty())
+        {
+            m_runningTests.back().hasChildren = true;
+        }
+        m_runningTests.push_back(RunningTest{std::chrono::steady_clock::now(), false, {}});
+        break;
+
+    case test_end:
+        if (!m_runningTests.empty())
+        {
+            const RunningTest& test = m_runningTests.back();
+            if (!test.hasChildren)
+            {
+                onTestCaseCompleted(source, std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - test.start), test.failures);
+            }
+            m_runningTests.pop_back();
+        }
+        break;
+    }
+}
+
+void TestReporter::onCheckFailed(const Test& source, const std::string& message, const char* file, int line)
+{
+    if (!m_runningTests.empty())
+    {
+        m_runningTests.back().failures.push_back(Failure{message, file, line});
+    }
+}
+
+void TestReporter::onExceptionThrown(const Test& source, std::exception_ptr exception)
+{
+    if (!m_runningTests.empty())
+    {
+        std::string message;
+        if (exception)
+        {
+            try
+            {
+                std::rethrow_exception(exception);
+            }
+            catch (const std::exception& e)
+            {
+                message = (std::string("Exception thrown: ") + e.what());
+            }
+            catch (...)
+            {
+                message = "Exception not derived from std::exception thrown";
+            }
+        }
+        else
+        {
+            message = "Exception thrown but no exception information available";
+        }
+        m_runningTests.back().failures.push_back(Failure{message, "", 0});
+    }
+}
+
+void TestReporter::onRunCompleted()
+{
+}
@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "TestResultSummary.hpp"
+
+using namespace Ishiko;
+
+TestResultSummary::Observer::Observer(TestResultSummary& summary)
+    : m_summary(summary)
+{
+}
+
+void TestResultSummary::Observer::onLifecycleEvent(const Test& source, EventType type)
+{
+    switch (type)
+    {
+    case test_start:
+        if (!m_hasChildren.empty())
+        {
+            m_hasChildren.back() = true;
+        }
+        m_hasChildren.push_back(false);
+        break;
+
+    case test_end:
+        if (!m_hasChildren.empty())
+        {
+            if (!m_hasChildren.back())
+            {
+                m_summary.add(source);
+            }
+            m_hasChildren.pop_back();
+        }
+        break;
+    }
+}
+
+TestResultSummary::TestResultSummary()
+    : m_unknown(0), m_passed(0), m_passedButMemoryLeaks(0), m_exception(0), m_failed(0), m_skipped(0), m_total(0)
+{
+}
+
+void TestResultSummary::add(const Test& test)
+{
+    TestResult result = test.result();
+    switch (result)
+    {
+    case TestResult::unknown:
+        ++m_unknown;
+        break;
+
+    case TestResult::passed:
+        ++m_passed;
+        break;
+
+    case TestResult::passed_but_memory_leaks:
+        ++m_passedButMemoryLeaks;
+        break;
+
+    case TestResult::exception:
+        ++m_exception;
+        break;
+
+    case TestResult::failed:
+        ++m_failed;
+        break;
+
+    case TestResult::skipped:
+        ++m_skipped;
+        break;
+    }
+    ++m_total;
+
+    if (result != TestResult::passed)
+    {
+        std::lock_guard<std::mutex> lock(m_notPassedMutex);
+        m_notPassed.emplace_back(test.name(), result);
+    }
+}
+
+size_t TestResultSummary::unknown() const noexcept
+{
+    return m_unknown;
+}
+
+size_t TestResultSummary::passed() const noexcept
+{
+    return m_passed;
+}
+
+size_t TestResultSummary::passedButMemoryLeaks() const noexcept
+{
+    return m_passedButMemoryLeaks;
+}
+
+size_t TestResultSummary::exception() const noexcept
+{
+    return m_exception;
+}
+
+size_t TestResultSummary::failed() const noexcept
+{
+    return m_failed;
+}
+
+size_t TestResultSummary::skipped() const noexcept
+{
+    return m_skipped;
+}
+
+size_t TestResultSummary::total() const noexcept
+{
+    return m_total;
+}
+
+std::vector<std::pair<std::string, TestResult>> TestResultSummary::notPassed() const
+{
+    std::lock_guard<std::mutex> lock(m_notPassedMutex);
+    return m_notPassed;
+}
@@ -12,11 +12,13 @@ namespace Ishiko
 TestSequence::TestSequence(const TestNumber& number, const std::string& name)
     : Test(number, name), m_itemsObserver(std::make_shared<ItemsObserver>(*this))
 {
+    setChildren(&m_tests);
 }
 
 TestSequence::TestSequence(const TestNumber& number, const std::string& name, const TestContext& context)
     : Test(number, name, context), m_itemsObserver(std::make_shared<ItemsObserver>(*this))
 {
+    setChildren(&m_tests);
 }
 
 const Test& TestSequence::operator[](size_t pos) const
@@ -56,6 +58,15 @@ void TestSequence::setNumber(const TestNumber& number)
     }
 }
 
+void TestSequence::reset()
+{
+    Test::reset();
+    for (std::shared_ptr<Test>& test : m_tests)
+    {
+        test->reset();
+    }
+}
+
 void TestSequence::getPassRate(size_t& unknown, size_t& passed, size_t& passedButMemoryLeaks, size_t& exception,
     size_t& failed, size_t& skipped, size_t& total) const
 {
@@ -119,15 +130,37 @@ void TestSequence::addToJUnitXMLTestReport(JUnitXMLWriter& writer) const
     }
 }
 
+bool TestSequence::hasIsolatedOutputDirectory() const
+{
+    return false;
+}
+
 void TestSequence::doRun()
 {
     // By default the outcome is unknown
     TestResult result = TestResult::unknown;
 
+    ChildProcessPool* pool = context().getChildProcessPool();
+    size_t nextLaunch = 0;
     for (size_t i = 0; i < m_tests.size(); ++i)
     {
         Test& test = *m_tests[i];
-        
+
+        if (pool)
+        {
+            // Let the upcoming tests start their child processes so they run while we complete this one. We stop at
+            // the first test that can't be launched because later tests may depend on it having run. Tests whose
+            // setup depends on the tests before them, see Test::launch, are only run once we get to them.
+            while ((nextLaunch < m_tests.size()) && !pool->full() && m_tests[nextLaunch]->launch(*pool))
+            {
+                ++nextLaunch;
+            }
+            if (nextLaunch == i)
+            {
+                ++nextLaunch;
+            }
+        }
+
         test.run();
 
         // Update the result
@@ -0,0 +1,401 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "TestServer.hpp"
+#include "JSONLinesReporter.hpp"
+#include "TestFrameworkErrorCategory.hpp"
+#include "TestResultSummary.hpp"
+#include "TestTraversal.hpp"
+#include <cstring>
+#include <memory>
+#include <streambuf>
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace Ishiko;
+
+namespace
+{
+
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+bool SendAll(int socket, const char* data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t result = send(socket, data, size, MSG_NOSIGNAL);
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += result;
+        size -= result;
+    }
+    return true;
+}
+
+// A stream buffer that sends what is written to it to a socket at the end of each line so that the client sees each
+// result as soon as it is written.
+class LineBufferedSocketStreamBuffer : public std::streambuf
+{
+public:
+    LineBufferedSocketStreamBuffer(int socket);
+
+protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char* s, std::streamsize count) override;
+    int sync() override;
+
+private:
+    int m_socket;
+    std::string m_pending;
+};
+
+LineBufferedSocketStreamBuffer::LineBufferedSocketStreamBuffer(int socket)
+    : m_socket(socket)
+{
+}
+
+LineBufferedSocketStreamBuffer::int_type LineBufferedSocketStreamBuffer::overflow(int_type c)
+{
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        return ((sync() == 0) ? traits_type::not_eof(c) : traits_type::eof());
+    }
+    m_pending.push_back(traits_type::to_char_type(c));
+    if ((traits_type::to_char_type(c) == '\n') && (sync() != 0))
+    {
+        return traits_type::eof();
+    }
+    return c;
+}
+
+std::streamsize LineBufferedSocketStreamBuffer::xsputn(const char* s, std::streamsize count)
+{
+    m_pending.append(s, count);
+    if (memchr(s, '\n', count) && (sync() != 0))
+    {
+        return 0;
+    }
+    return count;
+}
+
+int LineBufferedSocketStreamBuffer::sync()
+{
+    bool sent = SendAll(m_socket, m_pending.data(), m_pending.size());
+    m_pending.clear();
+    return (sent ? 0 : -1);
+}
+
+// Reads the next line from the socket, without the end of line. Returns false if the client closed the connection.
+bool ReadLine(int socket, std::string& buffer, std::string& line)
+{
+    size_t end;
+    while ((end = buffer.find('\n')) == std::string::npos)
+    {
+        char data[4096];
+        ssize_t result = recv(socket, data, sizeof(data), 0);
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        else if (result == 0)
+        {
+            return false;
+        }
+        buffer.append(data, result);
+    }
+    line.assign(buffer, 0, end);
+    buffer.erase(0, end + 1);
+    if (!line.empty() && (line.back() == '\r'))
+    {
+        line.pop_back();
+    }
+    return true;
+}
+#endif
+
+// Parses a test number like 2.1, returns false if the filter is not a test number
+bool ParseTestNumber(const std::string& filter, TestNumber& number)
+{
+    std::vector<int> parts;
+    int part = -1;
+    for (char c : filter)
+    {
+        if ((c >= '0') && (c <= '9'))
+        {
+            part = ((part == -1) ? 0 : (part * 10)) + (c - '0');
+        }
+        else if ((c == '.') && (part != -1))
+        {
+            parts.push_back(part);
+            part = -1;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    if (part == -1)
+    {
+        return false;
+    }
+    parts.push_back(part);
+    number = TestNumber(parts.data(), parts.size());
+    return true;
+}
+
+void CollectMatchingTests(Test& test, const std::string& filter, const TestNumber* number, std::vector<Test*>& tests)
+{
+    for (size_t i = 0; i < test.childCount(); ++i)
+    {
+        Test& child = test.child(i);
+        if ((number && (child.number() == *number)) || (child.name() == filter))
+        {
+            tests.push_back(&child);
+        }
+        else
+        {
+            CollectMatchingTests(child, filter, number, tests);
+        }
+    }
+}
+
+}
+
+TestServer::TestServer(Test& tests)
+    : m_tests(tests), m_socket(-1)
+{
+}
+
+TestServer::~TestServer()
+{
+    stop();
+}
+
+bool TestServer::IsSupported() noexcept
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::vector<Test*> TestServer::FindTests(Test& tests, const std::string& filter)
+{
+    std::vector<Test*> result;
+    if (filter.empty())
+    {
+        for (size_t i = 0; i < tests.childCount(); ++i)
+        {
+            result.push_back(&tests.child(i));
+        }
+    }
+    else
+    {
+        TestNumber number;
+        bool isNumber = ParseTestNumber(filter, number);
+        CollectMatchingTests(tests, filter, (isNumber ? &number : nullptr), result);
+    }
+    return result;
+}
+
+void TestServer::start(const boost::filesystem::path& socketPath, Error& error)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    stop();
+
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.native().size() >= sizeof(address.sun_path))
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return;
+    }
+    strcpy(address.sun_path, socketPath.c_str());
+
+    // Only a socket left behind by a previous server is replaced, anything else at that path is most likely a mistake
+    // in the path and mustn't be deleted
+    struct stat status;
+    if (lstat(address.sun_path, &status) == 0)
+    {
+        if (!S_ISSOCK(status.st_mode) || (unlink(address.sun_path) != 0))
+        {
+            Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+            return;
+        }
+    }
+    else if (errno != ENOENT)
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return;
+    }
+
+    m_socket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_socket == -1)
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return;
+    }
+    if ((bind(m_socket, (const sockaddr*)&address, sizeof(address)) != 0) || (listen(m_socket, 16) != 0))
+    {
+        close(m_socket);
+        m_socket = -1;
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return;
+    }
+    m_socketPath = socketPath;
+#else
+    Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+#endif
+}
+
+void TestServer::serve(Error& error)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    if (m_socket == -1)
+    {
+        Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+        return;
+    }
+
+    bool shutdown = false;
+    while (!shutdown)
+    {
+        int client = accept4(m_socket, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client == -1)
+        {
+            if ((errno == EINTR) || (errno == ECONNABORTED))
+            {
+                continue;
+            }
+            Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+            return;
+        }
+        shutdown = serveClient(client);
+        close(client);
+    }
+#else
+    Fail(TestFrameworkErrorCategory::Value::generic_error, error);
+#endif
+}
+
+void TestServer::stop()
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    if (m_socket != -1)
+    {
+        close(m_socket);
+        m_socket = -1;
+        unlink(m_socketPath.c_str());
+        m_socketPath.clear();
+    }
+#endif
+}
+
+bool TestServer::isRunning() const noexcept
+{
+    return (m_socket != -1);
+}
+
+bool TestServer::serveClient(int socket)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    LineBufferedSocketStreamBuffer outputBuffer(socket);
+    std::ostream output(&outputBuffer);
+
+    std::string buffer;
+    std::string request;
+    while (ReadLine(socket, buffer, request))
+    {
+        if (request == "shutdown")
+        {
+            output << "{\"done\":true}\n";
+            return true;
+        }
+        else if (request == "list")
+        {
+            listTests(output);
+        }
+        else if (request == "run")
+        {
+            runTests("", output);
+        }
+        else if (request.compare(0, 4, "run ") == 0)
+        {
+            runTests(request.substr(4), output);
+        }
+        else
+        {
+            output << "{\"done\":true,\"error\":";
+            JSONLinesReporter::WriteString(output, "unknown request: " + request);
+            output << "}\n";
+        }
+    }
+#endif
+    return false;
+}
+
+void TestServer::runTests(const std::string& filter, std::ostream& output)
+{
+    TestResultSummary resultSummary;
+    std::shared_ptr<TestResultSummary::Observer> resultSummaryObserver =
+        std::make_shared<TestResultSummary::Observer>(resultSummary);
+    m_tests.observers().add(resultSummaryObserver);
+    std::shared_ptr<JSONLinesReporter> reporter = std::make_shared<JSONLinesReporter>(output);
+    m_tests.observers().add(reporter);
+
+    for (Test* test : FindTests(m_tests, filter))
+    {
+        try
+        {
+            test->reset();
+            test->run();
+        }
+        catch (...)
+        {
+            // The test is reported as not passed, we carry on with the others
+        }
+    }
+    reporter->endRun();
+
+    m_tests.observers().remove(reporter);
+    m_tests.observers().remove(resultSummaryObserver);
+
+    output << "{\"done\":true,\"total\":" << resultSummary.total()
+        << ",\"passed\":" << (resultSummary.passed() + resultSummary.passedButMemoryLeaks())
+        << ",\"failed\":" << (resultSummary.failed() + resultSummary.unknown())
+        << ",\"exception\":" << resultSummary.exception()
+        << ",\"skipped\":" << resultSummary.skipped() << "}\n";
+}
+
+void TestServer::listTests(std::ostream& output)
+{
+    for (size_t i = 0; i < m_tests.childCount(); ++i)
+    {
+        TestTraversal::PreOrder(m_tests.child(i),
+            [&output](const Test& test)
+            {
+                output << "{\"number\":";
+                JSONLinesReporter::WriteNumber(output, test.number());
+                output << ",\"name\":";
+                JSONLinesReporter::WriteString(output, test.name());
+                output << "}\n";
+            });
+    }
+    output << "{\"done\":true}\n";
+}
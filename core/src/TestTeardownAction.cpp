@@ -22,4 +22,9 @@ void TestTeardownAction::teardown()
     // Default implementation does nothing
 }
 
+void TestTeardownAction::teardown(const Test& test)
+{
+    teardown();
+}
+
 }
@@ -20,9 +20,13 @@
     IN THE SOFTWARE.
 */
 
+#include <Ishiko/TestFramework/Core/ForkServerChild.hpp>
 #include <cstdlib>
 
-int main(int argc, char* argv[])
+namespace
+{
+
+int HelperMain(int argc, char* argv[])
 {
     int exitCode = 0;
 
@@ -33,3 +37,11 @@ int main(int argc, char* argv[])
 
     return exitCode;
 }
+
+}
+
+int main(int argc, char* argv[])
+{
+    // The tests can start this helper with a ForkServer and fork it from there instead of starting it with exec
+    return Ishiko::ForkServerChild::RunIfRequested(argc, argv, HelperMain);
+}
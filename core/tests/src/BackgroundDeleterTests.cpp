@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "BackgroundDeleterTests.hpp"
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+using namespace Ishiko;
+
+BackgroundDeleterTests::BackgroundDeleterTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "BackgroundDeleter tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("remove test 1", RemoveTest1);
+    append<HeapAllocationErrorsTest>("removeAll test 1", RemoveAllTest1);
+}
+
+void BackgroundDeleterTests::ConstructorTest1(Test& test)
+{
+    BackgroundDeleter deleter(2);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(deleter.threadCount(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(deleter.failureCount(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void BackgroundDeleterTests::RemoveTest1(Test& test)
+{
+    boost::filesystem::path filePath = test.context().getOutputPath("BackgroundDeleterTests_RemoveTest1.txt");
+    boost::filesystem::create_directories(filePath.parent_path());
+    std::ofstream(filePath.string()) << "Hello";
+
+    BackgroundDeleter deleter(2);
+    deleter.remove(filePath);
+    deleter.drain();
+
+    ISHIKO_TEST_FAIL_IF(boost::filesystem::exists(filePath));
+    ISHIKO_TEST_FAIL_IF_NEQ(deleter.failureCount(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void BackgroundDeleterTests::RemoveAllTest1(Test& test)
+{
+    boost::filesystem::path directoryPath = test.context().getOutputPath("BackgroundDeleterTests_RemoveAllTest1");
+    for (int i = 0; i < 4; ++i)
+    {
+        boost::filesystem::path subdirectoryPath = directoryPath / std::to_string(i) / "nested";
+        boost::filesystem::create_directories(subdirectoryPath);
+        std::ofstream((subdirectoryPath.parent_path() / "file.txt").string()) << "Hello";
+        std::ofstream((subdirectoryPath / "file.txt").string()) << "Hello";
+    }
+
+    BackgroundDeleter deleter(2);
+    deleter.removeAll(directoryPath);
+    deleter.drain();
+
+    ISHIKO_TEST_FAIL_IF(boost::filesystem::exists(directoryPath));
+    ISHIKO_TEST_FAIL_IF_NEQ(deleter.failureCount(), 0);
+    ISHIKO_TEST_PASS();
+}
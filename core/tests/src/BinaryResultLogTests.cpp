@@ -0,0 +1,168 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "BinaryResultLogTests.hpp"
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace Ishiko;
+
+namespace
+{
+
+// Runs a sequence with a passing and a failing test, recording the log and the console output
+void RunSequence(std::string& log, std::string& consoleText)
+{
+    std::stringstream logStream;
+    std::stringstream consoleStream;
+    {
+        TestSequence sequence(TestNumber(1), "Sequence");
+        sequence.append<Test>("Passing test",
+            [](Test& test)
+            {
+                ISHIKO_TEST_PASS();
+            });
+        sequence.append<Test>("Failing test",
+            [](Test& test)
+            {
+                ISHIKO_TEST_FAIL_IF_NEQ(1, 2);
+            });
+        std::shared_ptr<BinaryResultLogObserver> logObserver = std::make_shared<BinaryResultLogObserver>(logStream);
+        sequence.observers().add(logObserver);
+        std::shared_ptr<TestProgressObserver> progressObserver =
+            std::make_shared<TestProgressObserver>(consoleStream);
+        sequence.observers().add(progressObserver);
+
+        sequence.run();
+    }
+    log = logStream.str();
+    consoleText = consoleStream.str();
+}
+
+}
+
+BinaryResultLogTests::BinaryResultLogTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "BinaryResultLog tests", context)
+{
+    append<HeapAllocationErrorsTest>("read test 1", ReadTest1);
+    append<HeapAllocationErrorsTest>("read test 2", ReadTest2);
+    append<HeapAllocationErrorsTest>("read test 3", ReadTest3);
+    append<HeapAllocationErrorsTest>("ToConsoleText test 1", ToConsoleTextTest1);
+    append<HeapAllocationErrorsTest>("ToJSON test 1", ToJSONTest1);
+}
+
+void BinaryResultLogTests::ReadTest1(Test& test)
+{
+    std::string log;
+    std::string consoleText;
+    RunSequence(log, consoleText);
+
+    std::stringstream logStream(log);
+    BinaryResultLogReader reader(logStream);
+    BinaryResultLogReader::Record record;
+    Error error;
+
+    ISHIKO_TEST_ABORT_IF_NOT(reader.read(record, error));
+    ISHIKO_TEST_FAIL_IF(record.type != BinaryResultLogReader::RecordType::test_start);
+    ISHIKO_TEST_FAIL_IF_NEQ(record.number, TestNumber(1));
+    ISHIKO_TEST_FAIL_IF_NEQ(record.name, "Sequence");
+    ISHIKO_TEST_ABORT_IF_NOT(reader.read(record, error));
+    ISHIKO_TEST_FAIL_IF(record.type != BinaryResultLogReader::RecordType::test_start);
+    ISHIKO_TEST_FAIL_IF_NEQ(record.number, TestNumber(1, 1));
+    ISHIKO_TEST_FAIL_IF_NEQ(record.name, "Passing test");
+    ISHIKO_TEST_ABORT_IF_NOT(reader.read(record, error));
+    ISHIKO_TEST_FAIL_IF(record.type != BinaryResultLogReader::RecordType::test_end);
+    ISHIKO_TEST_FAIL_IF_NEQ(record.result, TestResult::passed);
+    ISHIKO_TEST_ABORT_IF_NOT(reader.read(record, error));
+    ISHIKO_TEST_FAIL_IF(record.type != BinaryResultLogReader::RecordType::test_start);
+    ISHIKO_TEST_FAIL_IF_NEQ(record.number, TestNumber(1, 2));
+    ISHIKO_TEST_ABORT_IF_NOT(reader.read(record, error));
+    ISHIKO_TEST_FAIL_IF(record.type != BinaryResultLogReader::RecordType::check_failed);
+    ISHIKO_TEST_FAIL_IF_EQ(record.message.find("ISHIKO_TEST_FAIL_IF_NEQ(1, 2)"), std::string::npos);
+    ISHIKO_TEST_FAIL_IF(record.line == 0);
+    ISHIKO_TEST_ABORT_IF_NOT(reader.read(record, error));
+    ISHIKO_TEST_FAIL_IF(record.type != BinaryResultLogReader::RecordType::test_end);
+    ISHIKO_TEST_FAIL_IF_NEQ(record.result, TestResult::failed);
+    ISHIKO_TEST_ABORT_IF_NOT(reader.read(record, error));
+    ISHIKO_TEST_FAIL_IF(record.type != BinaryResultLogReader::RecordType::test_end);
+    ISHIKO_TEST_FAIL_IF_NEQ(record.number, TestNumber(1));
+    ISHIKO_TEST_FAIL_IF_NEQ(record.result, TestResult::failed);
+    ISHIKO_TEST_FAIL_IF(reader.read(record, error));
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryResultLogTests::ReadTest2(Test& test)
+{
+    // A log cut short by a crash is read up to its last complete record
+    std::string log;
+    std::string consoleText;
+    RunSequence(log, consoleText);
+    log.resize(log.size() - 3);
+
+    std::stringstream logStream(log);
+    BinaryResultLogReader reader(logStream);
+    BinaryResultLogReader::Record record;
+    Error error;
+    size_t count = 0;
+    while (reader.read(record, error))
+    {
+        ++count;
+    }
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(count, 6);
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryResultLogTests::ReadTest3(Test& test)
+{
+    std::stringstream logStream("not a log");
+    BinaryResultLogReader reader(logStream);
+    BinaryResultLogReader::Record record;
+    Error error;
+
+    ISHIKO_TEST_FAIL_IF(reader.read(record, error));
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryResultLogTests::ToConsoleTextTest1(Test& test)
+{
+    std::string log;
+    std::string consoleText;
+    RunSequence(log, consoleText);
+
+    std::stringstream logStream(log);
+    std::stringstream output;
+    Error error;
+    BinaryResultLogConverter::ToConsoleText(logStream, output, error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(output.str(), consoleText);
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryResultLogTests::ToJSONTest1(Test& test)
+{
+    std::string log;
+    std::string consoleText;
+    RunSequence(log, consoleText);
+
+    std::stringstream logStream(log);
+    std::stringstream output;
+    Error error;
+    BinaryResultLogConverter::ToJSON(logStream, output, error);
+    std::string json = output.str();
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(json.find("[\n{\"number\":\"1.1\",\"name\":\"Passing test\",\"result\":\"passed\","), 0);
+    ISHIKO_TEST_FAIL_IF_EQ(json.find("{\"number\":\"1.2\",\"name\":\"Failing test\",\"result\":\"failed\","),
+        std::string::npos);
+    ISHIKO_TEST_FAIL_IF_EQ(json.find("\"failures\":[{\"message\":\"ISHIKO_TEST_FAIL_IF_NEQ(1, 2)"),
+        std::string::npos);
+    ISHIKO_TEST_FAIL_IF_EQ(json.find("{\"number\":\"1\",\"name\":\"Sequence\",\"result\":\"failed\",\"sequence\":true"),
+        std::string::npos);
+    ISHIKO_TEST_PASS();
+}
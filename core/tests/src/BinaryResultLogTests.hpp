@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_BINARYRESULTLOGTESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_BINARYRESULTLOGTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class BinaryResultLogTests : public Ishiko::TestSequence
+{
+public:
+    BinaryResultLogTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ReadTest1(Ishiko::Test& test);
+    static void ReadTest2(Ishiko::Test& test);
+    static void ReadTest3(Ishiko::Test& test);
+    static void ToConsoleTextTest1(Ishiko::Test& test);
+    static void ToJSONTest1(Ishiko::Test& test);
+};
+
+#endif
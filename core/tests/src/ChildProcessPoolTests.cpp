@@ -0,0 +1,168 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ChildProcessPoolTests.hpp"
+#include <boost/filesystem.hpp>
+#include <memory>
+
+using namespace Ishiko;
+
+namespace
+{
+
+class OutputCounter : public PipedChildProcess::Callbacks
+{
+public:
+    void onStandardOutput(const char* data, size_t size) override
+    {
+        m_count += size;
+    }
+
+    size_t m_count = 0;
+};
+
+// Records whether another test had completed when the setup ran
+class CompletionCheckSetupAction : public TestSetupAction
+{
+public:
+    explicit CompletionCheckSetupAction(const Test& previousTest)
+        : m_previousTest(previousTest)
+    {
+    }
+
+    void setup(const Test& test) override
+    {
+        m_previousTestCompleted = m_previousTest.passed();
+    }
+
+    const Test& m_previousTest;
+    bool m_previousTestCompleted = false;
+};
+
+}
+
+ChildProcessPoolTests::ChildProcessPoolTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "ChildProcessPool tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("waitForExit test 1", WaitForExitTest1);
+    append<HeapAllocationErrorsTest>("TestSequence test 1", TestSequenceTest1);
+    append<HeapAllocationErrorsTest>("TestSequence test 2", TestSequenceTest2);
+}
+
+void ChildProcessPoolTests::ConstructorTest1(Test& test)
+{
+    ChildProcessPool pool(4);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(pool.maxSize(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(pool.size(), 0);
+    ISHIKO_TEST_FAIL_IF(pool.full());
+    ISHIKO_TEST_PASS();
+}
+
+void ChildProcessPoolTests::WaitForExitTest1(Test& test)
+{
+    if (!PipedChildProcess::IsSupported())
+    {
+        ISHIKO_TEST_SKIP();
+    }
+
+#ifdef __linux__
+    boost::filesystem::path executablePath(test.context().getDataDirectory() / "bin/StandardOutputTestHelper");
+#else
+    boost::filesystem::path executablePath(test.context().getDataDirectory() / "bin/StandardOutputTestHelper.exe");
+#endif
+
+    ChildProcessPool pool(2);
+
+    OutputCounter callbacks1;
+    PipedChildProcess process1;
+    Error error;
+    process1.start(executablePath.string(), callbacks1, error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    pool.add(process1);
+
+    OutputCounter callbacks2;
+    PipedChildProcess process2;
+    process2.start(executablePath.string() + " Hello", callbacks2, error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    pool.add(process2);
+
+    ISHIKO_TEST_FAIL_IF_NOT(pool.full());
+
+    pool.waitForExit(process2);
+    pool.remove(process2);
+    pool.waitForExit(process1);
+    pool.remove(process1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(pool.size(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(process1.exitCode(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(process2.exitCode(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(callbacks1.m_count, 37);
+    ISHIKO_TEST_FAIL_IF_NEQ(callbacks2.m_count, 6);
+    ISHIKO_TEST_PASS();
+}
+
+void ChildProcessPoolTests::TestSequenceTest1(Test& test)
+{
+#ifdef __linux__
+    boost::filesystem::path executablePath(test.context().getDataDirectory() / "bin/StandardOutputTestHelper");
+#else
+    boost::filesystem::path executablePath(test.context().getDataDirectory() / "bin/StandardOutputTestHelper.exe");
+#endif
+    boost::filesystem::path referencePath(test.context().getReferenceDirectory()
+        / "ConsoleApplicationTestTests/ConsoleApplicationTestRunSuccessTest4.txt");
+
+    TestContext context(&test.context());
+    context.setChildProcessPool(std::make_shared<ChildProcessPool>(2));
+
+    TestSequence sequence(TestNumber(), "ChildProcessPoolTests_TestSequenceTest1", context);
+    for (int i = 0; i < 5; ++i)
+    {
+        ConsoleApplicationTest& applicationTest = sequence.append<ConsoleApplicationTest>(
+            "ChildProcessPoolTests_TestSequenceTest1_" + std::to_string(i), executablePath.string(), 0);
+        applicationTest.setStandardOutputReferenceFilePath(referencePath);
+        applicationTest.setInMemoryOutputCapture(1024);
+    }
+    sequence.run();
+
+    ISHIKO_TEST_FAIL_IF_NOT(sequence.passed());
+    ISHIKO_TEST_FAIL_IF_NEQ(context.getChildProcessPool()->size(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void ChildProcessPoolTests::TestSequenceTest2(Test& test)
+{
+#ifdef __linux__
+    boost::filesystem::path executablePath(test.context().getDataDirectory() / "bin/StandardOutputTestHelper");
+#else
+    boost::filesystem::path executablePath(test.context().getDataDirectory() / "bin/StandardOutputTestHelper.exe");
+#endif
+    boost::filesystem::path referencePath(test.context().getReferenceDirectory()
+        / "ConsoleApplicationTestTests/ConsoleApplicationTestRunSuccessTest4.txt");
+
+    TestContext context(&test.context());
+    context.setChildProcessPool(std::make_shared<ChildProcessPool>(2));
+
+    TestSequence sequence(TestNumber(), "ChildProcessPoolTests_TestSequenceTest2", context);
+    ConsoleApplicationTest& applicationTest1 = sequence.append<ConsoleApplicationTest>(
+        "ChildProcessPoolTests_TestSequenceTest2_1", executablePath.string(), 0);
+    applicationTest1.setStandardOutputReferenceFilePath(referencePath);
+    applicationTest1.setInMemoryOutputCapture(1024);
+    ConsoleApplicationTest& applicationTest2 = sequence.append<ConsoleApplicationTest>(
+        "ChildProcessPoolTests_TestSequenceTest2_2", executablePath.string(), 0);
+    applicationTest2.setStandardOutputReferenceFilePath(referencePath);
+    applicationTest2.setInMemoryOutputCapture(1024);
+    std::shared_ptr<CompletionCheckSetupAction> setupAction =
+        std::make_shared<CompletionCheckSetupAction>(applicationTest1);
+    applicationTest2.addSetupAction(setupAction);
+    sequence.run();
+
+    ISHIKO_TEST_FAIL_IF_NOT(sequence.passed());
+    ISHIKO_TEST_FAIL_IF_NOT(setupAction->m_previousTestCompleted);
+    ISHIKO_TEST_PASS();
+}
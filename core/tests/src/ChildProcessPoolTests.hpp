@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_CHILDPROCESSPOOLTESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_CHILDPROCESSPOOLTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class ChildProcessPoolTests : public Ishiko::TestSequence
+{
+public:
+    ChildProcessPoolTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void WaitForExitTest1(Ishiko::Test& test);
+    static void TestSequenceTest1(Ishiko::Test& test);
+    static void TestSequenceTest2(Ishiko::Test& test);
+};
+
+#endif
@@ -19,6 +19,15 @@ ConsoleApplicationTestTests::ConsoleApplicationTestTests(const TestNumber& numbe
     append<HeapAllocationErrorsTest>("run failure test 1", RunFailureTest1);
     append<HeapAllocationErrorsTest>("run success test 3", RunSuccessTest3);
     append<HeapAllocationErrorsTest>("run failure test 2", RunFailureTest2);
+    append<HeapAllocationErrorsTest>("run success test 4", RunSuccessTest4);
+    append<HeapAllocationErrorsTest>("run failure test 3", RunFailureTest3);
+    append<HeapAllocationErrorsTest>("run failure test 4", RunFailureTest4);
+    append<HeapAllocationErrorsTest>("resourceUsage test 1", ResourceUsageTest1);
+    append<HeapAllocationErrorsTest>("setResourceLimits test 1", ResourceLimitsTest1);
+    append<HeapAllocationErrorsTest>("setResourceLimits test 2", ResourceLimitsTest2);
+    append<HeapAllocationErrorsTest>("setResourceLimits test 3", ResourceLimitsTest3);
+    append<HeapAllocationErrorsTest>("setForkServer test 1", ForkServerTest1);
+    append<HeapAllocationErrorsTest>("setForkServer test 2", ForkServerTest2);
 }
 
 void ConsoleApplicationTestTests::CreationTest1(Test& test)
@@ -124,3 +133,202 @@ void ConsoleApplicationTestTests::RunFailureTest2(Test& test)
     ISHIKO_TEST_FAIL_IF(applicationTest.passed());
     ISHIKO_TEST_PASS();
 }
+
+void ConsoleApplicationTestTests::RunSuccessTest4(Test& test)
+{
+#ifdef __linux__
+    path executablePath(test.context().getDataDirectory() / "bin/StandardOutputTestHelper");
+#else
+    path executablePath(test.context().getDataDirectory() / "bin/StandardOutputTestHelper.exe");
+#endif
+    path referencePath(test.context().getReferenceDirectory()
+        / "ConsoleApplicationTestTests/ConsoleApplicationTestRunSuccessTest4.txt");
+
+    ConsoleApplicationTest applicationTest(TestNumber(), "ConsoleApplicationTestRunSuccessTest4",
+        executablePath.string().c_str(), 0);
+    applicationTest.setStandardOutputReferenceFilePath(referencePath);
+    applicationTest.setInMemoryOutputCapture(1024);
+    applicationTest.run();
+
+    ISHIKO_TEST_FAIL_IF_NOT(applicationTest.passed());
+    if (PipedChildProcess::IsSupported())
+    {
+        ISHIKO_TEST_FAIL_IF_NEQ(applicationTest.standardOutput().data(), "Message from StandardOuputTestHelper\n");
+    }
+    ISHIKO_TEST_PASS();
+}
+
+void ConsoleApplicationTestTests::RunFailureTest3(Test& test)
+{
+#ifdef __linux__
+    path executablePath(test.context().getDataDirectory() / "bin/StandardOutputTestHelper");
+#else
+    path executablePath(test.context().getDataDirectory() / "bin/StandardOutputTestHelper.exe");
+#endif
+    path referencePath(test.context().getReferenceDirectory()
+        / "ConsoleApplicationTestTests/ConsoleApplicationTestRunFailureTest3.txt");
+
+    ConsoleApplicationTest applicationTest(TestNumber(), "ConsoleApplicationTestRunFailureTest3",
+        executablePath.string().c_str(), 0);
+    applicationTest.setStandardOutputReferenceFilePath(referencePath);
+    applicationTest.setInMemoryOutputCapture(1024);
+    applicationTest.run();
+
+    ISHIKO_TEST_FAIL_IF(applicationTest.passed());
+    ISHIKO_TEST_PASS();
+}
+
+void ConsoleApplicationTestTests::RunFailureTest4(Test& test)
+{
+#ifdef __linux__
+    // The application never exits on its own so this test would hang if the application wasn't killed on the first
+    // mismatch
+    path referencePath(test.context().getDataPath("ComparisonTestFiles/NotHello.txt"));
+
+    ConsoleApplicationTest applicationTest(TestNumber(), "ConsoleApplicationTestRunFailureTest4",
+        "/bin/sh -c 'echo Hello; exec sleep 600'", 0);
+    applicationTest.setStandardOutputReferenceFilePath(referencePath);
+    applicationTest.setInMemoryOutputCapture(1024);
+    applicationTest.setAbortOnFirstMismatch(true);
+    applicationTest.run();
+
+    ISHIKO_TEST_FAIL_IF(applicationTest.passed());
+    ISHIKO_TEST_PASS();
+#else
+    ISHIKO_TEST_SKIP();
+#endif
+}
+
+void ConsoleApplicationTestTests::ResourceUsageTest1(Test& test)
+{
+#ifdef __linux__
+    path executablePath(test.context().getDataDirectory() / "bin/ExitCodeTestHelper");
+#else
+    path executablePath(test.context().getDataDirectory() / "bin/ExitCodeTestHelper.exe");
+#endif
+
+    ConsoleApplicationTest applicationTest(TestNumber(), "ConsoleApplicationTestResourceUsageTest1",
+        executablePath.string(), 0);
+    applicationTest.setInMemoryOutputCapture(1024);
+    applicationTest.run();
+
+    ISHIKO_TEST_FAIL_IF_NOT(applicationTest.passed());
+    ISHIKO_TEST_FAIL_IF_NOT(applicationTest.resourceUsage().wallTime.count() > 0);
+    ISHIKO_TEST_PASS();
+}
+
+void ConsoleApplicationTestTests::ResourceLimitsTest1(Test& test)
+{
+#ifdef __linux__
+    ChildProcessResourceLimits limits;
+    limits.wallTimeout = std::chrono::milliseconds(100);
+
+    ConsoleApplicationTest applicationTest(TestNumber(), "ConsoleApplicationTestResourceLimitsTest1",
+        "/bin/sh -c 'exec sleep 600'", 0);
+    applicationTest.setInMemoryOutputCapture(1024);
+    applicationTest.setResourceLimits(limits);
+    applicationTest.run();
+
+    ISHIKO_TEST_FAIL_IF(applicationTest.passed());
+    ISHIKO_TEST_FAIL_IF(applicationTest.resourceUsage().wallTime > std::chrono::seconds(60));
+    ISHIKO_TEST_PASS();
+#else
+    ISHIKO_TEST_SKIP();
+#endif
+}
+
+void ConsoleApplicationTestTests::ResourceLimitsTest2(Test& test)
+{
+#ifdef __linux__
+    ChildProcessResourceLimits limits;
+    limits.maxCPUTime = std::chrono::milliseconds(100);
+
+    // The application never exits on its own so this test would hang if the CPU limit wasn't applied
+    ConsoleApplicationTest applicationTest(TestNumber(), "ConsoleApplicationTestResourceLimitsTest2",
+        "/bin/sh -c 'while :; do :; done'", 0);
+    applicationTest.setInMemoryOutputCapture(1024);
+    applicationTest.setResourceLimits(limits);
+    applicationTest.run();
+
+    ISHIKO_TEST_FAIL_IF(applicationTest.passed());
+    ISHIKO_TEST_FAIL_IF((applicationTest.resourceUsage().userTime + applicationTest.resourceUsage().systemTime)
+        < limits.maxCPUTime);
+    ISHIKO_TEST_PASS();
+#else
+    ISHIKO_TEST_SKIP();
+#endif
+}
+
+void ConsoleApplicationTestTests::ResourceLimitsTest3(Test& test)
+{
+#ifdef __linux__
+    ChildProcessResourceLimits limits;
+    limits.maxMemorySize = 16 * 1024 * 1024;
+
+    // The shell tries to keep the 50 MB of output in memory, the limit is in place before it starts so the allocation
+    // fails and the shell exits with an error
+    ConsoleApplicationTest applicationTest(TestNumber(), "ConsoleApplicationTestResourceLimitsTest3",
+        "/bin/sh -c 'x=$(yes | head -c 50000000)'", 0);
+    applicationTest.setInMemoryOutputCapture(1024);
+    applicationTest.setResourceLimits(limits);
+    applicationTest.run();
+
+    ISHIKO_TEST_FAIL_IF(applicationTest.passed());
+    ISHIKO_TEST_FAIL_IF(applicationTest.resourceUsage().maxResidentSetSize > limits.maxMemorySize);
+    ISHIKO_TEST_PASS();
+#else
+    ISHIKO_TEST_SKIP();
+#endif
+}
+
+void ConsoleApplicationTestTests::ForkServerTest1(Test& test)
+{
+    if (!ForkServer::IsSupported())
+    {
+        ISHIKO_TEST_SKIP();
+    }
+
+    path executablePath(test.context().getDataDirectory() / "bin/StandardOutputTestHelper");
+
+    std::shared_ptr<ForkServer> server = std::make_shared<ForkServer>();
+    Error error;
+    server->start(executablePath, error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    ConsoleApplicationTest applicationTest(TestNumber(), "ConsoleApplicationTestForkServerTest1",
+        executablePath.string() + " Hello", 0);
+    applicationTest.setInMemoryOutputCapture(1024);
+    applicationTest.setForkServer(server);
+    applicationTest.run();
+
+    ISHIKO_TEST_FAIL_IF_NOT(applicationTest.passed());
+    ISHIKO_TEST_FAIL_IF_NEQ(applicationTest.standardOutput().data(), "Hello\n");
+    ISHIKO_TEST_PASS();
+}
+
+void ConsoleApplicationTestTests::ForkServerTest2(Test& test)
+{
+    if (!ForkServer::IsSupported())
+    {
+        ISHIKO_TEST_SKIP();
+    }
+
+    path executablePath(test.context().getDataDirectory() / "bin/ExitCodeTestHelper");
+
+    std::shared_ptr<ForkServer> server = std::make_shared<ForkServer>();
+    Error error;
+    server->start(executablePath, error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    ConsoleApplicationTest applicationTest(TestNumber(), "ConsoleApplicationTestForkServerTest2",
+        executablePath.string() + " 3", 3);
+    applicationTest.setInMemoryOutputCapture(1024);
+    applicationTest.setForkServer(server);
+    applicationTest.run();
+
+    ISHIKO_TEST_FAIL_IF_NOT(applicationTest.passed());
+    ISHIKO_TEST_FAIL_IF_NEQ(applicationTest.standardOutput().data(), "");
+    ISHIKO_TEST_PASS();
+}
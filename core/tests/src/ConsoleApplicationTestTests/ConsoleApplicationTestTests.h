@@ -21,6 +21,15 @@ private:
     static void RunFailureTest1(Ishiko::Test& test);
     static void RunSuccessTest3(Ishiko::Test& test);
     static void RunFailureTest2(Ishiko::Test& test);
+    static void RunSuccessTest4(Ishiko::Test& test);
+    static void RunFailureTest3(Ishiko::Test& test);
+    static void RunFailureTest4(Ishiko::Test& test);
+    static void ResourceUsageTest1(Ishiko::Test& test);
+    static void ResourceLimitsTest1(Ishiko::Test& test);
+    static void ResourceLimitsTest2(Ishiko::Test& test);
+    static void ResourceLimitsTest3(Ishiko::Test& test);
+    static void ForkServerTest1(Ishiko::Test& test);
+    static void ForkServerTest2(Ishiko::Test& test);
 };
 
 #endif
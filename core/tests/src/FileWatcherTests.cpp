@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "FileWatcherTests.hpp"
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <fstream>
+
+using namespace Ishiko;
+
+FileWatcherTests::FileWatcherTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "FileWatcher tests", context)
+{
+    append<HeapAllocationErrorsTest>("addDirectory test 1", AddDirectoryTest1);
+    append<HeapAllocationErrorsTest>("wait test 1", WaitTest1);
+    append<HeapAllocationErrorsTest>("wait test 2", WaitTest2);
+}
+
+void FileWatcherTests::AddDirectoryTest1(Test& test)
+{
+    FileWatcher watcher;
+
+    Error error;
+    watcher.addDirectory(test.context().getDataPath("DoesNotExist"), error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_PASS();
+}
+
+void FileWatcherTests::WaitTest1(Test& test)
+{
+    if (!FileWatcher::IsSupported())
+    {
+        ISHIKO_TEST_SKIP();
+    }
+
+    boost::filesystem::path directoryPath =
+        boost::filesystem::absolute(test.context().getOutputPath("FileWatcherTests_WaitTest1")).lexically_normal();
+    boost::filesystem::remove_all(directoryPath);
+    boost::filesystem::create_directories(directoryPath);
+
+    FileWatcher watcher;
+
+    Error error;
+    watcher.addDirectory(directoryPath, error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    // The events are queued so we don't need another thread to make the change while we wait
+    std::ofstream((directoryPath / "file.txt").string()) << "changed";
+    std::vector<boost::filesystem::path> changedPaths = watcher.wait(std::chrono::milliseconds(10), error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_ABORT_IF_NEQ(changedPaths.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(changedPaths[0], directoryPath / "file.txt");
+    ISHIKO_TEST_PASS();
+}
+
+void FileWatcherTests::WaitTest2(Test& test)
+{
+    if (!FileWatcher::IsSupported())
+    {
+        ISHIKO_TEST_SKIP();
+    }
+
+    boost::filesystem::path directoryPath =
+        boost::filesystem::absolute(test.context().getOutputPath("FileWatcherTests_WaitTest2")).lexically_normal();
+    boost::filesystem::remove_all(directoryPath);
+    boost::filesystem::create_directories(directoryPath);
+
+    FileWatcher watcher;
+
+    Error error;
+    watcher.addFile(directoryPath / "watched.txt", error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    std::ofstream((directoryPath / "ignored.txt").string()) << "changed";
+    std::ofstream((directoryPath / "watched.txt").string()) << "changed";
+    std::vector<boost::filesystem::path> changedPaths = watcher.wait(std::chrono::milliseconds(10), error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_ABORT_IF_NEQ(changedPaths.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(changedPaths[0], directoryPath / "watched.txt");
+    ISHIKO_TEST_PASS();
+}
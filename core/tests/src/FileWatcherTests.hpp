@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_FILEWATCHERTESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_FILEWATCHERTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class FileWatcherTests : public Ishiko::TestSequence
+{
+public:
+    FileWatcherTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void AddDirectoryTest1(Ishiko::Test& test);
+    static void WaitTest1(Ishiko::Test& test);
+    static void WaitTest2(Ishiko::Test& test);
+};
+
+#endif
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "FixtureCopierTests.hpp"
+#include <boost/filesystem.hpp>
+
+using namespace Ishiko;
+
+FixtureCopierTests::FixtureCopierTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "FixtureCopier tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("copy test 1", CopyTest1);
+    append<HeapAllocationErrorsTest>("copy test 2", CopyTest2);
+    append<HeapAllocationErrorsTest>("copy test 3", CopyTest3);
+    append<HeapAllocationErrorsTest>("copy test 4", CopyTest4);
+}
+
+void FixtureCopierTests::ConstructorTest1(Test& test)
+{
+    FixtureCopier copier;
+
+    ISHIKO_TEST_FAIL_IF_NEQ(copier.clonedFileCount(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(copier.linkedFileCount(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(copier.copiedFileCount(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void FixtureCopierTests::CopyTest1(Test& test)
+{
+    boost::filesystem::path sourcePath = test.context().getDataPath("ComparisonTestDirectories/Dir5");
+    boost::filesystem::path destinationPath = test.context().getOutputPath("FixtureCopierTests_CopyTest1");
+    boost::filesystem::remove_all(destinationPath);
+
+    FixtureCopier copier;
+
+    Error error;
+    copier.copy(sourcePath, destinationPath, error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(copier.clonedFileCount() + copier.copiedFileCount(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(copier.linkedFileCount(), 0);
+    ISHIKO_TEST_FAIL_IF_OUTPUT_AND_REFERENCE_FILES_NEQ("FixtureCopierTests_CopyTest1/Hello.txt");
+    ISHIKO_TEST_FAIL_IF_OUTPUT_AND_REFERENCE_FILES_NEQ("FixtureCopierTests_CopyTest1/Goodbye.txt");
+    ISHIKO_TEST_PASS();
+}
+
+void FixtureCopierTests::CopyTest2(Test& test)
+{
+    boost::filesystem::path sourcePath = test.context().getDataPath("ComparisonTestDirectories/Dir1/Hello.txt");
+    boost::filesystem::path destinationPath = test.context().getOutputPath("FixtureCopierTests_CopyTest2.txt");
+
+    FixtureCopier copier;
+    copier.setReadOnly(true);
+
+    Error error;
+    copier.copy(sourcePath, destinationPath, error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(copier.clonedFileCount() + copier.linkedFileCount() + copier.copiedFileCount(), 1);
+    ISHIKO_TEST_FAIL_IF_OUTPUT_AND_REFERENCE_FILES_NEQ("FixtureCopierTests_CopyTest2.txt");
+    ISHIKO_TEST_PASS();
+}
+
+void FixtureCopierTests::CopyTest3(Test& test)
+{
+    boost::filesystem::path path = test.context().getOutputPath("FixtureCopierTests_CopyTest3.txt");
+
+    FixtureCopier copier;
+
+    Error error;
+    copier.copy(test.context().getDataPath("ComparisonTestDirectories/Dir1/Hello.txt"), path, error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    copier.copy(path, path, error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_FAIL_IF_OUTPUT_AND_REFERENCE_FILES_NEQ("FixtureCopierTests_CopyTest3.txt");
+    ISHIKO_TEST_PASS();
+}
+
+void FixtureCopierTests::CopyTest4(Test& test)
+{
+    boost::filesystem::path sourcePath = test.context().getOutputPath("FixtureCopierTests_CopyTest4_Source.txt");
+    boost::filesystem::path destinationPath = test.context().getOutputPath("FixtureCopierTests_CopyTest4.txt");
+
+    FixtureCopier copier;
+
+    Error error;
+    copier.copy(test.context().getDataPath("ComparisonTestDirectories/Dir1/Hello.txt"), sourcePath, error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    // The destination may end up hard linked to the source, replacing it must leave the source alone
+    copier.setReadOnly(true);
+    copier.copy(sourcePath, destinationPath, error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    copier.setReadOnly(false);
+    copier.copy(test.context().getDataPath("ComparisonTestDirectories/Dir5/Goodbye.txt"), destinationPath, error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF_OUTPUT_AND_REFERENCE_FILES_NEQ("FixtureCopierTests_CopyTest4_Source.txt");
+    ISHIKO_TEST_FAIL_IF_OUTPUT_AND_REFERENCE_FILES_NEQ("FixtureCopierTests_CopyTest4.txt");
+    ISHIKO_TEST_PASS();
+}
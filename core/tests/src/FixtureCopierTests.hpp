@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_FIXTURECOPIERTESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_FIXTURECOPIERTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class FixtureCopierTests : public Ishiko::TestSequence
+{
+public:
+    FixtureCopierTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void CopyTest1(Ishiko::Test& test);
+    static void CopyTest2(Ishiko::Test& test);
+    static void CopyTest3(Ishiko::Test& test);
+    static void CopyTest4(Ishiko::Test& test);
+};
+
+#endif
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ForkServerTests.hpp"
+#include <boost/filesystem.hpp>
+
+using namespace Ishiko;
+
+ForkServerTests::ForkServerTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "ForkServer tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("start test 1", StartTest1);
+    append<HeapAllocationErrorsTest>("spawn test 1", SpawnTest1);
+}
+
+void ForkServerTests::ConstructorTest1(Test& test)
+{
+    ForkServer server;
+
+    ISHIKO_TEST_FAIL_IF(server.isRunning());
+    ISHIKO_TEST_FAIL_IF_NEQ(server.descriptor(), -1);
+    ISHIKO_TEST_PASS();
+}
+
+void ForkServerTests::StartTest1(Test& test)
+{
+    if (!ForkServer::IsSupported())
+    {
+        ISHIKO_TEST_SKIP();
+    }
+
+    ForkServer server;
+
+    Error error;
+    server.start(test.context().getDataDirectory() / "bin/DoesNotExist", error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_FAIL_IF(server.isRunning());
+    ISHIKO_TEST_PASS();
+}
+
+void ForkServerTests::SpawnTest1(Test& test)
+{
+    if (!ForkServer::IsSupported())
+    {
+        ISHIKO_TEST_SKIP();
+    }
+
+    // true doesn't call ForkServer::RunIfRequested so it just exits and the request can't be served
+    boost::filesystem::path executablePath("/bin/true");
+
+    ForkServer server;
+
+    Error error;
+    server.start(executablePath, error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+
+    int pid = server.spawn({ executablePath.string() }, 1, 2, error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(pid, -1);
+    ISHIKO_TEST_FAIL_IF(server.isRunning());
+    ISHIKO_TEST_PASS();
+}
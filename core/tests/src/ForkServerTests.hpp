@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_FORKSERVERTESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_FORKSERVERTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class ForkServerTests : public Ishiko::TestSequence
+{
+public:
+    ForkServerTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void StartTest1(Ishiko::Test& test);
+    static void SpawnTest1(Ishiko::Test& test);
+};
+
+#endif
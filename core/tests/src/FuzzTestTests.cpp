@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "FuzzTestTests.hpp"
+#include <boost/filesystem/operations.hpp>
+#include <algorithm>
+#include <string>
+
+using namespace Ishiko;
+
+namespace
+{
+
+class FailureMessageObserver : public Test::Observer
+{
+public:
+    void onCheckFailed(const Test& source, const std::string& message, const char* file, int line) override
+    {
+        m_message = message;
+    }
+
+    std::string m_message;
+};
+
+}
+
+FuzzTestTests::FuzzTestTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "FuzzTest tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("run test 1", RunTest1);
+    append<HeapAllocationErrorsTest>("run test 2", RunTest2);
+    append<HeapAllocationErrorsTest>("run test 3", RunTest3);
+}
+
+void FuzzTestTests::ConstructorTest1(Test& test)
+{
+    FuzzTest fuzzTest(TestNumber(1), "FuzzTest",
+        [](Test& test, const std::string& input)
+        {
+            test.pass();
+        });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(fuzzTest.iterations(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(fuzzTest.corpusSize(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(fuzzTest.result(), TestResult::unknown);
+    ISHIKO_TEST_PASS();
+}
+
+void FuzzTestTests::RunTest1(Test& test)
+{
+    size_t maxSize = 0;
+    FuzzTest fuzzTest(TestNumber(1), "FuzzTest",
+        [&maxSize](Test& test, const std::string& input)
+        {
+            maxSize = std::max(maxSize, input.size());
+            ISHIKO_TEST_PASS();
+        });
+    fuzzTest.setSeed(1);
+    fuzzTest.setMaxIterations(500);
+    fuzzTest.setMaxInputSize(16);
+
+    fuzzTest.run();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(fuzzTest.result(), TestResult::passed);
+    ISHIKO_TEST_FAIL_IF_NEQ(fuzzTest.iterations(), 500);
+    ISHIKO_TEST_FAIL_IF(fuzzTest.corpusSize() == 0);
+    ISHIKO_TEST_FAIL_IF(maxSize > 16);
+    ISHIKO_TEST_PASS();
+}
+
+void FuzzTestTests::RunTest2(Test& test)
+{
+    FuzzTest fuzzTest(TestNumber(1), "FuzzTest",
+        [](Test& test, const std::string& input)
+        {
+            ISHIKO_TEST_FAIL_IF(input.size() >= 4);
+            ISHIKO_TEST_PASS();
+        });
+    fuzzTest.setSeed(2);
+    std::shared_ptr<FailureMessageObserver> observer = std::make_shared<FailureMessageObserver>();
+    fuzzTest.observers().add(observer);
+
+    fuzzTest.run();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(fuzzTest.result(), TestResult::failed);
+    ISHIKO_TEST_FAIL_IF_NEQ(observer->m_message.find("Fuzzing failed for input "), 0);
+    ISHIKO_TEST_FAIL_IF_EQ(observer->m_message.find("(seed: 2, iteration: "), std::string::npos);
+    ISHIKO_TEST_PASS();
+}
+
+void FuzzTestTests::RunTest3(Test& test)
+{
+    // The crash is saved to the persistent storage and would be loaded by the next run so each run gets an empty one
+    boost::filesystem::path persistentStoragePath = test.context().getOutputPath("FuzzTestTests_RunTest3");
+    boost::filesystem::remove_all(persistentStoragePath);
+
+    TestContext fuzzTestContext;
+    fuzzTestContext.setReferenceDirectory(test.context().getReferenceDirectory());
+    fuzzTestContext.setOutputDirectory("persistent-storage", persistentStoragePath);
+
+    // The corpus is run before any mutation so an input of the corpus that fails is always reported
+    FuzzTest fuzzTest(TestNumber(1), "FuzzTest",
+        [](Test& test, const std::string& input)
+        {
+            ISHIKO_TEST_FAIL_IF_EQ(input, "crash");
+            ISHIKO_TEST_PASS();
+        },
+        fuzzTestContext);
+    fuzzTest.setSeed(3);
+    fuzzTest.setCorpusDirectory("FuzzTestTests_RunTest3");
+    std::shared_ptr<FailureMessageObserver> observer = std::make_shared<FailureMessageObserver>();
+    fuzzTest.observers().add(observer);
+
+    fuzzTest.run();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(fuzzTest.result(), TestResult::failed);
+    ISHIKO_TEST_FAIL_IF_NEQ(fuzzTest.iterations(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(fuzzTest.corpusSize(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(
+        observer->m_message.find("Fuzzing failed for input \"crash\" (seed: 3, corpus input, saved to: "), 0);
+    ISHIKO_TEST_FAIL_IF_NOT(boost::filesystem::is_directory(persistentStoragePath / "FuzzTest"));
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "IncrementalFileComparisonTests.hpp"
+
+using namespace Ishiko;
+
+IncrementalFileComparisonTests::IncrementalFileComparisonTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "IncrementalFileComparison tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("compare test 1", CompareTest1);
+    append<HeapAllocationErrorsTest>("compare test 2", CompareTest2);
+    append<HeapAllocationErrorsTest>("compare test 3", CompareTest3);
+    append<HeapAllocationErrorsTest>("compare test 4", CompareTest4);
+}
+
+void IncrementalFileComparisonTests::ConstructorTest1(Test& test)
+{
+    IncrementalFileComparison comparison;
+
+    ISHIKO_TEST_FAIL_IF(comparison.isOpen());
+    ISHIKO_TEST_FAIL_IF(comparison.mismatch());
+    ISHIKO_TEST_PASS();
+}
+
+void IncrementalFileComparisonTests::CompareTest1(Test& test)
+{
+    IncrementalFileComparison comparison;
+
+    Error error;
+    comparison.open(test.context().getDataPath("ComparisonTestFiles/Hello.txt"), error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    bool result1 = comparison.compare("Hel", 3);
+    bool result2 = comparison.compare("lo", 2);
+    bool result3 = comparison.finish();
+
+    ISHIKO_TEST_FAIL_IF_NOT(result1);
+    ISHIKO_TEST_FAIL_IF_NOT(result2);
+    ISHIKO_TEST_FAIL_IF_NOT(result3);
+    ISHIKO_TEST_FAIL_IF(comparison.mismatch());
+    ISHIKO_TEST_PASS();
+}
+
+void IncrementalFileComparisonTests::CompareTest2(Test& test)
+{
+    IncrementalFileComparison comparison;
+
+    Error error;
+    comparison.open(test.context().getDataPath("ComparisonTestFiles/Hello.txt"), error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    bool result1 = comparison.compare("Hel", 3);
+    bool result2 = comparison.compare("p!", 2);
+
+    ISHIKO_TEST_FAIL_IF_NOT(result1);
+    ISHIKO_TEST_FAIL_IF(result2);
+    ISHIKO_TEST_FAIL_IF_NOT(comparison.mismatch());
+    ISHIKO_TEST_FAIL_IF_NEQ(comparison.mismatchOffset(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(comparison.mismatchLine(), 1);
+    ISHIKO_TEST_PASS();
+}
+
+void IncrementalFileComparisonTests::CompareTest3(Test& test)
+{
+    IncrementalFileComparison comparison;
+
+    Error error;
+    comparison.open(test.context().getDataPath("ComparisonTestFiles/NotHello.txt"), error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    bool result = comparison.compare("Hello", 5);
+
+    ISHIKO_TEST_FAIL_IF(result);
+    ISHIKO_TEST_FAIL_IF_NEQ(comparison.mismatchOffset(), 4);
+    ISHIKO_TEST_PASS();
+}
+
+void IncrementalFileComparisonTests::CompareTest4(Test& test)
+{
+    IncrementalFileComparison comparison;
+
+    Error error;
+    comparison.open(test.context().getDataPath("ComparisonTestFiles/Hello.txt"), error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    bool result1 = comparison.compare("Hell", 4);
+    bool result2 = comparison.finish();
+
+    ISHIKO_TEST_FAIL_IF_NOT(result1);
+    ISHIKO_TEST_FAIL_IF(result2);
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_INCREMENTALFILECOMPARISONTESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_INCREMENTALFILECOMPARISONTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class IncrementalFileComparisonTests : public Ishiko::TestSequence
+{
+public:
+    IncrementalFileComparisonTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void CompareTest1(Ishiko::Test& test);
+    static void CompareTest2(Ishiko::Test& test);
+    static void CompareTest3(Ishiko::Test& test);
+    static void CompareTest4(Ishiko::Test& test);
+};
+
+#endif
@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "JSONLinesReporterTests.hpp"
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace Ishiko;
+
+JSONLinesReporterTests::JSONLinesReporterTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "JSONLinesReporter tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("run test 1", RunTest1);
+}
+
+void JSONLinesReporterTests::ConstructorTest1(Test& test)
+{
+    std::stringstream output;
+    JSONLinesReporter reporter(output);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(output.str(), "");
+    ISHIKO_TEST_PASS();
+}
+
+void JSONLinesReporterTests::RunTest1(Test& test)
+{
+    std::stringstream output;
+    {
+        TestSequence sequence(TestNumber(1), "Sequence");
+        sequence.append<Test>("Passing test",
+            [](Test& test)
+            {
+                ISHIKO_TEST_PASS();
+            });
+        sequence.append<Test>("Failing \"test\"",
+            [](Test& test)
+            {
+                ISHIKO_TEST_FAIL_IF_NEQ(1, 2);
+            });
+        sequence.append<Test>("Skipped test",
+            [](Test& test)
+            {
+                ISHIKO_TEST_SKIP();
+            });
+        std::shared_ptr<JSONLinesReporter> reporter = std::make_shared<JSONLinesReporter>(output);
+        sequence.observers().add(reporter);
+
+        sequence.run();
+        reporter->endRun();
+    }
+
+    std::string line1;
+    std::string line2;
+    std::string line3;
+    std::string line4;
+    std::getline(output, line1);
+    std::getline(output, line2);
+    std::getline(output, line3);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(line1.find("{\"number\":\"1.1\",\"name\":\"Passing test\",\"result\":\"passed\",\"duration\":"),
+        0);
+    ISHIKO_TEST_FAIL_IF_EQ(line1.find(",\"failures\":[]}"), std::string::npos);
+    ISHIKO_TEST_FAIL_IF_NEQ(
+        line2.find("{\"number\":\"1.2\",\"name\":\"Failing \\\"test\\\"\",\"result\":\"failed\",\"duration\":"), 0);
+    ISHIKO_TEST_FAIL_IF_EQ(line2.find(",\"failures\":[{\"message\":\"ISHIKO_TEST_FAIL_IF_NEQ(1, 2)"),
+        std::string::npos);
+    ISHIKO_TEST_FAIL_IF_EQ(line2.find("\"file\":\""), std::string::npos);
+    ISHIKO_TEST_FAIL_IF_NEQ(
+        line3.find("{\"number\":\"1.3\",\"name\":\"Skipped test\",\"result\":\"skipped\",\"duration\":"), 0);
+    ISHIKO_TEST_FAIL_IF(std::getline(output, line4));
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,19 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_JSONLINESREPORTERTESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_JSONLINESREPORTERTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class JSONLinesReporterTests : public Ishiko::TestSequence
+{
+public:
+    JSONLinesReporterTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void RunTest1(Ishiko::Test& test);
+};
+
+#endif
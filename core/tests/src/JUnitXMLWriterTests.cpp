@@ -17,6 +17,7 @@ JUnitXMLWriterTests::JUnitXMLWriterTests(const TestNumber& number, const TestCon
     append<HeapAllocationErrorsTest>("writeTestSuitesStart test 1", WriteTestSuitesStartTest1);
     append<HeapAllocationErrorsTest>("writeTestSuiteStart test 1", WriteTestSuiteStartTest1);
     append<HeapAllocationErrorsTest>("writeTestCaseStart test 1", WriteTestCaseStartTest1);
+    append<HeapAllocationErrorsTest>("writeProperty test 1", WritePropertyTest1);
 }
 
 void JUnitXMLWriterTests::ConstructorTest1(Test& test)
@@ -111,3 +112,30 @@ void JUnitXMLWriterTests::WriteTestCaseStartTest1(Test& test)
     ISHIKO_TEST_FAIL_IF_OUTPUT_AND_REFERENCE_FILES_NEQ("JUnitXMLWriterTests_WriteTestCaseStartTest1.xml");
     ISHIKO_TEST_PASS();
 }
+
+void JUnitXMLWriterTests::WritePropertyTest1(Test& test)
+{
+    boost::filesystem::path outputPath = test.context().getOutputPath("JUnitXMLWriterTests_WritePropertyTest1.xml");
+
+    JUnitXMLWriter junitXMLWriter;
+
+    Error error;
+    junitXMLWriter.create(outputPath, error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+
+    junitXMLWriter.writeTestSuitesStart();
+    junitXMLWriter.writeTestSuiteStart(1);
+    junitXMLWriter.writeTestCaseStart("classname1", "name1");
+    junitXMLWriter.writePropertiesStart();
+    junitXMLWriter.writeProperty("property1", "value1");
+    junitXMLWriter.writePropertiesEnd();
+    junitXMLWriter.writeTestCaseEnd();
+    junitXMLWriter.writeTestSuiteEnd();
+    junitXMLWriter.writeTestSuitesEnd();
+
+    junitXMLWriter.close();
+
+    ISHIKO_TEST_FAIL_IF_OUTPUT_AND_REFERENCE_FILES_NEQ("JUnitXMLWriterTests_WritePropertyTest1.xml");
+    ISHIKO_TEST_PASS();
+}
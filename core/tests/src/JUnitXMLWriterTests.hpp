@@ -20,6 +20,7 @@ private:
     static void WriteTestSuitesStartTest1(Ishiko::Test& test);
     static void WriteTestSuiteStartTest1(Ishiko::Test& test);
     static void WriteTestCaseStartTest1(Ishiko::Test& test);
+    static void WritePropertyTest1(Ishiko::Test& test);
 };
 
 #endif
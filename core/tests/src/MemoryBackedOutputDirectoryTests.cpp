@@ -0,0 +1,237 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "MemoryBackedOutputDirectoryTests.hpp"
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+using namespace Ishiko;
+
+MemoryBackedOutputDirectoryTests::MemoryBackedOutputDirectoryTests(const TestNumber& number,
+    const TestContext& context)
+    : TestSequence(number, "MemoryBackedOutputDirectory tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("create test 1", CreateTest1);
+    append<HeapAllocationErrorsTest>("copyOut test 1", CopyOutTest1);
+    append<HeapAllocationErrorsTest>("copyOut test 2", CopyOutTest2);
+    append<HeapAllocationErrorsTest>("copyOut test 3", CopyOutTest3);
+    append<HeapAllocationErrorsTest>("copyOut test 4", CopyOutTest4);
+    append<HeapAllocationErrorsTest>("copyOut test 5", CopyOutTest5);
+}
+
+void MemoryBackedOutputDirectoryTests::ConstructorTest1(Test& test)
+{
+    MemoryBackedOutputDirectory directory;
+
+    ISHIKO_TEST_FAIL_IF_NOT(directory.path().empty());
+    ISHIKO_TEST_FAIL_IF_NEQ(directory.keptCount(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void MemoryBackedOutputDirectoryTests::CreateTest1(Test& test)
+{
+    // The tests don't depend on a tmpfs mount being available, any directory will do
+    boost::filesystem::path rootPath = test.context().getOutputPath("MemoryBackedOutputDirectoryTests_CreateTest1");
+    boost::filesystem::path diskPath =
+        test.context().getOutputPath("MemoryBackedOutputDirectoryTests_CreateTest1_disk");
+    boost::filesystem::remove_all(rootPath);
+
+    boost::filesystem::path path;
+    {
+        MemoryBackedOutputDirectory directory;
+
+        Error error;
+        directory.create(rootPath, diskPath, error);
+
+        ISHIKO_TEST_FAIL_IF(error);
+        ISHIKO_TEST_FAIL_IF_NEQ(directory.path().parent_path(), rootPath);
+        ISHIKO_TEST_FAIL_IF_NEQ(directory.diskPath(), diskPath);
+        ISHIKO_TEST_FAIL_IF_NOT(boost::filesystem::is_directory(directory.path()));
+
+        path = directory.path();
+    }
+
+    ISHIKO_TEST_FAIL_IF(boost::filesystem::exists(path));
+    ISHIKO_TEST_PASS();
+}
+
+void MemoryBackedOutputDirectoryTests::CopyOutTest1(Test& test)
+{
+    boost::filesystem::path rootPath = test.context().getOutputPath("MemoryBackedOutputDirectoryTests_CopyOutTest1");
+    boost::filesystem::path diskPath =
+        test.context().getOutputPath("MemoryBackedOutputDirectoryTests_CopyOutTest1_disk");
+    boost::filesystem::remove_all(rootPath);
+    boost::filesystem::remove_all(diskPath);
+
+    MemoryBackedOutputDirectory directory;
+
+    Error error;
+    directory.create(rootPath, diskPath, error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    boost::filesystem::create_directories(directory.path() / "failed");
+    std::ofstream((directory.path() / "failed" / "output.txt").string()) << "failed";
+    std::ofstream((directory.path() / "passed.txt").string()) << "passed";
+    directory.keep(directory.path() / "failed" / "output.txt");
+    directory.keep(directory.path() / "missing.txt");
+    directory.keep(rootPath / "outside.txt");
+    directory.copyOut(error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(directory.keptCount(), 2);
+    ISHIKO_TEST_FAIL_IF_NOT(boost::filesystem::exists(diskPath / "failed" / "output.txt"));
+    ISHIKO_TEST_FAIL_IF(boost::filesystem::exists(diskPath / "passed.txt"));
+    ISHIKO_TEST_FAIL_IF(boost::filesystem::exists(diskPath / "missing.txt"));
+    ISHIKO_TEST_PASS();
+}
+
+void MemoryBackedOutputDirectoryTests::CopyOutTest2(Test& test)
+{
+    boost::filesystem::path rootPath = test.context().getOutputPath("MemoryBackedOutputDirectoryTests_CopyOutTest2");
+    boost::filesystem::path diskPath =
+        test.context().getOutputPath("MemoryBackedOutputDirectoryTests_CopyOutTest2_disk");
+    boost::filesystem::remove_all(rootPath);
+    boost::filesystem::remove_all(diskPath);
+
+    std::shared_ptr<MemoryBackedOutputDirectory> directory = std::make_shared<MemoryBackedOutputDirectory>();
+
+    Error error;
+    directory->create(rootPath, diskPath, error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    // A failed file comparison marks its output file to be kept
+    TestContext context;
+    context.setOutputDirectory(directory->path());
+    context.setMemoryBackedOutputDirectory(directory);
+    std::ofstream((directory->path() / "output.txt").string()) << "different";
+
+    TestSequence sequence(TestNumber(), "CopyOutTest2", context);
+    sequence.append<Test>("failing comparison",
+        [&test](Test& functionTest)
+        {
+            FileComparisonTestCheck check(functionTest.context().getOutputPath("output.txt"),
+                test.context().getDataPath("ComparisonTestFiles/Hello.txt"));
+            check.run(functionTest, __FILE__, __LINE__);
+        });
+    sequence.run();
+    directory->copyOut(error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF(sequence.passed());
+    ISHIKO_TEST_FAIL_IF_NEQ(directory->keptCount(), 1);
+    ISHIKO_TEST_FAIL_IF_NOT(boost::filesystem::exists(diskPath / "output.txt"));
+    ISHIKO_TEST_PASS();
+}
+
+void MemoryBackedOutputDirectoryTests::CopyOutTest3(Test& test)
+{
+    boost::filesystem::path rootPath = test.context().getOutputPath("MemoryBackedOutputDirectoryTests_CopyOutTest3");
+    boost::filesystem::path diskPath =
+        test.context().getOutputPath("MemoryBackedOutputDirectoryTests_CopyOutTest3_disk");
+    boost::filesystem::remove_all(rootPath);
+    boost::filesystem::remove_all(diskPath);
+
+    std::shared_ptr<MemoryBackedOutputDirectory> directory = std::make_shared<MemoryBackedOutputDirectory>();
+
+    Error error;
+    directory->create(rootPath, diskPath, error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    // A failed directory comparison marks its output directory to be kept
+    TestContext context;
+    context.setOutputDirectory(directory->path());
+    context.setMemoryBackedOutputDirectory(directory);
+    boost::filesystem::create_directories(directory->path() / "output");
+    std::ofstream((directory->path() / "output" / "Hello.txt").string()) << "Hello";
+
+    TestSequence sequence(TestNumber(), "CopyOutTest3", context);
+    sequence.append<Test>("failing comparison",
+        [&test](Test& functionTest)
+        {
+            DirectoryComparisonTestCheck check(functionTest.context().getOutputPath("output"),
+                test.context().getDataPath("ComparisonTestDirectories/Dir5"));
+            check.run(functionTest, __FILE__, __LINE__);
+        });
+    sequence.run();
+    directory->copyOut(error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF(sequence.passed());
+    ISHIKO_TEST_FAIL_IF_NEQ(directory->keptCount(), 1);
+    ISHIKO_TEST_FAIL_IF_NOT(boost::filesystem::exists(diskPath / "output" / "Hello.txt"));
+    ISHIKO_TEST_PASS();
+}
+
+void MemoryBackedOutputDirectoryTests::CopyOutTest4(Test& test)
+{
+    boost::filesystem::path rootPath = test.context().getOutputPath("MemoryBackedOutputDirectoryTests_CopyOutTest4");
+    boost::filesystem::path diskPath =
+        test.context().getOutputPath("MemoryBackedOutputDirectoryTests_CopyOutTest4_disk");
+    boost::filesystem::remove_all(rootPath);
+    boost::filesystem::remove_all(diskPath);
+
+#ifdef __linux__
+    boost::filesystem::path executablePath(test.context().getDataDirectory() / "bin/StandardOutputTestHelper");
+#else
+    boost::filesystem::path executablePath(test.context().getDataDirectory() / "bin/StandardOutputTestHelper.exe");
+#endif
+
+    std::shared_ptr<MemoryBackedOutputDirectory> directory = std::make_shared<MemoryBackedOutputDirectory>();
+
+    Error error;
+    directory->create(rootPath, diskPath, error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    // The standard output of a console application that failed is kept even without a reference to compare it to
+    TestContext context;
+    context.setOutputDirectory(directory->path());
+    context.setMemoryBackedOutputDirectory(directory);
+
+    ConsoleApplicationTest applicationTest(TestNumber(), "CopyOutTest4", executablePath.string(), 1, context);
+    applicationTest.setStandardOutputFilePath(directory->path() / "stdout.txt");
+    applicationTest.run();
+    directory->copyOut(error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF(applicationTest.passed());
+    ISHIKO_TEST_FAIL_IF_NEQ(directory->keptCount(), 1);
+    ISHIKO_TEST_FAIL_IF_NOT(boost::filesystem::exists(diskPath / "stdout.txt"));
+    ISHIKO_TEST_PASS();
+}
+
+void MemoryBackedOutputDirectoryTests::CopyOutTest5(Test& test)
+{
+    boost::filesystem::path rootPath = test.context().getOutputPath("MemoryBackedOutputDirectoryTests_CopyOutTest5");
+    boost::filesystem::path diskPath =
+        test.context().getOutputPath("MemoryBackedOutputDirectoryTests_CopyOutTest5_disk");
+    boost::filesystem::remove_all(rootPath);
+    boost::filesystem::remove_all(diskPath);
+
+    MemoryBackedOutputDirectory directory;
+
+    Error error;
+    directory.create(rootPath, diskPath, error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    // A file in the way of the destination directory makes the first copy fail but not the second one
+    boost::filesystem::create_directories(diskPath);
+    std::ofstream((diskPath / "blocked").string()) << "blocked";
+    boost::filesystem::create_directories(directory.path() / "blocked");
+    std::ofstream((directory.path() / "blocked" / "output.txt").string()) << "failed";
+    std::ofstream((directory.path() / "output.txt").string()) << "failed";
+    directory.keep(directory.path() / "blocked" / "output.txt");
+    directory.keep(directory.path() / "output.txt");
+    std::vector<boost::filesystem::path> failedPaths = directory.copyOut(error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_ABORT_IF_NEQ(failedPaths.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(failedPaths[0], boost::filesystem::path("blocked") / "output.txt");
+    ISHIKO_TEST_FAIL_IF_NOT(boost::filesystem::exists(diskPath / "output.txt"));
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_MEMORYBACKEDOUTPUTDIRECTORYTESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_MEMORYBACKEDOUTPUTDIRECTORYTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class MemoryBackedOutputDirectoryTests : public Ishiko::TestSequence
+{
+public:
+    MemoryBackedOutputDirectoryTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void CreateTest1(Ishiko::Test& test);
+    static void CopyOutTest1(Ishiko::Test& test);
+    static void CopyOutTest2(Ishiko::Test& test);
+    static void CopyOutTest3(Ishiko::Test& test);
+    static void CopyOutTest4(Ishiko::Test& test);
+    static void CopyOutTest5(Ishiko::Test& test);
+};
+
+#endif
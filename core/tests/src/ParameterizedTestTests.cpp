@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ParameterizedTestTests.hpp"
+#include <string>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+
+class LifecycleEventsObserver : public Test::Observer
+{
+public:
+    void onLifecycleEvent(const Test& source, EventType type) override
+    {
+        if (type == test_end)
+        {
+            m_numbers.push_back(source.number());
+            m_names.push_back(source.name());
+        }
+    }
+
+    std::vector<TestNumber> m_numbers;
+    std::vector<std::string> m_names;
+};
+
+}
+
+ParameterizedTestTests::ParameterizedTestTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "ParameterizedTest tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("run test 1", RunTest1);
+    append<HeapAllocationErrorsTest>("run test 2", RunTest2);
+    append<HeapAllocationErrorsTest>("run test 3", RunTest3);
+    append<HeapAllocationErrorsTest>("run test 4", RunTest4);
+    append<HeapAllocationErrorsTest>("run test 5", RunTest5);
+}
+
+void ParameterizedTestTests::ConstructorTest1(Test& test)
+{
+    ParameterizedTest<int> parameterizedTest(TestNumber(1), "ParameterizedTest", ParameterizedTest<int>::Range(0, 3),
+        [](Test& test, const int& parameter)
+        {
+            test.pass();
+        });
+
+    // The cases are only enumerated when the test is run
+    ISHIKO_TEST_FAIL_IF_NEQ(parameterizedTest.caseCount(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(parameterizedTest.result(), TestResult::unknown);
+    ISHIKO_TEST_PASS();
+}
+
+void ParameterizedTestTests::RunTest1(Test& test)
+{
+    size_t bodyCalls = 0;
+    ParameterizedTest<int> parameterizedTest(TestNumber(1), "ParameterizedTest", ParameterizedTest<int>::Range(0, 3),
+        [&bodyCalls](Test& test, const int& parameter)
+        {
+            ++bodyCalls;
+            test.pass();
+        });
+
+    parameterizedTest.run();
+
+    size_t unknown = 0;
+    size_t passed = 0;
+    size_t passedButMemoryLeaks = 0;
+    size_t exception = 0;
+    size_t failed = 0;
+    size_t skipped = 0;
+    size_t total = 0;
+    parameterizedTest.getPassRate(unknown, passed, passedButMemoryLeaks, exception, failed, skipped, total);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(parameterizedTest.result(), TestResult::passed);
+    ISHIKO_TEST_FAIL_IF_NEQ(bodyCalls, 3);
+    ISHIKO_TEST_ABORT_IF_NEQ(parameterizedTest.caseCount(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(parameterizedTest.caseName(0), "ParameterizedTest [0]");
+    ISHIKO_TEST_FAIL_IF_NEQ(parameterizedTest.caseName(2), "ParameterizedTest [2]");
+    ISHIKO_TEST_FAIL_IF_NEQ(passed, 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(total, 3);
+    ISHIKO_TEST_PASS();
+}
+
+void ParameterizedTestTests::RunTest2(Test& test)
+{
+    ParameterizedTest<std::string> parameterizedTest(TestNumber(1), "ParameterizedTest",
+        ParameterizedTest<std::string>::Values({"a", "bb", "ccc"}),
+        [](const std::string& parameter)
+        {
+            return ("length of " + parameter);
+        },
+        [](Test& test, const std::string& parameter)
+        {
+            ISHIKO_TEST_FAIL_IF_EQ(parameter.size(), 2);
+            ISHIKO_TEST_PASS();
+        });
+
+    parameterizedTest.run();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(parameterizedTest.result(), TestResult::failed);
+    ISHIKO_TEST_ABORT_IF_NEQ(parameterizedTest.caseCount(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(parameterizedTest.caseName(1), "length of bb");
+    ISHIKO_TEST_FAIL_IF_NEQ(parameterizedTest.caseResult(0), TestResult::passed);
+    ISHIKO_TEST_FAIL_IF_NEQ(parameterizedTest.caseResult(1), TestResult::failed);
+    ISHIKO_TEST_FAIL_IF_NEQ(parameterizedTest.caseResult(2), TestResult::passed);
+    ISHIKO_TEST_PASS();
+}
+
+void ParameterizedTestTests::RunTest3(Test& test)
+{
+    ParameterizedTest<int> parameterizedTest(TestNumber(1), "ParameterizedTest", ParameterizedTest<int>::Range(0, 2),
+        [](Test& test, const int& parameter)
+        {
+            test.pass();
+        });
+    std::shared_ptr<LifecycleEventsObserver> observer = std::make_shared<LifecycleEventsObserver>();
+    parameterizedTest.observers().add(observer);
+
+    parameterizedTest.run();
+
+    // Each case is reported individually, followed by the parameterized test itself
+    ISHIKO_TEST_ABORT_IF_NEQ(observer->m_numbers.size(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(observer->m_numbers[0], TestNumber(1, 1));
+    ISHIKO_TEST_FAIL_IF_NEQ(observer->m_names[0], "ParameterizedTest [0]");
+    ISHIKO_TEST_FAIL_IF_NEQ(observer->m_numbers[1], TestNumber(1, 2));
+    ISHIKO_TEST_FAIL_IF_NEQ(observer->m_names[1], "ParameterizedTest [1]");
+    ISHIKO_TEST_FAIL_IF_NEQ(observer->m_numbers[2], TestNumber(1));
+    ISHIKO_TEST_FAIL_IF_NEQ(observer->m_names[2], "ParameterizedTest");
+    ISHIKO_TEST_PASS();
+}
+
+void ParameterizedTestTests::RunTest4(Test& test)
+{
+    ParameterizedTest<int> parameterizedTest(TestNumber(1), "ParameterizedTest", ParameterizedTest<int>::Range(0, 0),
+        [](Test& test, const int& parameter)
+        {
+            test.pass();
+        });
+
+    parameterizedTest.run();
+
+    // Like an empty sequence, a parameterized test without cases is considered a failure
+    ISHIKO_TEST_FAIL_IF_NEQ(parameterizedTest.result(), TestResult::failed);
+    ISHIKO_TEST_FAIL_IF_NEQ(parameterizedTest.caseCount(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void ParameterizedTestTests::RunTest5(Test& test)
+{
+    size_t bodyCalls = 0;
+    ParameterizedTest<int> parameterizedTest(TestNumber(1), "ParameterizedTest",
+        ParameterizedTest<int>::Values({ 1, 2 }),
+        [&bodyCalls](Test& test, const int& parameter)
+        {
+            ++bodyCalls;
+            test.pass();
+        });
+
+    // The generator is consumed by the first run, the second one must start again from the first parameter
+    parameterizedTest.run();
+    parameterizedTest.run();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(parameterizedTest.result(), TestResult::passed);
+    ISHIKO_TEST_FAIL_IF_NEQ(bodyCalls, 4);
+    ISHIKO_TEST_ABORT_IF_NEQ(parameterizedTest.caseCount(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(parameterizedTest.caseName(0), "ParameterizedTest [1]");
+    ISHIKO_TEST_FAIL_IF_NEQ(parameterizedTest.caseName(1), "ParameterizedTest [2]");
+    ISHIKO_TEST_PASS();
+}
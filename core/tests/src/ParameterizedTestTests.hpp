@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_PARAMETERIZEDTESTTESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_PARAMETERIZEDTESTTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class ParameterizedTestTests : public Ishiko::TestSequence
+{
+public:
+    ParameterizedTestTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void RunTest1(Ishiko::Test& test);
+    static void RunTest2(Ishiko::Test& test);
+    static void RunTest3(Ishiko::Test& test);
+    static void RunTest4(Ishiko::Test& test);
+    static void RunTest5(Ishiko::Test& test);
+};
+
+#endif
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PipedChildProcessTests.hpp"
+#include <string>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+
+class OutputRecorder : public PipedChildProcess::Callbacks
+{
+public:
+    void onStandardOutput(const char* data, size_t size) override
+    {
+        m_standardOutput.append(data, size);
+    }
+
+    std::string m_standardOutput;
+};
+
+}
+
+PipedChildProcessTests::PipedChildProcessTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "PipedChildProcess tests", context)
+{
+    append<HeapAllocationErrorsTest>("SplitCommandLine test 1", SplitCommandLineTest1);
+    append<HeapAllocationErrorsTest>("SplitCommandLine test 2", SplitCommandLineTest2);
+    append<HeapAllocationErrorsTest>("SplitCommandLine test 3", SplitCommandLineTest3);
+    append<HeapAllocationErrorsTest>("SplitCommandLine test 4", SplitCommandLineTest4);
+    append<HeapAllocationErrorsTest>("start test 1", StartTest1);
+    append<HeapAllocationErrorsTest>("setResourceLimits test 1", SetResourceLimitsTest1);
+}
+
+void PipedChildProcessTests::SplitCommandLineTest1(Test& test)
+{
+    std::vector<std::string> arguments = PipedChildProcess::SplitCommandLine("  program  first\tsecond ");
+
+    ISHIKO_TEST_ABORT_IF_NEQ(arguments.size(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[0], "program");
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[1], "first");
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[2], "second");
+    ISHIKO_TEST_PASS();
+}
+
+void PipedChildProcessTests::SplitCommandLineTest2(Test& test)
+{
+    std::vector<std::string> arguments =
+        PipedChildProcess::SplitCommandLine("program \"first argument\" 'second argument' third\" \"argument");
+
+    ISHIKO_TEST_ABORT_IF_NEQ(arguments.size(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[0], "program");
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[1], "first argument");
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[2], "second argument");
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[3], "third argument");
+    ISHIKO_TEST_PASS();
+}
+
+void PipedChildProcessTests::SplitCommandLineTest3(Test& test)
+{
+    std::vector<std::string> arguments =
+        PipedChildProcess::SplitCommandLine("program \"a \\\"quoted\\\" \\\\ word\" 'a \\ b' \\\"c \\d e\\ f \"\\g\"");
+
+    ISHIKO_TEST_ABORT_IF_NEQ(arguments.size(), 7);
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[0], "program");
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[1], "a \"quoted\" \\ word");
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[2], "a \\ b");
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[3], "\"c");
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[4], "d");
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[5], "e f");
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[6], "\\g");
+    ISHIKO_TEST_PASS();
+}
+
+void PipedChildProcessTests::SplitCommandLineTest4(Test& test)
+{
+    std::vector<std::string> arguments = PipedChildProcess::SplitCommandLine("program \"\" '' last");
+
+    ISHIKO_TEST_ABORT_IF_NEQ(arguments.size(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[0], "program");
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[1], "");
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[2], "");
+    ISHIKO_TEST_FAIL_IF_NEQ(arguments[3], "last");
+    ISHIKO_TEST_PASS();
+}
+
+void PipedChildProcessTests::StartTest1(Test& test)
+{
+    if (!PipedChildProcess::IsSupported())
+    {
+        ISHIKO_TEST_SKIP();
+    }
+
+    OutputRecorder recorder;
+    PipedChildProcess process;
+
+    Error error;
+    process.start("/bin/sh -c 'printf \"[%s]\" \"$@\"' sh \"a b\" '' c\\\"d", recorder, error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    process.readAllOutput();
+    process.waitForExit();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(process.exitCode(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(recorder.m_standardOutput, "[a b][][c\"d]");
+    ISHIKO_TEST_PASS();
+}
+
+void PipedChildProcessTests::SetResourceLimitsTest1(Test& test)
+{
+    if (!PipedChildProcess::IsSupported())
+    {
+        ISHIKO_TEST_SKIP();
+    }
+
+    ChildProcessResourceLimits limits;
+    limits.maxMemorySize = 16 * 1024 * 1024;
+
+    OutputRecorder recorder;
+    PipedChildProcess process;
+    process.setResourceLimits(limits);
+
+    // The limit is in place before the shell starts so it can't allocate the memory to keep the 50 MB of output
+    Error error;
+    process.start("/bin/sh -c 'x=$(yes | head -c 50000000)'", recorder, error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    process.readAllOutput();
+    process.waitForExit();
+
+    ISHIKO_TEST_FAIL_IF_EQ(process.exitCode(), 0);
+    ISHIKO_TEST_FAIL_IF(process.resourceUsage().maxResidentSetSize > limits.maxMemorySize);
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_PIPEDCHILDPROCESSTESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_PIPEDCHILDPROCESSTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class PipedChildProcessTests : public Ishiko::TestSequence
+{
+public:
+    PipedChildProcessTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void SplitCommandLineTest1(Ishiko::Test& test);
+    static void SplitCommandLineTest2(Ishiko::Test& test);
+    static void SplitCommandLineTest3(Ishiko::Test& test);
+    static void SplitCommandLineTest4(Ishiko::Test& test);
+    static void StartTest1(Ishiko::Test& test);
+    static void SetResourceLimitsTest1(Ishiko::Test& test);
+};
+
+#endif
@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PropertyGeneratorTests.hpp"
+#include <random>
+#include <vector>
+
+using namespace Ishiko;
+
+PropertyGeneratorTests::PropertyGeneratorTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "PropertyGenerator tests", context)
+{
+    append<HeapAllocationErrorsTest>("Integers test 1", IntegersTest1);
+    append<HeapAllocationErrorsTest>("Integers test 2", IntegersTest2);
+    append<HeapAllocationErrorsTest>("Elements test 1", ElementsTest1);
+    append<HeapAllocationErrorsTest>("Elements test 2", ElementsTest2);
+    append<HeapAllocationErrorsTest>("vectors test 1", VectorsTest1);
+    append<HeapAllocationErrorsTest>("filter test 1", FilterTest1);
+}
+
+void PropertyGeneratorTests::IntegersTest1(Test& test)
+{
+    PropertyGenerator<int> generator = PropertyGenerator<int>::Integers(-5, 5);
+
+    std::mt19937_64 random(42);
+    bool outOfRange = false;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        int value = generator.generate(random);
+        if ((value < -5) || (value > 5))
+        {
+            outOfRange = true;
+        }
+    }
+
+    ISHIKO_TEST_FAIL_IF(outOfRange);
+    ISHIKO_TEST_FAIL_IF_NEQ(generator.shrink(0).size(), 0);
+    ISHIKO_TEST_ABORT_IF_NEQ(generator.shrink(4).size(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(generator.shrink(4)[0], 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(generator.shrink(4)[1], 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(generator.shrink(4)[2], 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(generator.shrink(-4)[1], -2);
+    ISHIKO_TEST_PASS();
+}
+
+void PropertyGeneratorTests::IntegersTest2(Test& test)
+{
+    // When 0 isn't in the range the values shrink towards the bound closest to it
+    PropertyGenerator<int> generator = PropertyGenerator<int>::Integers(10, 20);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(generator.shrink(10).size(), 0);
+    ISHIKO_TEST_ABORT_IF_NEQ(generator.shrink(14).size(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(generator.shrink(14)[0], 10);
+    ISHIKO_TEST_FAIL_IF_NEQ(generator.shrink(14)[1], 12);
+    ISHIKO_TEST_PASS();
+}
+
+void PropertyGeneratorTests::ElementsTest1(Test& test)
+{
+    PropertyGenerator<int> generator = PropertyGenerator<int>::Elements({ 3, 5, 7 });
+
+    std::mt19937_64 random(42);
+    bool unexpected = false;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        int value = generator.generate(random);
+        if ((value != 3) && (value != 5) && (value != 7))
+        {
+            unexpected = true;
+        }
+    }
+
+    std::vector<int> candidates = generator.shrink(7);
+
+    ISHIKO_TEST_FAIL_IF(unexpected);
+    ISHIKO_TEST_ABORT_IF_NEQ(candidates.size(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(candidates[0], 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(candidates[1], 5);
+    ISHIKO_TEST_PASS();
+}
+
+void PropertyGeneratorTests::ElementsTest2(Test& test)
+{
+    bool thrown = false;
+    try
+    {
+        PropertyGenerator<int>::Elements(std::vector<int>());
+    }
+    catch (const TestException&)
+    {
+        thrown = true;
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(thrown);
+    ISHIKO_TEST_PASS();
+}
+
+void PropertyGeneratorTests::VectorsTest1(Test& test)
+{
+    PropertyGenerator<std::vector<int>> generator = PropertyGenerator<int>::Integers(0, 9).vectors(4);
+
+    std::mt19937_64 random(42);
+    bool tooLarge = false;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        if (generator.generate(random).size() > 4)
+        {
+            tooLarge = true;
+        }
+    }
+
+    std::vector<std::vector<int>> candidates = generator.shrink(std::vector<int>{1, 2});
+
+    ISHIKO_TEST_FAIL_IF(tooLarge);
+    ISHIKO_TEST_ABORT_IF_NEQ(candidates.size(), 6);
+    ISHIKO_TEST_FAIL_IF_NEQ(candidates[0].size(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(candidates[1], std::vector<int>{2});
+    ISHIKO_TEST_FAIL_IF_NEQ(candidates[2], std::vector<int>{1});
+    ISHIKO_TEST_FAIL_IF_NEQ(candidates[3], (std::vector<int>{0, 2}));
+    ISHIKO_TEST_FAIL_IF_NEQ(candidates[4], (std::vector<int>{1, 0}));
+    ISHIKO_TEST_FAIL_IF_NEQ(candidates[5], (std::vector<int>{1, 1}));
+    ISHIKO_TEST_FAIL_IF_NEQ(generator.shrink(std::vector<int>()).size(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void PropertyGeneratorTests::FilterTest1(Test& test)
+{
+    PropertyGenerator<int> generator = PropertyGenerator<int>::Integers(0, 100).filter(
+        [](const int& value)
+        {
+            return ((value % 2) == 1);
+        });
+
+    std::mt19937_64 random(42);
+    bool even = false;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        if ((generator.generate(random) % 2) == 0)
+        {
+            even = true;
+        }
+    }
+
+    std::vector<int> candidates = generator.shrink(9);
+
+    ISHIKO_TEST_FAIL_IF(even);
+    ISHIKO_TEST_ABORT_IF_NEQ(candidates.size(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(candidates[0], 5);
+    ISHIKO_TEST_FAIL_IF_NEQ(candidates[1], 7);
+    ISHIKO_TEST_PASS();
+}
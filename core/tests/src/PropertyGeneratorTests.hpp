@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_PROPERTYGENERATORTESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_PROPERTYGENERATORTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class PropertyGeneratorTests : public Ishiko::TestSequence
+{
+public:
+    PropertyGeneratorTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void IntegersTest1(Ishiko::Test& test);
+    static void IntegersTest2(Ishiko::Test& test);
+    static void ElementsTest1(Ishiko::Test& test);
+    static void ElementsTest2(Ishiko::Test& test);
+    static void VectorsTest1(Ishiko::Test& test);
+    static void FilterTest1(Ishiko::Test& test);
+};
+
+#endif
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PropertyTestTests.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+using namespace Ishiko;
+
+namespace
+{
+
+class FailureMessageObserver : public Test::Observer
+{
+public:
+    void onCheckFailed(const Test& source, const std::string& message, const char* file, int line) override
+    {
+        m_message = message;
+    }
+
+    std::string m_message;
+};
+
+}
+
+PropertyTestTests::PropertyTestTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "PropertyTest tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("run test 1", RunTest1);
+    append<HeapAllocationErrorsTest>("run test 2", RunTest2);
+    append<HeapAllocationErrorsTest>("run test 3", RunTest3);
+    append<HeapAllocationErrorsTest>("run test 4", RunTest4);
+}
+
+void PropertyTestTests::ConstructorTest1(Test& test)
+{
+    PropertyTest<int> propertyTest(TestNumber(1), "PropertyTest", PropertyGenerator<int>::Integers(0, 10),
+        [](Test& test, const int& input)
+        {
+            test.pass();
+        });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(propertyTest.caseCount(), 100);
+    ISHIKO_TEST_FAIL_IF(propertyTest.parallelism() == 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(propertyTest.result(), TestResult::unknown);
+    ISHIKO_TEST_PASS();
+}
+
+void PropertyTestTests::RunTest1(Test& test)
+{
+    std::atomic<size_t> calls(0);
+    PropertyTest<int> propertyTest(TestNumber(1), "PropertyTest", PropertyGenerator<int>::Integers(0, 10),
+        [&calls](Test& test, const int& input)
+        {
+            ++calls;
+            ISHIKO_TEST_FAIL_IF(input > 10);
+            ISHIKO_TEST_PASS();
+        });
+    propertyTest.setCaseCount(50);
+    propertyTest.setParallelism(4);
+
+    propertyTest.run();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(propertyTest.result(), TestResult::passed);
+    ISHIKO_TEST_FAIL_IF_NEQ(calls.load(), 50);
+    ISHIKO_TEST_PASS();
+}
+
+void PropertyTestTests::RunTest2(Test& test)
+{
+    PropertyTest<int> propertyTest(TestNumber(1), "PropertyTest", PropertyGenerator<int>::Integers(0, 1000),
+        [](Test& test, const int& input)
+        {
+            ISHIKO_TEST_FAIL_IF(input >= 50);
+            ISHIKO_TEST_PASS();
+        });
+    propertyTest.setSeed(42);
+    std::shared_ptr<FailureMessageObserver> observer = std::make_shared<FailureMessageObserver>();
+    propertyTest.observers().add(observer);
+
+    propertyTest.run();
+
+    // Whatever the input that failed first, it gets shrunk to the smallest one the property fails for
+    ISHIKO_TEST_FAIL_IF_NEQ(propertyTest.result(), TestResult::failed);
+    ISHIKO_TEST_FAIL_IF_NEQ(observer->m_message.find("Property failed for input 50 (seed: 42,"), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void PropertyTestTests::RunTest3(Test& test)
+{
+    // The counterexample only depends on the seed, not on the number of threads
+    std::string messages[2];
+    for (size_t i = 0; i < 2; ++i)
+    {
+        PropertyTest<std::string> propertyTest(TestNumber(1), "PropertyTest",
+            PropertyGenerator<char>::Integers('a', 'z').strings(10),
+            [](Test& test, const std::string& input)
+            {
+                ISHIKO_TEST_FAIL_IF(input.find('q') != std::string::npos);
+                ISHIKO_TEST_PASS();
+            });
+        propertyTest.setSeed(12345);
+        propertyTest.setParallelism((i == 0) ? 1 : 8);
+        std::shared_ptr<FailureMessageObserver> observer = std::make_shared<FailureMessageObserver>();
+        propertyTest.observers().add(observer);
+
+        propertyTest.run();
+
+        messages[i] = observer->m_message;
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(messages[0].find("Property failed for input \"q\"s (seed: 12345,"), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(messages[0], messages[1]);
+    ISHIKO_TEST_PASS();
+}
+
+void PropertyTestTests::RunTest4(Test& test)
+{
+    PropertyTest<int> propertyTest(TestNumber(1), "PropertyTest", PropertyGenerator<int>::Integers(0, 1000),
+        [](Test& test, const int& input)
+        {
+            if (input >= 10)
+            {
+                throw std::runtime_error("input too large");
+            }
+            test.pass();
+        });
+    propertyTest.setSeed(7);
+    propertyTest.setParallelism(1);
+    std::shared_ptr<FailureMessageObserver> observer = std::make_shared<FailureMessageObserver>();
+    propertyTest.observers().add(observer);
+
+    propertyTest.run();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(propertyTest.result(), TestResult::failed);
+    ISHIKO_TEST_FAIL_IF_NEQ(observer->m_message.find("Property failed for input 10 (seed: 7,"), 0);
+    ISHIKO_TEST_FAIL_IF_EQ(observer->m_message.find("Exception thrown: input too large"), std::string::npos);
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_PROPERTYTESTTESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_PROPERTYTESTTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class PropertyTestTests : public Ishiko::TestSequence
+{
+public:
+    PropertyTestTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void RunTest1(Ishiko::Test& test);
+    static void RunTest2(Ishiko::Test& test);
+    static void RunTest3(Ishiko::Test& test);
+    static void RunTest4(Ishiko::Test& test);
+};
+
+#endif
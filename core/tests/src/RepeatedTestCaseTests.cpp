@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "RepeatedTestCaseTests.hpp"
+#include <stdexcept>
+
+using namespace Ishiko;
+
+RepeatedTestCaseTests::RepeatedTestCaseTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "RepeatedTestCase tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("check test 1", CheckTest1);
+    append<HeapAllocationErrorsTest>("check test 2", CheckTest2);
+    append<HeapAllocationErrorsTest>("check test 3", CheckTest3);
+}
+
+void RepeatedTestCaseTests::ConstructorTest1(Test& test)
+{
+    Test owner(TestNumber(1), "Owner");
+    RepeatedTestCase repeatedTest(owner);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(repeatedTest.number(), TestNumber(1));
+    ISHIKO_TEST_FAIL_IF_NEQ(repeatedTest.name(), "Owner");
+    ISHIKO_TEST_FAIL_IF_NEQ(repeatedTest.failureLine(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void RepeatedTestCaseTests::CheckTest1(Test& test)
+{
+    Test owner(TestNumber(1), "Owner");
+    RepeatedTestCase repeatedTest(owner);
+
+    bool passed = repeatedTest.check(
+        [](Test& test)
+        {
+            ISHIKO_TEST_PASS();
+        });
+
+    ISHIKO_TEST_FAIL_IF_NOT(passed);
+    ISHIKO_TEST_FAIL_IF_NEQ(repeatedTest.failureMessage(), "");
+    ISHIKO_TEST_PASS();
+}
+
+void RepeatedTestCaseTests::CheckTest2(Test& test)
+{
+    Test owner(TestNumber(1), "Owner");
+    RepeatedTestCase repeatedTest(owner);
+
+    bool passed = repeatedTest.check(
+        [](Test& test)
+        {
+            ISHIKO_TEST_FAIL_IF(true);
+            ISHIKO_TEST_FAIL_IF(true);
+            ISHIKO_TEST_PASS();
+        });
+
+    ISHIKO_TEST_FAIL_IF(passed);
+    ISHIKO_TEST_FAIL_IF(repeatedTest.failureMessage().empty());
+    ISHIKO_TEST_FAIL_IF_EQ(repeatedTest.failureLine(), 0);
+
+    // The failure of the previous run is forgotten
+    passed = repeatedTest.check(
+        [](Test& test)
+        {
+            ISHIKO_TEST_PASS();
+        });
+
+    ISHIKO_TEST_FAIL_IF_NOT(passed);
+    ISHIKO_TEST_FAIL_IF_NEQ(repeatedTest.failureMessage(), "");
+    ISHIKO_TEST_FAIL_IF_NEQ(repeatedTest.failureLine(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void RepeatedTestCaseTests::CheckTest3(Test& test)
+{
+    Test owner(TestNumber(1), "Owner");
+    RepeatedTestCase repeatedTest(owner);
+
+    bool passed = repeatedTest.check(
+        [](Test& test)
+        {
+            throw std::runtime_error("error");
+        });
+
+    ISHIKO_TEST_FAIL_IF(passed);
+    ISHIKO_TEST_FAIL_IF_NEQ(repeatedTest.result(), TestResult::exception);
+    ISHIKO_TEST_FAIL_IF_NEQ(repeatedTest.failureMessage(), "Exception thrown: error");
+    ISHIKO_TEST_FAIL_IF_NEQ(repeatedTest.failureLine(), 0);
+    ISHIKO_TEST_PASS();
+}
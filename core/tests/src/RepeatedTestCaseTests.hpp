@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_REPEATEDTESTCASETESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_REPEATEDTESTCASETESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class RepeatedTestCaseTests : public Ishiko::TestSequence
+{
+public:
+    RepeatedTestCaseTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void CheckTest1(Ishiko::Test& test);
+    static void CheckTest2(Ishiko::Test& test);
+    static void CheckTest3(Ishiko::Test& test);
+};
+
+#endif
@@ -0,0 +1,290 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "SharedFixtureTests.hpp"
+#include <stdexcept>
+#include <string>
+
+using namespace Ishiko;
+
+namespace
+{
+
+class CountingAction : public TestSetupAction, public TestTeardownAction
+{
+public:
+    void setup(const Test& test) override
+    {
+        ++m_setupCount;
+    }
+
+    void teardown() override
+    {
+        ++m_teardownCount;
+    }
+
+    int m_setupCount = 0;
+    int m_teardownCount = 0;
+};
+
+class FailingSetupAction : public TestSetupAction
+{
+public:
+    void setup(const Test& test) override
+    {
+        ++m_setupCount;
+        throw std::runtime_error("setup failed");
+    }
+
+    int m_setupCount = 0;
+};
+
+// Queries the fixture it belongs to from its actions
+class InspectingAction : public TestSetupAction, public TestTeardownAction
+{
+public:
+    void setup(const Test& test) override
+    {
+        m_setUpDuringSetup = m_fixture->isSetUp();
+    }
+
+    void teardown(const Test& test) override
+    {
+        m_remainingDependentCountDuringTeardown = m_fixture->remainingDependentCount();
+        m_teardownTestName = test.name();
+    }
+
+    SharedFixture* m_fixture = nullptr;
+    bool m_setUpDuringSetup = true;
+    size_t m_remainingDependentCountDuringTeardown = 1;
+    std::string m_teardownTestName;
+};
+
+}
+
+SharedFixtureTests::SharedFixtureTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "SharedFixture tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("TestSequence test 1", TestSequenceTest1);
+    append<HeapAllocationErrorsTest>("TestSequence test 2", TestSequenceTest2);
+    append<HeapAllocationErrorsTest>("TestSequence test 3", TestSequenceTest3);
+    append<HeapAllocationErrorsTest>("TestSequence test 4", TestSequenceTest4);
+    append<HeapAllocationErrorsTest>("setKeptSetUp test 1", SetKeptSetUpTest1);
+    append<HeapAllocationErrorsTest>("setup test 1", SetupTest1);
+    append<HeapAllocationErrorsTest>("setup test 2", SetupTest2);
+}
+
+void SharedFixtureTests::ConstructorTest1(Test& test)
+{
+    SharedFixture fixture("fixture", nullptr, nullptr);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(fixture.name(), "fixture");
+    ISHIKO_TEST_FAIL_IF_NEQ(fixture.dependentCount(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(fixture.remainingDependentCount(), 0);
+    ISHIKO_TEST_FAIL_IF(fixture.isSetUp());
+    ISHIKO_TEST_PASS();
+}
+
+void SharedFixtureTests::TestSequenceTest1(Test& test)
+{
+    std::shared_ptr<CountingAction> action = std::make_shared<CountingAction>();
+
+    TestContext context(&test.context());
+    context.setSharedFixtureRegistry(std::make_shared<SharedFixtureRegistry>());
+
+    TestSequence sequence(TestNumber(), "SharedFixtureTests_TestSequenceTest1", context);
+    for (int i = 0; i < 3; ++i)
+    {
+        Test& dependentTest = sequence.append<Test>("SharedFixtureTests_TestSequenceTest1_" + std::to_string(i),
+            [&action](Test& test)
+            {
+                ISHIKO_TEST_FAIL_IF_NEQ(action->m_setupCount, 1);
+                ISHIKO_TEST_FAIL_IF_NEQ(action->m_teardownCount, 0);
+                ISHIKO_TEST_PASS();
+            });
+        dependentTest.addSharedFixture("fixture", action, action);
+    }
+    sequence.run();
+
+    ISHIKO_TEST_FAIL_IF_NOT(sequence.passed());
+    ISHIKO_TEST_FAIL_IF_NEQ(action->m_setupCount, 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(action->m_teardownCount, 1);
+    ISHIKO_TEST_PASS();
+}
+
+void SharedFixtureTests::TestSequenceTest2(Test& test)
+{
+    std::shared_ptr<CountingAction> action = std::make_shared<CountingAction>();
+
+    // Without a registry each test gets its own fixture
+    TestContext context;
+
+    TestSequence sequence(TestNumber(), "SharedFixtureTests_TestSequenceTest2", context);
+    for (int i = 0; i < 3; ++i)
+    {
+        Test& dependentTest = sequence.append<Test>("SharedFixtureTests_TestSequenceTest2_" + std::to_string(i),
+            [](Test& test)
+            {
+                ISHIKO_TEST_PASS();
+            });
+        dependentTest.addSharedFixture("fixture", action, action);
+    }
+    sequence.run();
+
+    ISHIKO_TEST_FAIL_IF_NOT(sequence.passed());
+    ISHIKO_TEST_FAIL_IF_NEQ(action->m_setupCount, 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(action->m_teardownCount, 3);
+    ISHIKO_TEST_PASS();
+}
+
+void SharedFixtureTests::TestSequenceTest3(Test& test)
+{
+    std::shared_ptr<CountingAction> action = std::make_shared<CountingAction>();
+    std::shared_ptr<SharedFixtureRegistry> registry = std::make_shared<SharedFixtureRegistry>();
+
+    TestContext context(&test.context());
+    context.setSharedFixtureRegistry(registry);
+
+    // Only the first test is run so the fixture is still set up afterwards
+    Test dependentTest1(TestNumber(), "SharedFixtureTests_TestSequenceTest3_1",
+        [](Test& test)
+        {
+            ISHIKO_TEST_PASS();
+        },
+        context);
+    dependentTest1.addSharedFixture("fixture", action, action);
+    Test dependentTest2(TestNumber(), "SharedFixtureTests_TestSequenceTest3_2", TestResult::skipped, context);
+    dependentTest2.addSharedFixture("fixture", action, action);
+    dependentTest1.run();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(action->m_setupCount, 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(action->m_teardownCount, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(registry->find("fixture")->dependentCount(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(registry->find("fixture")->remainingDependentCount(), 1);
+
+    registry->teardownAll();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(action->m_teardownCount, 1);
+    ISHIKO_TEST_FAIL_IF(registry->find("fixture")->isSetUp());
+    ISHIKO_TEST_FAIL_IF_NEQ(registry->find("fixture")->remainingDependentCount(), 2);
+    ISHIKO_TEST_PASS();
+}
+
+void SharedFixtureTests::TestSequenceTest4(Test& test)
+{
+    std::shared_ptr<CountingAction> action = std::make_shared<CountingAction>();
+    std::shared_ptr<SharedFixtureRegistry> registry = std::make_shared<SharedFixtureRegistry>();
+
+    TestContext context(&test.context());
+    context.setSharedFixtureRegistry(registry);
+
+    // The sequence is run twice with a forced teardown in between, like the watch mode of TestHarness does
+    TestSequence sequence(TestNumber(), "SharedFixtureTests_TestSequenceTest4", context);
+    for (int i = 0; i < 2; ++i)
+    {
+        Test& dependentTest = sequence.append<Test>("SharedFixtureTests_TestSequenceTest4_" + std::to_string(i),
+            [](Test& test)
+            {
+                ISHIKO_TEST_PASS();
+            });
+        dependentTest.addSharedFixture("fixture", action, action);
+    }
+    sequence.run();
+    registry->teardownAll();
+    sequence.reset();
+    sequence.run();
+
+    ISHIKO_TEST_FAIL_IF_NOT(sequence.passed());
+    ISHIKO_TEST_FAIL_IF_NEQ(action->m_setupCount, 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(action->m_teardownCount, 2);
+    ISHIKO_TEST_PASS();
+}
+
+void SharedFixtureTests::SetKeptSetUpTest1(Test& test)
+{
+    std::shared_ptr<CountingAction> action = std::make_shared<CountingAction>();
+    std::shared_ptr<SharedFixtureRegistry> registry = std::make_shared<SharedFixtureRegistry>();
+    registry->setKeptSetUp(true);
+
+    TestContext context(&test.context());
+    context.setSharedFixtureRegistry(registry);
+
+    Test dependentTest(TestNumber(), "SharedFixtureTests_SetKeptSetUpTest1",
+        [](Test& test)
+        {
+            ISHIKO_TEST_PASS();
+        },
+        context);
+    dependentTest.addSharedFixture("fixture", action, action);
+    dependentTest.run();
+    dependentTest.reset();
+    dependentTest.run();
+
+    ISHIKO_TEST_FAIL_IF_NOT(dependentTest.passed());
+    ISHIKO_TEST_FAIL_IF_NEQ(action->m_setupCount, 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(action->m_teardownCount, 0);
+
+    registry->teardownAll();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(action->m_teardownCount, 1);
+    ISHIKO_TEST_PASS();
+}
+
+void SharedFixtureTests::SetupTest1(Test& test)
+{
+    std::shared_ptr<InspectingAction> action = std::make_shared<InspectingAction>();
+    SharedFixture fixture("fixture", action, action);
+    action->m_fixture = &fixture;
+
+    fixture.addDependent();
+    fixture.setup(test);
+
+    ISHIKO_TEST_FAIL_IF_NOT(fixture.isSetUp());
+
+    fixture.teardown(test);
+
+    ISHIKO_TEST_FAIL_IF(fixture.isSetUp());
+    ISHIKO_TEST_FAIL_IF(action->m_setUpDuringSetup);
+    ISHIKO_TEST_FAIL_IF_NEQ(action->m_remainingDependentCountDuringTeardown, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(action->m_teardownTestName, test.name());
+    ISHIKO_TEST_PASS();
+}
+
+void SharedFixtureTests::SetupTest2(Test& test)
+{
+    std::shared_ptr<FailingSetupAction> action = std::make_shared<FailingSetupAction>();
+    SharedFixture fixture("fixture", action, nullptr);
+    fixture.addDependent();
+    fixture.addDependent();
+
+    // The tests whose setup throws are not torn down so the fixture counts them as done when it throws
+    bool thrown = false;
+    for (int i = 0; i < 2; ++i)
+    {
+        try
+        {
+            fixture.setup(test);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(thrown);
+    ISHIKO_TEST_FAIL_IF_NEQ(action->m_setupCount, 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(fixture.remainingDependentCount(), 2);
+
+    // The failure is forgotten once all the dependents are done so the next run tries the setup again
+    try
+    {
+        fixture.setup(test);
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(action->m_setupCount, 2);
+    ISHIKO_TEST_PASS();
+}
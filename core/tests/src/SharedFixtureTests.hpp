@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_SHAREDFIXTURETESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_SHAREDFIXTURETESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class SharedFixtureTests : public Ishiko::TestSequence
+{
+public:
+    SharedFixtureTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void TestSequenceTest1(Ishiko::Test& test);
+    static void TestSequenceTest2(Ishiko::Test& test);
+    static void TestSequenceTest3(Ishiko::Test& test);
+    static void TestSequenceTest4(Ishiko::Test& test);
+    static void SetKeptSetUpTest1(Ishiko::Test& test);
+    static void SetupTest1(Ishiko::Test& test);
+    static void SetupTest2(Ishiko::Test& test);
+};
+
+#endif
@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "SummaryProgressObserverTests.hpp"
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace Ishiko;
+
+SummaryProgressObserverTests::SummaryProgressObserverTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "SummaryProgressObserver tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("run test 1", RunTest1);
+    append<HeapAllocationErrorsTest>("run test 2", RunTest2);
+}
+
+void SummaryProgressObserverTests::ConstructorTest1(Test& test)
+{
+    std::stringstream output;
+    SummaryProgressObserver observer(output, 3);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(observer.completedTestCases(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(observer.failedTestCases(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(output.str(), "");
+    ISHIKO_TEST_PASS();
+}
+
+void SummaryProgressObserverTests::RunTest1(Test& test)
+{
+    std::stringstream output;
+    std::shared_ptr<SummaryProgressObserver> observer = std::make_shared<SummaryProgressObserver>(output, 3);
+    observer->setRefreshInterval(std::chrono::hours(1));
+    {
+        TestSequence sequence(TestNumber(1), "Sequence");
+        sequence.append<Test>("Passing test",
+            [](Test& test)
+            {
+                ISHIKO_TEST_PASS();
+            });
+        sequence.append<Test>("Failing test",
+            [](Test& test)
+            {
+                ISHIKO_TEST_FAIL_IF_NEQ(1, 2);
+            });
+        sequence.append<Test>("Skipped test",
+            [](Test& test)
+            {
+                ISHIKO_TEST_SKIP();
+            });
+        sequence.observers().add(observer);
+
+        sequence.run();
+        observer->endRun();
+    }
+
+    std::string line1;
+    std::string line2;
+    std::string line3;
+    std::string line4;
+    std::getline(output, line1);
+    std::getline(output, line2);
+    std::getline(output, line3);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(observer->completedTestCases(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(observer->failedTestCases(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(line1, "1.2. Failing test: failed");
+    ISHIKO_TEST_FAIL_IF_NEQ(line2.find("    ISHIKO_TEST_FAIL_IF_NEQ(1, 2)"), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(line3.find("3/3 tests, "), 0);
+    ISHIKO_TEST_FAIL_IF_EQ(line3.find(" tests/s, ETA 0s, 1 failure"), std::string::npos);
+    ISHIKO_TEST_FAIL_IF(std::getline(output, line4));
+    ISHIKO_TEST_PASS();
+}
+
+void SummaryProgressObserverTests::RunTest2(Test& test)
+{
+    std::stringstream output;
+    std::shared_ptr<SummaryProgressObserver> observer = std::make_shared<SummaryProgressObserver>(output);
+    observer->setRefreshInterval(std::chrono::milliseconds(0));
+    {
+        TestSequence sequence(TestNumber(1), "Sequence");
+        sequence.append<Test>("Passing test 1",
+            [](Test& test)
+            {
+                ISHIKO_TEST_PASS();
+            });
+        sequence.append<Test>("Passing test 2",
+            [](Test& test)
+            {
+                ISHIKO_TEST_PASS();
+            });
+        sequence.observers().add(observer);
+
+        sequence.run();
+        observer->endRun();
+    }
+
+    // The progress line is refreshed in place after each test and once more at the end
+    std::string text = output.str();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(text.find("1 tests, "), 0);
+    ISHIKO_TEST_FAIL_IF_EQ(text.find("\r2 tests, "), std::string::npos);
+    ISHIKO_TEST_FAIL_IF_NEQ(text.find('\n'), text.size() - 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(text.substr(text.rfind('\r') + 1).find("2 tests, "), 0);
+    ISHIKO_TEST_FAIL_IF_EQ(text.find(" tests/s, 0 failures\n"), std::string::npos);
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "TAPReporterTests.hpp"
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Ishiko;
+
+TAPReporterTests::TAPReporterTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "TAPReporter tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("run test 1", RunTest1);
+    append<HeapAllocationErrorsTest>("run test 2", RunTest2);
+    append<HeapAllocationErrorsTest>("run test 3", RunTest3);
+}
+
+void TAPReporterTests::ConstructorTest1(Test& test)
+{
+    std::stringstream output;
+    TAPReporter reporter(output);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(output.str(), "");
+    ISHIKO_TEST_PASS();
+}
+
+void TAPReporterTests::RunTest1(Test& test)
+{
+    std::stringstream output;
+    {
+        TestSequence sequence(TestNumber(1), "Sequence");
+        sequence.append<Test>("Passing test",
+            [](Test& test)
+            {
+                ISHIKO_TEST_PASS();
+            });
+        sequence.append<Test>("Failing test",
+            [](Test& test)
+            {
+                ISHIKO_TEST_FAIL_IF_NEQ(1, 2);
+            });
+        sequence.append<Test>("Skipped test",
+            [](Test& test)
+            {
+                ISHIKO_TEST_SKIP();
+            });
+        std::shared_ptr<TAPReporter> reporter = std::make_shared<TAPReporter>(output);
+        sequence.observers().add(reporter);
+
+        sequence.run();
+        reporter->endRun();
+    }
+
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(output, line))
+    {
+        lines.push_back(line);
+    }
+
+    ISHIKO_TEST_ABORT_IF_NEQ(lines.size(), 17);
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[0], "TAP version 13");
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[1], "ok 1 - Passing test");
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[2], "  ---");
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[3].find("  duration_ms: "), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[4], "  ...");
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[5], "not ok 2 - Failing test");
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[6], "  ---");
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[7].find("  duration_ms: "), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[8], "  failures:");
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[9].find("    - message: \"ISHIKO_TEST_FAIL_IF_NEQ(1, 2)"), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[10].find("      at: \""), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[11], "  ...");
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[12], "ok 3 - Skipped test # SKIP");
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[13], "  ---");
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[14].find("  duration_ms: "), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[15], "  ...");
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[16], "1..3");
+    ISHIKO_TEST_PASS();
+}
+
+void TAPReporterTests::RunTest2(Test& test)
+{
+    std::stringstream output;
+    {
+        // A test that never ran has an unknown result, it is reported as a plain failure
+        Test unknownTest(TestNumber(1), "Unknown test");
+        TAPReporter reporter(output);
+        reporter.onLifecycleEvent(unknownTest, Test::Observer::test_start);
+        reporter.onLifecycleEvent(unknownTest, Test::Observer::test_end);
+        reporter.endRun();
+    }
+
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(output, line))
+    {
+        lines.push_back(line);
+    }
+
+    ISHIKO_TEST_ABORT_IF_NEQ(lines.size(), 6);
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[0], "TAP version 13");
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[1], "not ok 1 - Unknown test");
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[2], "  ---");
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[3].find("  duration_ms: "), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[4], "  ...");
+    ISHIKO_TEST_FAIL_IF_NEQ(lines[5], "1..1");
+    ISHIKO_TEST_PASS();
+}
+
+void TAPReporterTests::RunTest3(Test& test)
+{
+    std::stringstream output;
+    {
+        // Without escaping the test would be reported as skipped
+        Test passingTest(TestNumber(1), "Case #1 \\ # SKIP", TestResult::passed);
+        TAPReporter reporter(output);
+        reporter.onLifecycleEvent(passingTest, Test::Observer::test_start);
+        reporter.onLifecycleEvent(passingTest, Test::Observer::test_end);
+        reporter.endRun();
+    }
+
+    std::string line;
+    std::getline(output, line);
+    std::getline(output, line);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(line, "ok 1 - Case \\#1 \\\\ \\# SKIP");
+    ISHIKO_TEST_PASS();
+}
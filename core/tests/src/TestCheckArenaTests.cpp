@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "TestCheckArenaTests.hpp"
+#include <string>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+
+class CountingTestCheck : public TestCheck
+{
+public:
+    CountingTestCheck(int& destroyedCount)
+        : m_destroyedCount(destroyedCount)
+    {
+    }
+
+    ~CountingTestCheck() override
+    {
+        ++m_destroyedCount;
+    }
+
+    void run(Test& test, const char* file, int line) override
+    {
+        m_result = Result::passed;
+    }
+
+private:
+    int& m_destroyedCount;
+};
+
+}
+
+TestCheckArenaTests::TestCheckArenaTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "TestCheckArena tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("create test 1", CreateTest1);
+    append<HeapAllocationErrorsTest>("clear test 1", ClearTest1);
+}
+
+void TestCheckArenaTests::ConstructorTest1(Test& test)
+{
+    TestCheckArena arena;
+
+    ISHIKO_TEST_FAIL_IF_NEQ(arena.size(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void TestCheckArenaTests::CreateTest1(Test& test)
+{
+    TestCheckArena arena;
+
+    // Enough checks to need several blocks
+    std::vector<FileComparisonTestCheck*> checks;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        checks.push_back(&arena.create<FileComparisonTestCheck>("output" + std::to_string(i),
+            "reference" + std::to_string(i)));
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(arena.size(), 100);
+    for (size_t i = 0; i < checks.size(); ++i)
+    {
+        ISHIKO_TEST_FAIL_IF_NEQ(checks[i]->outputFilePath(), "output" + std::to_string(i));
+        ISHIKO_TEST_FAIL_IF_NEQ(checks[i]->referenceFilePath(), "reference" + std::to_string(i));
+    }
+    ISHIKO_TEST_PASS();
+}
+
+void TestCheckArenaTests::ClearTest1(Test& test)
+{
+    int destroyedCount = 0;
+    TestCheckArena arena;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        arena.create<CountingTestCheck>(destroyedCount);
+    }
+    arena.clear();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(destroyedCount, 1000);
+    ISHIKO_TEST_FAIL_IF_NEQ(arena.size(), 0);
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_TESTCHECKARENATESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_TESTCHECKARENATESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class TestCheckArenaTests : public Ishiko::TestSequence
+{
+public:
+    TestCheckArenaTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void CreateTest1(Ishiko::Test& test);
+    static void ClearTest1(Ishiko::Test& test);
+};
+
+#endif
@@ -5,7 +5,11 @@
 */
 
 #include "TestContextTests.hpp"
+#include <boost/filesystem.hpp>
 #include <Ishiko/Process.hpp>
+#include <fstream>
+#include <thread>
+#include <vector>
 
 using namespace Ishiko;
 
@@ -15,6 +19,8 @@ TestContextTests::TestContextTests(const TestNumber& number, const TestContext&
     append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
     append<HeapAllocationErrorsTest>("Constructor test 2", ConstructorTest2);
     append<HeapAllocationErrorsTest>("Constructor test 3", ConstructorTest3);
+    append<HeapAllocationErrorsTest>("Copy constructor test 1", CopyConstructorTest1);
+    append<HeapAllocationErrorsTest>("Move assignment operator test 1", MoveAssignmentOperatorTest1);
     append<HeapAllocationErrorsTest>("getTestDataDirectory test 1", GetTestDataDirectoryTest1);
     append<HeapAllocationErrorsTest>("getTestDataDirectory test 2", GetTestDataDirectoryTest2);
     append<HeapAllocationErrorsTest>("getTestDataDirectory test 3", GetTestDataDirectoryTest3);
@@ -29,11 +35,16 @@ TestContextTests::TestContextTests(const TestNumber& number, const TestContext&
     append<HeapAllocationErrorsTest>("getReferenceDataPath test 3", GetReferenceDataPathTest3);
     append<HeapAllocationErrorsTest>("getReferenceDataPath test 4", GetReferenceDataPathTest4);
     append<HeapAllocationErrorsTest>("getReferenceDataPath test 5", GetReferenceDataPathTest5);
+    append<HeapAllocationErrorsTest>("getReferenceDataPath test 6", GetReferenceDataPathTest6);
     append<HeapAllocationErrorsTest>("setReferenceDataDirectory test 1", SetReferenceDataDirectoryTest1);
     append<HeapAllocationErrorsTest>("getTestOutputDirectory test 1", GetTestOutputDirectoryTest1);
     append<HeapAllocationErrorsTest>("getTestOutputDirectory test 2", GetTestOutputDirectoryTest2);
+    append<HeapAllocationErrorsTest>("getTestOutputDirectory test 3", GetTestOutputDirectoryTest3);
+    append<HeapAllocationErrorsTest>("getTestOutputDirectory test 4", GetTestOutputDirectoryTest4);
     append<HeapAllocationErrorsTest>("getTestOutputPath test 1", GetTestOutputPathTest1);
     append<HeapAllocationErrorsTest>("setTestOutputDirectory test 1", SetTestOutputDirectoryTest1);
+    append<HeapAllocationErrorsTest>("isolateOutputDirectory test 1", IsolateOutputDirectoryTest1);
+    append<HeapAllocationErrorsTest>("isolateOutputDirectory test 2", IsolateOutputDirectoryTest2);
 }
 
 void TestContextTests::ConstructorTest1(Test& test)
@@ -72,6 +83,43 @@ void TestContextTests::ConstructorTest3(Test& test)
     ISHIKO_TEST_PASS();
 }
 
+void TestContextTests::CopyConstructorTest1(Test& test)
+{
+    TestContext parentContext;
+    parentContext.setDataDirectory("data");
+    parentContext.setReferenceDirectory("referenceData");
+    parentContext.setOutputDirectory("output");
+    TestContext context(&parentContext);
+    context.setOutputDirectory("subdirectory");
+    context.getOutputDirectory();
+
+    TestContext copy(context);
+    context.setOutputDirectory("other");
+
+    ISHIKO_TEST_FAIL_IF_NEQ(copy.getDataDirectory(), "data");
+    ISHIKO_TEST_FAIL_IF_NEQ(copy.getOutputDirectory(), "output/subdirectory");
+    ISHIKO_TEST_FAIL_IF_NEQ(context.getOutputDirectory(), "output/other");
+    ISHIKO_TEST_PASS();
+}
+
+void TestContextTests::MoveAssignmentOperatorTest1(Test& test)
+{
+    TestContext parentContext;
+    parentContext.setOutputDirectory("output");
+    TestContext context(&parentContext);
+    context.setOutputDirectory("subdirectory");
+
+    ISHIKO_TEST_ABORT_IF_NEQ(context.getOutputDirectory(), "output/subdirectory");
+
+    // The child context cached a path resolved with the settings its parent had before the assignment
+    TestContext other;
+    other.setOutputDirectory("other");
+    parentContext = std::move(other);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(context.getOutputDirectory(), "other/subdirectory");
+    ISHIKO_TEST_PASS();
+}
+
 void TestContextTests::GetTestDataDirectoryTest1(Test& test)
 {
     TestContext context;
@@ -275,6 +323,42 @@ void TestContextTests::GetReferenceDataPathTest5(Test& test)
     ISHIKO_TEST_PASS();
 }
 
+void TestContextTests::GetReferenceDataPathTest6(Test& test)
+{
+    boost::filesystem::path referenceDirectory =
+        test.context().getOutputPath("TestContextTests_GetReferenceDataPathTest6");
+    boost::filesystem::remove_all(referenceDirectory);
+    boost::filesystem::create_directories(referenceDirectory);
+
+    TestContext context;
+    context.setReferenceDirectory(referenceDirectory);
+
+    boost::filesystem::path referencePath1 =
+        context.getReferencePath("file.txt", TestContext::PathResolution::platform_specific);
+
+    // The platform specific file is only found once the cache has been cleared
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    boost::filesystem::path platformSpecificPath = referenceDirectory / "file.linux.txt";
+#elif ISHIKO_OS == ISHIKO_OS_WINDOWS
+    boost::filesystem::path platformSpecificPath = referenceDirectory / "file.windows.txt";
+#elif ISHIKO_OS ISHIKO_OS_CYGWIN
+    boost::filesystem::path platformSpecificPath = referenceDirectory / "file.cygwin.txt";
+#else
+    #error Unsupported or unrecognized OS
+#endif
+    std::ofstream(platformSpecificPath.string()) << "reference";
+    boost::filesystem::path referencePath2 =
+        context.getReferencePath("file.txt", TestContext::PathResolution::platform_specific);
+    context.clearPathCache();
+    boost::filesystem::path referencePath3 =
+        context.getReferencePath("file.txt", TestContext::PathResolution::platform_specific);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(referencePath1, referenceDirectory / "file.txt");
+    ISHIKO_TEST_FAIL_IF_NEQ(referencePath2, referenceDirectory / "file.txt");
+    ISHIKO_TEST_FAIL_IF_NEQ(referencePath3, platformSpecificPath);
+    ISHIKO_TEST_PASS();
+}
+
 void TestContextTests::SetReferenceDataDirectoryTest1(Test& test)
 {
     TestContext parentContext;
@@ -311,6 +395,55 @@ void TestContextTests::GetTestOutputDirectoryTest2(Test& test)
     ISHIKO_TEST_PASS();
 }
 
+void TestContextTests::GetTestOutputDirectoryTest3(Test& test)
+{
+    TestContext parentContext;
+    parentContext.setOutputDirectory("parent");
+    TestContext context(&parentContext);
+    context.setOutputDirectory("output");
+
+    boost::filesystem::path directory1 = context.getOutputDirectory();
+    parentContext.setOutputDirectory("other");
+    boost::filesystem::path directory2 = context.getOutputDirectory();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(directory1, "parent/output");
+    ISHIKO_TEST_FAIL_IF_NEQ(directory2, "other/output");
+    ISHIKO_TEST_PASS();
+}
+
+void TestContextTests::GetTestOutputDirectoryTest4(Test& test)
+{
+    TestContext parentContext;
+    parentContext.setOutputDirectory("parent");
+    TestContext context(&parentContext);
+    context.setOutputDirectory("output");
+
+    // The first calls race to create the cache of the context
+    std::vector<boost::filesystem::path> directories(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < directories.size(); ++i)
+    {
+        threads.emplace_back(
+            [&context, &directories, i]()
+            {
+                for (int j = 0; j < 100; ++j)
+                {
+                    directories[i] = context.getOutputDirectory();
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const boost::filesystem::path& directory : directories)
+    {
+        ISHIKO_TEST_FAIL_IF_NEQ(directory, "parent/output");
+    }
+    ISHIKO_TEST_PASS();
+}
+
 void TestContextTests::GetTestOutputPathTest1(Test& test)
 {
     TestContext context;
@@ -334,3 +467,31 @@ void TestContextTests::SetTestOutputDirectoryTest1(Test& test)
     ISHIKO_TEST_FAIL_IF_NEQ(context.getOutputDirectory(), "parent/output");
     ISHIKO_TEST_PASS();
 }
+
+void TestContextTests::IsolateOutputDirectoryTest1(Test& test)
+{
+    TestContext parentContext;
+    parentContext.setOutputDirectory("parent");
+    parentContext.setIsolatedOutputDirectories(true);
+
+    TestContext context(&parentContext);
+    context.isolateOutputDirectory("1.2");
+
+    ISHIKO_TEST_FAIL_IF_NOT(context.isolatedOutputDirectories());
+    ISHIKO_TEST_FAIL_IF_NEQ(context.getOutputDirectory(), "parent/1.2");
+    ISHIKO_TEST_FAIL_IF_NEQ(context.getOutputPath("file"), "parent/1.2/file");
+    ISHIKO_TEST_PASS();
+}
+
+void TestContextTests::IsolateOutputDirectoryTest2(Test& test)
+{
+    TestContext parentContext;
+    parentContext.setOutputDirectory("parent");
+
+    TestContext context(&parentContext);
+    context.isolateOutputDirectory("1.2");
+
+    ISHIKO_TEST_FAIL_IF(context.isolatedOutputDirectories());
+    ISHIKO_TEST_FAIL_IF_NEQ(context.getOutputDirectory(), "parent");
+    ISHIKO_TEST_PASS();
+}
@@ -18,6 +18,8 @@ private:
     static void ConstructorTest1(Ishiko::Test& test);
     static void ConstructorTest2(Ishiko::Test& test);
     static void ConstructorTest3(Ishiko::Test& test);
+    static void CopyConstructorTest1(Ishiko::Test& test);
+    static void MoveAssignmentOperatorTest1(Ishiko::Test& test);
     static void GetTestDataDirectoryTest1(Ishiko::Test& test);
     static void GetTestDataDirectoryTest2(Ishiko::Test& test);
     static void GetTestDataDirectoryTest3(Ishiko::Test& test);
@@ -32,11 +34,16 @@ private:
     static void GetReferenceDataPathTest3(Ishiko::Test& test);
     static void GetReferenceDataPathTest4(Ishiko::Test& test);
     static void GetReferenceDataPathTest5(Ishiko::Test& test);
+    static void GetReferenceDataPathTest6(Ishiko::Test& test);
     static void SetReferenceDataDirectoryTest1(Ishiko::Test& test);
     static void GetTestOutputDirectoryTest1(Ishiko::Test& test);
     static void GetTestOutputDirectoryTest2(Ishiko::Test& test);
+    static void GetTestOutputDirectoryTest3(Ishiko::Test& test);
+    static void GetTestOutputDirectoryTest4(Ishiko::Test& test);
     static void GetTestOutputPathTest1(Ishiko::Test& test);
     static void SetTestOutputDirectoryTest1(Ishiko::Test& test);
+    static void IsolateOutputDirectoryTest1(Ishiko::Test& test);
+    static void IsolateOutputDirectoryTest2(Ishiko::Test& test);
 };
 
 #endif
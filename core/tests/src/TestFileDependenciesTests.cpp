@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "TestFileDependenciesTests.hpp"
+#include <memory>
+
+using namespace Ishiko;
+
+TestFileDependenciesTests::TestFileDependenciesTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "TestFileDependencies tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("findAffectedTests test 1", FindAffectedTestsTest1);
+    append<HeapAllocationErrorsTest>("findAffectedTests test 2", FindAffectedTestsTest2);
+}
+
+void TestFileDependenciesTests::ConstructorTest1(Test& test)
+{
+    TestFileDependencies dependencies;
+
+    ISHIKO_TEST_FAIL_IF_NEQ(dependencies.findAffectedTests({ "data/file.txt" }).size(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void TestFileDependenciesTests::FindAffectedTestsTest1(Test& test)
+{
+    std::shared_ptr<TestFileDependencies> dependencies = std::make_shared<TestFileDependencies>();
+    TestContext context;
+    context.setDataDirectory("data");
+    context.setFileDependencies(dependencies);
+
+    // Like in TestHarness the tests are in a TopTestSequence so that its children are the outermost tests
+    TopTestSequence tests("tests", context);
+    tests.observers().add(dependencies);
+    TestSequence& sequence = tests.append<TestSequence>("sequence");
+    sequence.append<Test>("test",
+        [](Test& test)
+        {
+            test.context().getDataPath("file1.txt");
+            test.setResult(TestResult::passed);
+        });
+    Test& directoryTest = tests.append<Test>("directory test",
+        [](Test& test)
+        {
+            test.context().getDataPath("directory");
+            test.setResult(TestResult::passed);
+        });
+    tests.append<Test>("test that uses no files", TestResult::passed);
+    tests.run();
+
+    std::vector<Test*> affectedTests1 = dependencies->findAffectedTests({ "data/file1.txt" });
+    std::vector<Test*> affectedTests2 = dependencies->findAffectedTests({ "data/directory/file2.txt" });
+    std::vector<Test*> affectedTests3 = dependencies->findAffectedTests({ "data/file3.txt", "data" });
+
+    ISHIKO_TEST_ABORT_IF_NEQ(affectedTests1.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(affectedTests1[0], &sequence);
+    ISHIKO_TEST_ABORT_IF_NEQ(affectedTests2.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(affectedTests2[0], &directoryTest);
+    ISHIKO_TEST_FAIL_IF_NEQ(affectedTests3.size(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void TestFileDependenciesTests::FindAffectedTestsTest2(Test& test)
+{
+    std::shared_ptr<TestFileDependencies> dependencies = std::make_shared<TestFileDependencies>();
+    TestContext context;
+    context.setDataDirectory("data");
+    context.setFileDependencies(dependencies);
+
+    TopTestSequence tests("tests", context);
+    tests.observers().add(dependencies);
+    size_t runCount = 0;
+    Test& fileTest = tests.append<Test>("test",
+        [&runCount](Test& test)
+        {
+            ++runCount;
+            test.context().getDataPath((runCount == 1) ? "file1.txt" : "file2.txt");
+            test.setResult(TestResult::passed);
+        });
+    tests.run();
+
+    fileTest.reset();
+    fileTest.run();
+
+    std::vector<Test*> affectedTests1 = dependencies->findAffectedTests({ "data/file1.txt" });
+    std::vector<Test*> affectedTests2 = dependencies->findAffectedTests({ "data/file2.txt" });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(runCount, 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(affectedTests1.size(), 0);
+    ISHIKO_TEST_ABORT_IF_NEQ(affectedTests2.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(affectedTests2[0], &fileTest);
+    ISHIKO_TEST_FAIL_IF_NOT(fileTest.passed());
+    ISHIKO_TEST_PASS();
+}
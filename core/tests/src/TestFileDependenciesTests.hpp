@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_TESTFILEDEPENDENCIESTESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_TESTFILEDEPENDENCIESTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class TestFileDependenciesTests : public Ishiko::TestSequence
+{
+public:
+    TestFileDependenciesTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void FindAffectedTestsTest1(Ishiko::Test& test);
+    static void FindAffectedTestsTest2(Ishiko::Test& test);
+};
+
+#endif
@@ -11,6 +11,20 @@
 
 using namespace Ishiko;
 
+namespace
+{
+
+void RegisteredFunction(Test& test)
+{
+    ISHIKO_TEST_PASS();
+}
+
+// The macros always use the default registry, which the harnesses of these tests must not pick up
+TestRegistry registry;
+TestRegistry::Entry functionEntry(registry, "RegisteredFunction", "file.cpp", 10, &RegisteredFunction);
+
+}
+
 TestHarnessTests::TestHarnessTests(const TestNumber& number, const TestContext& context)
     : TestSequence(number, "TestHarness tests", context)
 {
@@ -20,6 +34,9 @@ TestHarnessTests::TestHarnessTests(const TestNumber& number, const TestContext&
     append<HeapAllocationErrorsTest>("run test 2", RunTest2);
     append<HeapAllocationErrorsTest>("run test 3", RunTest3);
     append<HeapAllocationErrorsTest>("run test 4", RunTest4);
+    append<HeapAllocationErrorsTest>("run test 5", RunTest5);
+    append<HeapAllocationErrorsTest>("run test 6", RunTest6);
+    append<HeapAllocationErrorsTest>("run test 7", RunTest7);
     append<HeapAllocationErrorsTest>("JUnit XML test report test 1", JUnitXMLReportTest1);
     append<HeapAllocationErrorsTest>("JUnit XML test report test 2", JUnitXMLReportTest2);
     append<HeapAllocationErrorsTest>("JUnit XML test report test 3", JUnitXMLReportTest3);
@@ -96,6 +113,57 @@ void TestHarnessTests::RunTest4(Test& test)
     ISHIKO_TEST_PASS();
 }
 
+void TestHarnessTests::RunTest5(Test& test)
+{
+    Configuration configuration = TestHarness::CommandLineSpecification().createDefaultConfiguration();
+    configuration.set("child-process-pool-size", "four");
+    TestHarness theTestHarness("TestHarnessTests_RunTest5", configuration);
+
+    std::shared_ptr<Test> test1 = std::make_shared<Test>(TestNumber(1), "Test", TestResult::passed);
+    theTestHarness.tests().append(test1);
+
+    int returnCode = theTestHarness.run();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(returnCode, TestApplicationReturnCode::configurationProblem);
+    ISHIKO_TEST_PASS();
+}
+
+void TestHarnessTests::RunTest6(Test& test)
+{
+    Configuration configuration = TestHarness::CommandLineSpecification().createDefaultConfiguration();
+    configuration.set("background-deleter-thread-count", "-1");
+    TestHarness theTestHarness("TestHarnessTests_RunTest6", configuration);
+
+    std::shared_ptr<Test> test1 = std::make_shared<Test>(TestNumber(1), "Test", TestResult::passed);
+    theTestHarness.tests().append(test1);
+
+    int returnCode = theTestHarness.run();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(returnCode, TestApplicationReturnCode::configurationProblem);
+    ISHIKO_TEST_PASS();
+}
+
+void TestHarnessTests::RunTest7(Test& test)
+{
+    TestHarness theTestHarness("TestHarnessTests_RunTest7");
+    theTestHarness.setTestRegistry(&registry);
+
+    std::shared_ptr<Test> test1 = std::make_shared<Test>(TestNumber(1), "Test", TestResult::passed);
+    theTestHarness.tests().append(test1);
+
+    int returnCode1 = theTestHarness.run();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(returnCode1, TestApplicationReturnCode::ok);
+    ISHIKO_TEST_FAIL_IF_NEQ(theTestHarness.tests().size(), 2);
+
+    // The registered tests are only appended once
+    int returnCode2 = theTestHarness.run();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(returnCode2, TestApplicationReturnCode::ok);
+    ISHIKO_TEST_FAIL_IF_NEQ(theTestHarness.tests().size(), 2);
+    ISHIKO_TEST_PASS();
+}
+
 void TestHarnessTests::JUnitXMLReportTest1(Test& test)
 {
     boost::filesystem::path outputPath = test.context().getOutputPath("TestHarnessTests_JUnitXMLReportTest1.xml");
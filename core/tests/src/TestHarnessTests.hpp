@@ -21,6 +21,9 @@ private:
     static void RunTest2(Ishiko::Test& test);
     static void RunTest3(Ishiko::Test& test);
     static void RunTest4(Ishiko::Test& test);
+    static void RunTest5(Ishiko::Test& test);
+    static void RunTest6(Ishiko::Test& test);
+    static void RunTest7(Ishiko::Test& test);
     static void JUnitXMLReportTest1(Ishiko::Test& test);
     static void JUnitXMLReportTest2(Ishiko::Test& test);
     static void JUnitXMLReportTest3(Ishiko::Test& test);
@@ -5,6 +5,7 @@
 */
 
 #include "TestNumberTests.hpp"
+#include <unordered_set>
 
 using namespace Ishiko;
 
@@ -14,6 +15,10 @@ TestNumberTests::TestNumberTests(const TestNumber& number, const TestContext& co
     append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
     append<HeapAllocationErrorsTest>("Constructor test 2", ConstructorTest2);
     append<HeapAllocationErrorsTest>("getDeeperNumber test 1", GetDeeperNumberTest1);
+    append<HeapAllocationErrorsTest>("getDeeperNumber test 2", GetDeeperNumberTest2);
+    append<HeapAllocationErrorsTest>("operator++ test 1", IncrementTest1);
+    append<HeapAllocationErrorsTest>("operator< test 1", LessThanOperatorTest1);
+    append<HeapAllocationErrorsTest>("hash test 1", HashTest1);
 }
 
 void TestNumberTests::ConstructorTest1(Test& test)
@@ -42,3 +47,54 @@ void TestNumberTests::GetDeeperNumberTest1(Test& test)
     ISHIKO_TEST_FAIL_IF_NEQ(deeperNumber.part(0), 1);
     ISHIKO_TEST_PASS();
 }
+
+void TestNumberTests::GetDeeperNumberTest2(Test& test)
+{
+    // Go deep enough to exceed the inline storage
+    TestNumber number(3);
+    for (int i = 0; i < 10; ++i)
+    {
+        number = (++number).getDeeperNumber();
+    }
+    TestNumber copy = number;
+
+    ISHIKO_TEST_FAIL_IF_NEQ(number.depth(), 11);
+    ISHIKO_TEST_FAIL_IF_NEQ(number.part(0), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(number.part(1), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(number.part(10), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(copy, number);
+    ISHIKO_TEST_PASS();
+}
+
+void TestNumberTests::IncrementTest1(Test& test)
+{
+    TestNumber number(1, 2);
+    TestNumber previousNumber = number++;
+
+    ISHIKO_TEST_FAIL_IF_NEQ(previousNumber, TestNumber(1, 2));
+    ISHIKO_TEST_FAIL_IF_NEQ(number, TestNumber(1, 3));
+    ISHIKO_TEST_PASS();
+}
+
+void TestNumberTests::LessThanOperatorTest1(Test& test)
+{
+    ISHIKO_TEST_FAIL_IF_NOT(TestNumber(1) < TestNumber(2));
+    ISHIKO_TEST_FAIL_IF_NOT(TestNumber(1) < TestNumber(1, 1));
+    ISHIKO_TEST_FAIL_IF_NOT(TestNumber(1, 9) < TestNumber(2, 1));
+    ISHIKO_TEST_FAIL_IF(TestNumber(1, 1) < TestNumber(1, 1));
+    ISHIKO_TEST_FAIL_IF(TestNumber(2) < TestNumber(1, 1));
+    ISHIKO_TEST_PASS();
+}
+
+void TestNumberTests::HashTest1(Test& test)
+{
+    std::unordered_set<TestNumber> numbers;
+    numbers.insert(TestNumber(1, 2));
+    numbers.insert(TestNumber(2, 1));
+    numbers.insert(TestNumber(1).getDeeperNumber());
+
+    ISHIKO_TEST_FAIL_IF_NEQ(TestNumber(1, 2).hash(), TestNumber(1, 2).hash());
+    ISHIKO_TEST_FAIL_IF_NEQ(numbers.size(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(numbers.count(TestNumber(1, 1)), 1);
+    ISHIKO_TEST_PASS();
+}
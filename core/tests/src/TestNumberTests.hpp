@@ -18,6 +18,10 @@ private:
     static void ConstructorTest1(Ishiko::Test& test);
     static void ConstructorTest2(Ishiko::Test& test);
     static void GetDeeperNumberTest1(Ishiko::Test& test);
+    static void GetDeeperNumberTest2(Ishiko::Test& test);
+    static void IncrementTest1(Ishiko::Test& test);
+    static void LessThanOperatorTest1(Ishiko::Test& test);
+    static void HashTest1(Ishiko::Test& test);
 };
 
 #endif
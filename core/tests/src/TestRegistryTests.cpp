@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "TestRegistryTests.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+
+class RegisteredSequence : public TestSequence
+{
+public:
+    RegisteredSequence(const TestNumber& number, const TestContext& context)
+        : TestSequence(number, "RegisteredSequence", context)
+    {
+        append<Test>("test 1", TestResult::passed);
+        append<Test>("test 2", TestResult::passed);
+    }
+};
+
+void RegisteredFunction(Test& test)
+{
+    ISHIKO_TEST_PASS();
+}
+
+// The macros always use the default registry so the entries are defined explicitly to keep these tests out of the
+// harness. They are registered in the reverse order of their line numbers to check the sorting.
+TestRegistry registry;
+TestRegistry::Entry functionEntry(registry, "RegisteredFunction", "file.cpp", 20, &RegisteredFunction);
+TestRegistry::Entry sequenceEntry(registry, "RegisteredSequence", "file.cpp", 10,
+    &TestRegistry::CreateTest<RegisteredSequence>);
+
+}
+
+// This sequence isn't appended in main, it is run because it is registered with the default registry
+ISHIKO_TEST_REGISTER(TestRegistryTests);
+
+ISHIKO_TEST_CASE("TestRegistry macro test 1")
+{
+    ISHIKO_TEST_PASS();
+}
+
+TestRegistryTests::TestRegistryTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "TestRegistry tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("entries test 1", EntriesTest1);
+    append<HeapAllocationErrorsTest>("appendTo test 1", AppendToTest1);
+    append<HeapAllocationErrorsTest>("DefaultTestRegistry test 1", DefaultTestRegistryTest1);
+}
+
+void TestRegistryTests::ConstructorTest1(Test& test)
+{
+    TestRegistry emptyRegistry;
+
+    ISHIKO_TEST_FAIL_IF_NEQ(emptyRegistry.size(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(emptyRegistry.entries().size(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void TestRegistryTests::EntriesTest1(Test& test)
+{
+    std::vector<const TestRegistry::Entry*> entries = registry.entries();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(registry.size(), 2);
+    ISHIKO_TEST_ABORT_IF_NEQ(entries.size(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(std::string(entries[0]->name()), "RegisteredSequence");
+    ISHIKO_TEST_FAIL_IF_NEQ(entries[0]->line(), 10);
+    ISHIKO_TEST_FAIL_IF_NEQ(std::string(entries[1]->name()), "RegisteredFunction");
+    ISHIKO_TEST_FAIL_IF_NEQ(std::string(entries[1]->file()), "file.cpp");
+    ISHIKO_TEST_PASS();
+}
+
+void TestRegistryTests::AppendToTest1(Test& test)
+{
+    TestSequence sequence(TestNumber(1), "Sequence");
+    registry.appendTo(sequence);
+
+    ISHIKO_TEST_ABORT_IF_NEQ(sequence.size(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(sequence[0].name(), "RegisteredSequence");
+    ISHIKO_TEST_FAIL_IF_NEQ(sequence[0].number(), TestNumber(1, 1));
+    ISHIKO_TEST_FAIL_IF_NEQ(sequence[0].childCount(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(sequence[1].name(), "RegisteredFunction");
+    ISHIKO_TEST_FAIL_IF_NEQ(sequence[1].number(), TestNumber(1, 2));
+
+    sequence.run();
+
+    ISHIKO_TEST_FAIL_IF_NOT(sequence.passed());
+    ISHIKO_TEST_PASS();
+}
+
+void TestRegistryTests::DefaultTestRegistryTest1(Test& test)
+{
+    std::vector<const TestRegistry::Entry*> entries;
+    for (const TestRegistry::Entry* entry : TestRegistry::DefaultTestRegistry().entries())
+    {
+        if (std::string(entry->file()) == __FILE__)
+        {
+            entries.push_back(entry);
+        }
+    }
+
+    ISHIKO_TEST_ABORT_IF_NEQ(entries.size(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(std::string(entries[0]->name()), "TestRegistryTests");
+    ISHIKO_TEST_FAIL_IF_NEQ(std::string(entries[1]->name()), "TestRegistry macro test 1");
+    ISHIKO_TEST_FAIL_IF_NOT(entries[0]->line() < entries[1]->line());
+
+    TestSequence sequence(TestNumber(1), "Sequence");
+    std::shared_ptr<Test> registeredTest = entries[0]->createTest(TestNumber(1), sequence.context());
+
+    ISHIKO_TEST_FAIL_IF_NEQ(registeredTest->name(), "TestRegistry tests");
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_TESTREGISTRYTESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_TESTREGISTRYTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class TestRegistryTests : public Ishiko::TestSequence
+{
+public:
+    TestRegistryTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void EntriesTest1(Ishiko::Test& test);
+    static void AppendToTest1(Ishiko::Test& test);
+    static void DefaultTestRegistryTest1(Ishiko::Test& test);
+};
+
+#endif
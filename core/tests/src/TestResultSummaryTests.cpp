@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "TestResultSummaryTests.hpp"
+#include <memory>
+
+using namespace Ishiko;
+
+TestResultSummaryTests::TestResultSummaryTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "TestResultSummary tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("add test 1", AddTest1);
+    append<HeapAllocationErrorsTest>("Observer test 1", ObserverTest1);
+}
+
+void TestResultSummaryTests::ConstructorTest1(Test& test)
+{
+    TestResultSummary summary;
+
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.unknown(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.passed(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.passedButMemoryLeaks(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.exception(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.failed(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.skipped(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.total(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.notPassed().size(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void TestResultSummaryTests::AddTest1(Test& test)
+{
+    Test passingTest(TestNumber(1), "Passing test", TestResult::passed);
+    Test failingTest(TestNumber(2), "Failing test", TestResult::failed);
+
+    TestResultSummary summary;
+    summary.add(passingTest);
+    summary.add(failingTest);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.passed(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.failed(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.total(), 2);
+    ISHIKO_TEST_ABORT_IF_NEQ(summary.notPassed().size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.notPassed()[0].first, "Failing test");
+    ISHIKO_TEST_FAIL_IF(summary.notPassed()[0].second != TestResult::failed);
+    ISHIKO_TEST_PASS();
+}
+
+void TestResultSummaryTests::ObserverTest1(Test& test)
+{
+    TestResultSummary summary;
+    {
+        TestSequence sequence(TestNumber(1), "Sequence");
+        sequence.append<Test>("Passing test",
+            [](Test& test)
+            {
+                ISHIKO_TEST_PASS();
+            });
+        std::shared_ptr<TestSequence> nestedSequence = std::make_shared<TestSequence>(TestNumber(), "Nested sequence");
+        nestedSequence->append<Test>("Failing test",
+            [](Test& test)
+            {
+                ISHIKO_TEST_FAIL();
+            });
+        nestedSequence->append<Test>("Skipped test",
+            [](Test& test)
+            {
+                ISHIKO_TEST_SKIP();
+            });
+        sequence.append(nestedSequence);
+        std::shared_ptr<TestResultSummary::Observer> observer = std::make_shared<TestResultSummary::Observer>(summary);
+        sequence.observers().add(observer);
+
+        sequence.run();
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.passed(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.failed(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.skipped(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.total(), 3);
+    ISHIKO_TEST_ABORT_IF_NEQ(summary.notPassed().size(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.notPassed()[0].first, "Failing test");
+    ISHIKO_TEST_FAIL_IF_NEQ(summary.notPassed()[1].first, "Skipped test");
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,224 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "TestServerTests.hpp"
+#include <boost/filesystem.hpp>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace Ishiko;
+
+namespace
+{
+
+// Sends the requests and returns the lines of the replies, until the server closes the connection
+std::vector<std::string> SendRequests(const boost::filesystem::path& socketPath, const std::string& requests)
+{
+    std::vector<std::string> lines;
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    int client = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    if (connect(client, (const sockaddr*)&address, sizeof(address)) == 0)
+    {
+        send(client, requests.c_str(), requests.size(), 0);
+        // The server replies to all the requests then closes the connection once it sees we are done
+        shutdown(client, SHUT_WR);
+        std::string replies;
+        char buffer[4096];
+        ssize_t size;
+        while ((size = recv(client, buffer, sizeof(buffer), 0)) > 0)
+        {
+            replies.append(buffer, size);
+        }
+        size_t start = 0;
+        size_t end;
+        while ((end = replies.find('\n', start)) != std::string::npos)
+        {
+            lines.push_back(replies.substr(start, end - start));
+            start = end + 1;
+        }
+    }
+    close(client);
+#endif
+    return lines;
+}
+
+}
+
+TestServerTests::TestServerTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "TestServer tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("FindTests test 1", FindTestsTest1);
+    append<HeapAllocationErrorsTest>("start test 1", StartTest1);
+    append<HeapAllocationErrorsTest>("start test 2", StartTest2);
+    append<HeapAllocationErrorsTest>("serve test 1", ServeTest1);
+}
+
+void TestServerTests::ConstructorTest1(Test& test)
+{
+    TopTestSequence tests("tests");
+    TestServer server(tests);
+
+    ISHIKO_TEST_FAIL_IF(server.isRunning());
+    ISHIKO_TEST_PASS();
+}
+
+void TestServerTests::FindTestsTest1(Test& test)
+{
+    TopTestSequence tests("tests");
+    TestSequence& sequence = tests.append<TestSequence>("sequence");
+    sequence.append<Test>("test1", TestResult::passed);
+    Test& test2 = sequence.append<Test>("test2", TestResult::passed);
+    Test& test3 = tests.append<Test>("test3", TestResult::passed);
+
+    std::vector<Test*> allTests = TestServer::FindTests(tests, "");
+    std::vector<Test*> testsByNumber = TestServer::FindTests(tests, "1.2");
+    std::vector<Test*> testsByName = TestServer::FindTests(tests, "test3");
+    std::vector<Test*> noTests = TestServer::FindTests(tests, "1.3");
+
+    ISHIKO_TEST_ABORT_IF_NEQ(allTests.size(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(allTests[0], &sequence);
+    ISHIKO_TEST_FAIL_IF_NEQ(allTests[1], &test3);
+    ISHIKO_TEST_ABORT_IF_NEQ(testsByNumber.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(testsByNumber[0], &test2);
+    ISHIKO_TEST_ABORT_IF_NEQ(testsByName.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(testsByName[0], &test3);
+    ISHIKO_TEST_FAIL_IF_NEQ(noTests.size(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void TestServerTests::StartTest1(Test& test)
+{
+    if (!TestServer::IsSupported())
+    {
+        ISHIKO_TEST_SKIP();
+    }
+
+    boost::filesystem::path socketPath = test.context().getOutputPath("TestServerTests_StartTest1.sock");
+    {
+        std::ofstream file(socketPath.string());
+        file << "not a socket";
+    }
+
+    TopTestSequence tests("tests");
+    TestServer server(tests);
+
+    Error error;
+    server.start(socketPath, error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(boost::filesystem::file_size(socketPath), 12);
+    ISHIKO_TEST_PASS();
+}
+
+void TestServerTests::StartTest2(Test& test)
+{
+#if ISHIKO_OS == ISHIKO_OS_LINUX
+    boost::filesystem::path socketPath = test.context().getOutputPath("TestServerTests_StartTest2.sock");
+    boost::filesystem::remove(socketPath);
+
+    // A socket left behind by a server that didn't shut down cleanly
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socketPath.c_str(), (sizeof(address.sun_path) - 1));
+    int staleSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+    int bindResult = bind(staleSocket, (const sockaddr*)&address, sizeof(address));
+    close(staleSocket);
+
+    ISHIKO_TEST_ABORT_IF_NEQ(bindResult, 0);
+
+    TopTestSequence tests("tests");
+    TestServer server(tests);
+
+    Error error;
+    server.start(socketPath, error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+
+    server.stop();
+
+    ISHIKO_TEST_FAIL_IF(boost::filesystem::exists(socketPath));
+    ISHIKO_TEST_PASS();
+#else
+    ISHIKO_TEST_SKIP();
+#endif
+}
+
+void TestServerTests::ServeTest1(Test& test)
+{
+    if (!TestServer::IsSupported())
+    {
+        ISHIKO_TEST_SKIP();
+    }
+
+    boost::filesystem::path socketPath = test.context().getOutputPath("TestServerTests_ServeTest1.sock");
+
+    TopTestSequence tests("tests");
+    TestSequence& sequence = tests.append<TestSequence>("sequence");
+    // The server resets the tests before running them, which forgets results given at construction
+    sequence.append<Test>("test1",
+        [](Test& test)
+        {
+            test.setResult(TestResult::passed);
+        });
+    sequence.append<Test>("test2",
+        [](Test& test)
+        {
+            test.setResult(TestResult::failed);
+        });
+    size_t runCount = 0;
+    tests.append<Test>("test3",
+        [&runCount](Test& test)
+        {
+            ++runCount;
+            test.setResult(TestResult::passed);
+        });
+
+    TestServer server(tests);
+
+    Error error;
+    server.start(socketPath, error);
+
+    ISHIKO_TEST_ABORT_IF(error);
+
+    Error serveError;
+    std::thread serverThread(
+        [&server, &serveError]()
+        {
+            server.serve(serveError);
+        });
+    std::vector<std::string> replies1 = SendRequests(socketPath, "run 1.2\nrun test3\nrun test3\n");
+    std::vector<std::string> replies2 = SendRequests(socketPath, "list\nshutdown\n");
+    serverThread.join();
+    server.stop();
+
+    ISHIKO_TEST_FAIL_IF(serveError);
+    ISHIKO_TEST_FAIL_IF(boost::filesystem::exists(socketPath));
+    ISHIKO_TEST_FAIL_IF_NEQ(runCount, 2);
+    ISHIKO_TEST_ABORT_IF_NEQ(replies1.size(), 6);
+    ISHIKO_TEST_FAIL_IF_NEQ(replies1[0].substr(0, 60),
+        "{\"number\":\"1.2\",\"name\":\"test2\",\"result\":\"failed\",\"duration\":");
+    ISHIKO_TEST_FAIL_IF_NEQ(replies1[1],
+        "{\"done\":true,\"total\":1,\"passed\":0,\"failed\":1,\"exception\":0,\"skipped\":0}");
+    ISHIKO_TEST_FAIL_IF_NEQ(replies1[3],
+        "{\"done\":true,\"total\":1,\"passed\":1,\"failed\":0,\"exception\":0,\"skipped\":0}");
+    ISHIKO_TEST_ABORT_IF_NEQ(replies2.size(), 6);
+    ISHIKO_TEST_FAIL_IF_NEQ(replies2[0], "{\"number\":\"1\",\"name\":\"sequence\"}");
+    ISHIKO_TEST_FAIL_IF_NEQ(replies2[2], "{\"number\":\"1.2\",\"name\":\"test2\"}");
+    ISHIKO_TEST_FAIL_IF_NEQ(replies2[3], "{\"number\":\"2\",\"name\":\"test3\"}");
+    ISHIKO_TEST_FAIL_IF_NEQ(replies2[4], "{\"done\":true}");
+    ISHIKO_TEST_FAIL_IF_NEQ(replies2[5], "{\"done\":true}");
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_TESTSERVERTESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_TESTSERVERTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class TestServerTests : public Ishiko::TestSequence
+{
+public:
+    TestServerTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void FindTestsTest1(Ishiko::Test& test);
+    static void StartTest1(Ishiko::Test& test);
+    static void StartTest2(Ishiko::Test& test);
+    static void ServeTest1(Ishiko::Test& test);
+};
+
+#endif
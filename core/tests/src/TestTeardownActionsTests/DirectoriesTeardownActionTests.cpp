@@ -6,6 +6,7 @@
 
 #include "DirectoriesTeardownActionTests.h"
 #include <boost/filesystem.hpp>
+#include <fstream>
 #include <Ishiko/TestFramework/Core/DebugHeap.hpp>
 
 using namespace Ishiko;
@@ -16,6 +17,8 @@ DirectoriesTeardownActionTests::DirectoriesTeardownActionTests(const TestNumber&
 {
     append<HeapAllocationErrorsTest>("Creation test 1", CreationTest1);
     append<HeapAllocationErrorsTest>("teardown() test 1", TeardownTest1);
+    append<HeapAllocationErrorsTest>("teardown() test 2", TeardownTest2);
+    append<HeapAllocationErrorsTest>("teardown() test 3", TeardownTest3);
 }
 
 void DirectoriesTeardownActionTests::CreationTest1(Test& test)
@@ -57,3 +60,91 @@ void DirectoriesTeardownActionTests::TeardownTest1(Test& test)
     ISHIKO_TEST_FAIL_IF_NOT(functionTest.passed());
     ISHIKO_TEST_PASS();
 }
+
+void DirectoriesTeardownActionTeardownTest2Helper(Test& test)
+{
+    DebugHeap::TrackingState tracking;
+    tracking.disableTracking();
+
+    path directoryPath(
+        test.context().getOutputPath("TestTeardownActionsTests/DirectoriesTeardownActionTeardownTest2"));
+    std::shared_ptr<DirectoriesTeardownAction> action = std::make_shared<DirectoriesTeardownAction>();
+    action->add(directoryPath);
+    test.addTeardownAction(action);
+
+    tracking.restore();
+
+    if (create_directories(directoryPath / "subdirectory"))
+    {
+        std::ofstream((directoryPath / "subdirectory" / "file.txt").string()) << "Hello";
+        ISHIKO_TEST_PASS();
+    }
+}
+
+void DirectoriesTeardownActionTests::TeardownTest2(Test& test)
+{
+    path directoryPath(
+        test.context().getOutputPath("TestTeardownActionsTests/DirectoriesTeardownActionTeardownTest2"));
+
+    std::shared_ptr<BackgroundDeleter> deleter = std::make_shared<BackgroundDeleter>(2);
+    TestContext context(&test.context());
+    context.setBackgroundDeleter(deleter);
+
+    Test functionTest(TestNumber(), "DirectoriesTeardownActionTeardownTest2",
+        DirectoriesTeardownActionTeardownTest2Helper, context);
+    functionTest.run();
+    deleter->drain();
+
+    ISHIKO_TEST_FAIL_IF(exists(directoryPath));
+    ISHIKO_TEST_FAIL_IF_NEQ(deleter->failureCount(), 0);
+    ISHIKO_TEST_FAIL_IF_NOT(functionTest.passed());
+    ISHIKO_TEST_PASS();
+}
+
+void DirectoriesTeardownActionTeardownTest3Helper(Test& test)
+{
+    DebugHeap::TrackingState tracking;
+    tracking.disableTracking();
+
+    path directoryPath(
+        test.context().getOutputPath("TestTeardownActionsTests/DirectoriesTeardownActionTeardownTest3"));
+    std::shared_ptr<DirectoriesTeardownAction> action = std::make_shared<DirectoriesTeardownAction>();
+    action->add(directoryPath);
+    test.addTeardownAction(action);
+
+    tracking.restore();
+
+    for (int i = 0; i < 16; ++i)
+    {
+        create_directories(directoryPath / std::to_string(i));
+        std::ofstream((directoryPath / std::to_string(i) / "file.txt").string()) << "Hello";
+    }
+    ISHIKO_TEST_PASS();
+}
+
+void DirectoriesTeardownActionTests::TeardownTest3(Test& test)
+{
+    path directoryPath(
+        test.context().getOutputPath("TestTeardownActionsTests/DirectoriesTeardownActionTeardownTest3"));
+
+    std::shared_ptr<BackgroundDeleter> deleter = std::make_shared<BackgroundDeleter>(2);
+    TestContext context(&test.context());
+    context.setBackgroundDeleter(deleter);
+
+    Test functionTest(TestNumber(), "DirectoriesTeardownActionTeardownTest3",
+        DirectoriesTeardownActionTeardownTest3Helper, context);
+    functionTest.run();
+
+    // Recreate the directory while its deletion may still be pending, as a test that is run again would
+    create_directories(directoryPath);
+    std::ofstream((directoryPath / "file.txt").string()) << "Hello";
+    deleter->drain();
+
+    ISHIKO_TEST_FAIL_IF_NOT(exists(directoryPath / "file.txt"));
+    ISHIKO_TEST_FAIL_IF_NEQ(deleter->failureCount(), 0);
+    ISHIKO_TEST_FAIL_IF_NOT(functionTest.passed());
+
+    remove_all(directoryPath);
+
+    ISHIKO_TEST_PASS();
+}
@@ -17,6 +17,8 @@ public:
 private:
     static void CreationTest1(Ishiko::Test& test);
     static void TeardownTest1(Ishiko::Test& test);
+    static void TeardownTest2(Ishiko::Test& test);
+    static void TeardownTest3(Ishiko::Test& test);
 };
 
 #endif
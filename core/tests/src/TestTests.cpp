@@ -5,9 +5,32 @@
 */
 
 #include "TestTests.hpp"
+#include <fstream>
+#include <iterator>
+#include <string>
 
 using namespace Ishiko;
 
+namespace
+{
+
+class CustomReportTestCheck : public TestCheck
+{
+public:
+    void run(Test& test, const char* file, int line) override
+    {
+        m_result = Result::failed;
+        test.fail(file, line);
+    }
+
+    void addToJUnitXMLTestReport(JUnitXMLWriter& writer) const override
+    {
+        writer.writeText("custom check report");
+    }
+};
+
+}
+
 TestTests::TestTests(const TestNumber& number, const TestContext& context)
     : TestSequence(number, "Test tests", context)
 {
@@ -27,6 +50,9 @@ TestTests::TestTests(const TestNumber& number, const TestContext& context)
     append<HeapAllocationErrorsTest>("run test 3", RunTest3);
     append<HeapAllocationErrorsTest>("run test 4", RunTest4);
     append<HeapAllocationErrorsTest>("run test 5", RunTest5);
+    append<HeapAllocationErrorsTest>("run test 6", RunTest6);
+    append<HeapAllocationErrorsTest>("run test 7", RunTest7);
+    append<HeapAllocationErrorsTest>("run test 8", RunTest8);
     append<HeapAllocationErrorsTest>("abort test 1", AbortTest1);
     append<HeapAllocationErrorsTest>("skip test 1", SkipTest1);
 }
@@ -200,6 +226,90 @@ void TestTests::RunTest5(Test& test)
     ISHIKO_TEST_PASS();
 }
 
+void TestTests::RunTest6(Test& test)
+{
+    TestContext context(&test.context());
+    context.setIsolatedOutputDirectories(true);
+
+    boost::filesystem::path outputPath1;
+    boost::filesystem::path outputPath2;
+    TestSequence sequence(TestNumber(1), "TestRunTest6", context);
+    sequence.append<Test>("Test 1",
+        [&outputPath1](Test& test)
+        {
+            outputPath1 = test.context().getOutputPath("file.txt");
+            test.pass();
+        });
+    sequence.append<Test>("Test 2",
+        [&outputPath2](Test& test)
+        {
+            outputPath2 = test.context().getOutputPath("file.txt");
+            test.pass();
+        });
+    sequence.run();
+
+    ISHIKO_TEST_FAIL_IF_NOT(sequence.passed());
+    ISHIKO_TEST_FAIL_IF_NEQ(outputPath1, context.getOutputPath("1.1/file.txt"));
+    ISHIKO_TEST_FAIL_IF_NEQ(outputPath2, context.getOutputPath("1.2/file.txt"));
+    ISHIKO_TEST_PASS();
+}
+
+void TestTests::RunTest7(Test& test)
+{
+    boost::filesystem::path helloPath = test.context().getDataPath("ComparisonTestFiles/Hello.txt");
+    boost::filesystem::path hello2Path = test.context().getDataPath("ComparisonTestFiles/Hello2.txt");
+    boost::filesystem::path notHelloPath = test.context().getDataPath("ComparisonTestFiles/NotHello.txt");
+
+    size_t checkCountDuringRun = 0;
+    Test myTest(TestNumber(1), "TestRunTest7",
+        [&](Test& test)
+        {
+            test.createCheck<FileComparisonTestCheck>(helloPath, hello2Path).run(test, __FILE__, __LINE__);
+            test.createCheck<FileComparisonTestCheck>(helloPath, notHelloPath).run(test, __FILE__, __LINE__);
+            test.appendCheck(std::make_shared<FileComparisonTestCheck>(helloPath, hello2Path));
+            checkCountDuringRun = test.checkCount();
+        });
+    myTest.run();
+
+    // The checks that passed are released once the test completes, the appended check was never run so it is kept
+    ISHIKO_TEST_FAIL_IF_NEQ(myTest.result(), TestResult::failed);
+    ISHIKO_TEST_FAIL_IF_NEQ(checkCountDuringRun, 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(myTest.checkCount(), 2);
+    ISHIKO_TEST_PASS();
+}
+
+void TestTests::RunTest8(Test& test)
+{
+    Test myTest(TestNumber(1), "TestRunTest8",
+        [](Test& test)
+        {
+            test.createCheck<CustomReportTestCheck>().run(test, __FILE__, __LINE__);
+        });
+    myTest.run();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(myTest.result(), TestResult::failed);
+
+    boost::filesystem::path xmlOutputPath = test.context().getOutputPath("TestTests_RunTest8.xml");
+
+    JUnitXMLWriter junitXMLWriter;
+
+    Error error;
+    junitXMLWriter.create(xmlOutputPath, error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+
+    // The failed check is still around after the test completed so its own report is used
+    myTest.addToJUnitXMLTestReport(junitXMLWriter);
+
+    junitXMLWriter.close();
+
+    std::ifstream xmlFile(xmlOutputPath.string());
+    std::string xml((std::istreambuf_iterator<char>(xmlFile)), std::istreambuf_iterator<char>());
+
+    ISHIKO_TEST_FAIL_IF_EQ(xml.find("custom check report"), std::string::npos);
+    ISHIKO_TEST_PASS();
+}
+
 void TestTests::AbortTest1(Test& test)
 {
     bool canary = false;
@@ -31,6 +31,9 @@ private:
     static void RunTest3(Ishiko::Test& test);
     static void RunTest4(Ishiko::Test& test);
     static void RunTest5(Ishiko::Test& test);
+    static void RunTest6(Ishiko::Test& test);
+    static void RunTest7(Ishiko::Test& test);
+    static void RunTest8(Ishiko::Test& test);
     static void AbortTest1(Ishiko::Test& test);
     static void SkipTest1(Ishiko::Test& test);
 };
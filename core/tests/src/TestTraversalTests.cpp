@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "TestTraversalTests.hpp"
+#include <memory>
+#include <string>
+
+using namespace Ishiko;
+
+namespace
+{
+
+// Creates the tree: A (A1, B (B1, B2), C ())
+std::shared_ptr<TestSequence> CreateTree()
+{
+    std::shared_ptr<TestSequence> a = std::make_shared<TestSequence>(TestNumber(1), "A");
+    a->append<Test>("A1", TestResult::passed);
+    TestSequence& b = a->append<TestSequence>("B");
+    b.append<Test>("B1", TestResult::passed);
+    b.append<Test>("B2", TestResult::failed);
+    a->append<TestSequence>("C");
+    return a;
+}
+
+}
+
+TestTraversalTests::TestTraversalTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "TestTraversal tests", context)
+{
+    append<HeapAllocationErrorsTest>("PreOrder test 1", PreOrderTest1);
+    append<HeapAllocationErrorsTest>("PostOrder test 1", PostOrderTest1);
+    append<HeapAllocationErrorsTest>("Leaves test 1", LeavesTest1);
+    append<HeapAllocationErrorsTest>("Leaves test 2", LeavesTest2);
+}
+
+void TestTraversalTests::PreOrderTest1(Test& test)
+{
+    std::shared_ptr<TestSequence> tree = CreateTree();
+    const Test& root = *tree;
+
+    std::string names;
+    TestTraversal::PreOrder(root,
+        [&names](const Test& test)
+        {
+            names += test.name() + " ";
+        });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(names, "A A1 B B1 B2 C ");
+    ISHIKO_TEST_PASS();
+}
+
+void TestTraversalTests::PostOrderTest1(Test& test)
+{
+    std::shared_ptr<TestSequence> tree = CreateTree();
+    const Test& root = *tree;
+
+    std::string names;
+    TestTraversal::PostOrder(root,
+        [&names](const Test& test)
+        {
+            names += test.name() + " ";
+        });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(names, "A1 B1 B2 B C A ");
+    ISHIKO_TEST_PASS();
+}
+
+void TestTraversalTests::LeavesTest1(Test& test)
+{
+    std::shared_ptr<TestSequence> tree = CreateTree();
+    const Test& root = *tree;
+
+    std::string names;
+    TestTraversal::Leaves(root,
+        [&names](const Test& test)
+        {
+            names += test.name() + " ";
+        });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(names, "A1 B1 B2 C ");
+    ISHIKO_TEST_PASS();
+}
+
+void TestTraversalTests::LeavesTest2(Test& test)
+{
+    std::shared_ptr<TestSequence> tree = CreateTree();
+
+    // A non-const root gives access to the tests themselves
+    TestTraversal::Leaves(*tree,
+        [](Test& test)
+        {
+            test.setResult(TestResult::skipped);
+        });
+
+    ISHIKO_TEST_FAIL_IF_NOT((*tree)[0].skipped());
+    ISHIKO_TEST_FAIL_IF_NOT((*tree)[2].skipped());
+    ISHIKO_TEST_PASS();
+}
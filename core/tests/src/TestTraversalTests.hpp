@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_TESTTRAVERSALTESTS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTS_TESTTRAVERSALTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class TestTraversalTests : public Ishiko::TestSequence
+{
+public:
+    TestTraversalTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void PreOrderTest1(Ishiko::Test& test);
+    static void PostOrderTest1(Ishiko::Test& test);
+    static void LeavesTest1(Ishiko::Test& test);
+    static void LeavesTest2(Ishiko::Test& test);
+};
+
+#endif
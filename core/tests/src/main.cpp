@@ -4,13 +4,36 @@
     See https://github.com/ishiko-cpp/test-framework/blob/main/LICENSE.txt
 */
 
+#include "BackgroundDeleterTests.hpp"
+#include "BinaryResultLogTests.hpp"
+#include "ChildProcessPoolTests.hpp"
 #include "DirectoryComparisonTestCheckTests.hpp"
 #include "FileComparisonTestCheckTests.hpp"
+#include "FileWatcherTests.hpp"
+#include "FixtureCopierTests.hpp"
+#include "ForkServerTests.hpp"
+#include "FuzzTestTests.hpp"
+#include "IncrementalFileComparisonTests.hpp"
+#include "JSONLinesReporterTests.hpp"
 #include "JUnitXMLWriterTests.hpp"
+#include "MemoryBackedOutputDirectoryTests.hpp"
+#include "ParameterizedTestTests.hpp"
+#include "PipedChildProcessTests.hpp"
+#include "PropertyGeneratorTests.hpp"
+#include "PropertyTestTests.hpp"
+#include "RepeatedTestCaseTests.hpp"
+#include "SharedFixtureTests.hpp"
+#include "SummaryProgressObserverTests.hpp"
+#include "TAPReporterTests.hpp"
+#include "TestCheckArenaTests.hpp"
 #include "TestContextTests.hpp"
+#include "TestFileDependenciesTests.hpp"
 #include "TestHarnessTests.hpp"
 #include "TestNumberTests.hpp"
+#include "TestResultSummaryTests.hpp"
+#include "TestServerTests.hpp"
 #include "TestTests.hpp"
+#include "TestTraversalTests.hpp"
 #include "TestMacrosFormatterTests.h"
 #include "TestMacrosTests.h"
 #include "TestSequenceTests.h"
@@ -37,17 +60,42 @@ int main(int argc, char* argv[])
         CommandLineParser::parse(commandLineSpec, argc, argv, configuration);
 
         TestHarness theTestHarness("IshikoTestFrameworkCore", configuration);
+        // Some of the tests are registered with ISHIKO_TEST_REGISTER instead of being appended below
+        theTestHarness.setTestRegistry(&TestRegistry::DefaultTestRegistry());
 
         TestSequence& theTests = theTestHarness.tests();
         theTests.append<TestContextTests>();
         theTests.append<TestNumberTests>();
+        theTests.append<TestTraversalTests>();
         theTests.append<TestTests>();
         theTests.append<FileComparisonTestCheckTests>();
         theTests.append<DirectoryComparisonTestCheckTests>();
+        theTests.append<TestCheckArenaTests>();
+        theTests.append<ParameterizedTestTests>();
+        theTests.append<PropertyGeneratorTests>();
+        theTests.append<RepeatedTestCaseTests>();
+        theTests.append<PropertyTestTests>();
+        theTests.append<FuzzTestTests>();
+        theTests.append<BinaryResultLogTests>();
+        theTests.append<JSONLinesReporterTests>();
+        theTests.append<TAPReporterTests>();
+        theTests.append<SummaryProgressObserverTests>();
+        theTests.append<TestResultSummaryTests>();
+        theTests.append<TestFileDependenciesTests>();
+        theTests.append<TestServerTests>();
+        theTests.append<IncrementalFileComparisonTests>();
         theTests.append<TestMacrosFormatterTests>();
         theTests.append<TestMacrosTests>();
         theTests.append<TestSequenceTests>();
         theTests.append<ConsoleApplicationTestTests>();
+        theTests.append<PipedChildProcessTests>();
+        theTests.append<ChildProcessPoolTests>();
+        theTests.append<ForkServerTests>();
+        theTests.append<FixtureCopierTests>();
+        theTests.append<SharedFixtureTests>();
+        theTests.append<BackgroundDeleterTests>();
+        theTests.append<MemoryBackedOutputDirectoryTests>();
+        theTests.append<FileWatcherTests>();
         theTests.append<HeapAllocationErrorsTestTests>();
         theTests.append<TestSetupActionsTests>();
         theTests.append<TestTeardownActionsTests>();
@@ -20,9 +20,13 @@
     IN THE SOFTWARE.
 */
 
+#include <Ishiko/TestFramework/Core/ForkServerChild.hpp>
 #include <iostream>
 
-int main(int argc, char* argv[])
+namespace
+{
+
+int HelperMain(int argc, char* argv[])
 {
     if (argc <= 1)
     {
@@ -35,3 +39,11 @@ int main(int argc, char* argv[])
 
     return 0;
 }
+
+}
+
+int main(int argc, char* argv[])
+{
+    // The tests can start this helper with a ForkServer and fork it from there instead of starting it with exec
+    return Ishiko::ForkServerChild::RunIfRequested(argc, argv, HelperMain);
+}
@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+// Converts a log written with the --binary-result-log option of a test harness to console text, JSON or a JUnit XML
+// report. The text and the JSON are written to the standard output unless an output file is given, the JUnit XML
+// report needs an output file.
+//
+// Usage: ResultLogConverter <log> console|json|junit [output]
+
+#include <Ishiko/TestFramework/Core.hpp>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace Ishiko;
+
+namespace
+{
+
+int PrintUsage()
+{
+    std::cerr << "Usage: ResultLogConverter <log> console|json|junit [output]" << std::endl;
+    return TestApplicationReturnCode::configurationProblem;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    if ((argc < 3) || (argc > 4))
+    {
+        return PrintUsage();
+    }
+    std::string logPath = argv[1];
+    std::string format = argv[2];
+
+    Error error;
+    if (format == "junit")
+    {
+        if (argc != 4)
+        {
+            return PrintUsage();
+        }
+        BinaryResultLogConverter::ToJUnitXML(logPath, argv[3], error);
+    }
+    else if ((format == "console") || (format == "json"))
+    {
+        std::ifstream log(logPath, std::ios::binary);
+        if (!log)
+        {
+            std::cerr << "Failed to open " << logPath << std::endl;
+            return TestApplicationReturnCode::exception;
+        }
+
+        std::ofstream outputFile;
+        if (argc == 4)
+        {
+            outputFile.open(argv[3]);
+            if (!outputFile)
+            {
+                std::cerr << "Failed to create " << argv[3] << std::endl;
+                return TestApplicationReturnCode::exception;
+            }
+        }
+        std::ostream& output = ((argc == 4) ? outputFile : std::cout);
+
+        if (format == "console")
+        {
+            BinaryResultLogConverter::ToConsoleText(log, output, error);
+        }
+        else
+        {
+            BinaryResultLogConverter::ToJSON(log, output, error);
+        }
+    }
+    else
+    {
+        return PrintUsage();
+    }
+
+    if (error)
+    {
+        std::cerr << "Failed to convert " << logPath << ", the log is not valid" << std::endl;
+        return TestApplicationReturnCode::exception;
+    }
+    return TestApplicationReturnCode::ok;
+}
@@ -4,23 +4,55 @@
 #ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_HPP
 #define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_HPP
 
+#include "Core/BackgroundDeleter.hpp"
+#include "Core/BinaryResultLogConverter.hpp"
+#include "Core/BinaryResultLogObserver.hpp"
+#include "Core/BinaryResultLogReader.hpp"
+#include "Core/CapturedOutput.hpp"
+#include "Core/ChildProcessPool.hpp"
+#include "Core/ChildProcessResources.hpp"
 #include "Core/ConsoleApplicationTest.hpp"
 #include "Core/DirectoryComparisonTestCheck.hpp"
 #include "Core/FileComparisonTestCheck.hpp"
+#include "Core/FileWatcher.hpp"
+#include "Core/FixtureCopier.hpp"
+#include "Core/FuzzTest.hpp"
+#include "Core/ForkServer.hpp"
+#include "Core/ForkServerChild.hpp"
 #include "Core/HeapAllocationErrorsTest.hpp"
+#include "Core/IncrementalFileComparison.hpp"
+#include "Core/JSONLinesReporter.hpp"
 #include "Core/JUnitXMLWriter.hpp"
 #include "Core/linkoptions.hpp"
+#include "Core/MemoryBackedOutputDirectory.hpp"
+#include "Core/ParameterizedTest.hpp"
+#include "Core/PersistentStorage.hpp"
+#include "Core/PipedChildProcess.hpp"
+#include "Core/PropertyGenerator.hpp"
+#include "Core/PropertyTest.hpp"
+#include "Core/RepeatedTestCase.hpp"
+#include "Core/SharedFixture.hpp"
+#include "Core/SharedFixtureRegistry.hpp"
+#include "Core/SummaryProgressObserver.hpp"
+#include "Core/TAPReporter.hpp"
 #include "Core/Test.hpp"
 #include "Core/TestApplicationReturnCodes.hpp"
 #include "Core/TestCheck.hpp"
+#include "Core/TestCheckArena.hpp"
 #include "Core/TestException.hpp"
+#include "Core/TestFileDependencies.hpp"
 #include "Core/TestFrameworkErrorCategory.hpp"
 #include "Core/TestHarness.hpp"
 #include "Core/TestMacros.hpp"
 #include "Core/TestMacrosFormatter.hpp"
 #include "Core/TestProgressObserver.hpp"
+#include "Core/TestRegistry.hpp"
+#include "Core/TestReporter.hpp"
 #include "Core/TestResult.hpp"
+#include "Core/TestResultSummary.hpp"
 #include "Core/TestSequence.hpp"
+#include "Core/TestServer.hpp"
+#include "Core/TestTraversal.hpp"
 #include "Core/DirectoriesTeardownAction.hpp"
 #include "Core/FilesTeardownAction.hpp"
 #include "Core/ProcessAction.hpp"
@@ -4,21 +4,29 @@
 #ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_ACTIONS_COPYFILESACTION_HPP
 #define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_ACTIONS_COPYFILESACTION_HPP
 
+#include "../FixtureCopier.hpp"
 #include "../TestSetupAction.hpp"
 #include <Ishiko/Text.hpp>
 #include <utility>
 
 namespace Ishiko
 {
+    /// Copies files or directory trees before a test runs.
+
+    /// The copies are made with FixtureCopier so they are cheap on file systems that support reflinks.
     class CopyFilesAction : public TestSetupAction
     {
     public:
         CopyFilesAction(const InterpolatedString& source, const InterpolatedString& destination);
 
+        /// Allows the files to be hard linked instead of copied, see FixtureCopier::setReadOnly.
+        void setReadOnly(bool readOnly);
+
         void setup(const Test& test) override;
 
     private:
         std::vector<std::pair<InterpolatedString, InterpolatedString>> m_copy_list;
+        FixtureCopier m_copier;
     };
 }
 
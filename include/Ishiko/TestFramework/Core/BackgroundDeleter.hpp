@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_BACKGROUNDDELETER_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_BACKGROUNDDELETER_HPP
+
+#include <boost/filesystem/path.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Ishiko
+{
+    /// Deletes files and directory trees on background threads.
+
+    /// This takes the deletion of test output off the thread that runs the tests. The subdirectories of a tree are
+    /// deleted in parallel. The threads are only started when the first deletion is requested.
+    class BackgroundDeleter
+    {
+    public:
+        explicit BackgroundDeleter(size_t threadCount);
+        BackgroundDeleter(const BackgroundDeleter& other) = delete;
+        BackgroundDeleter& operator=(const BackgroundDeleter& other) = delete;
+        /// Waits for the pending deletions to complete.
+        ~BackgroundDeleter();
+
+        size_t threadCount() const noexcept;
+
+        /// Renames a file or directory to a unique name in the same directory.
+
+        /// Paths are renamed before they are handed to the deleter so that a test that creates the same path again
+        /// straight away doesn't have its new files deleted by the pending deletion.
+        ///
+        /// @param path The path to rename.
+        /// @param tombstone Receives the new name of the path.
+        /// @returns true if the path was renamed, false if it doesn't exist or couldn't be renamed.
+        static bool RenameToTombstone(const boost::filesystem::path& path, boost::filesystem::path& tombstone);
+
+        /// Deletes a file or an empty directory.
+        void remove(const boost::filesystem::path& path);
+        /// Deletes a file or a directory and everything it contains.
+        void removeAll(const boost::filesystem::path& path);
+        /// Waits until all the deletions requested so far have completed.
+        void drain();
+        /// The number of paths that couldn't be deleted. Paths that didn't exist are not counted.
+        size_t failureCount() const;
+
+    private:
+        class Directory;
+
+        void enqueue(std::function<void()> task);
+        void removeDirectoryContents(std::shared_ptr<Directory> directory);
+        void completeDirectory(std::shared_ptr<Directory> directory);
+        void removePath(const boost::filesystem::path& path);
+        void runTasks();
+
+    private:
+        size_t m_threadCount;
+        std::vector<std::thread> m_threads;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_taskAvailable;
+        std::condition_variable m_drained;
+        std::deque<std::function<void()>> m_tasks;
+        size_t m_activeTaskCount;
+        size_t m_failureCount;
+        bool m_stopping;
+    };
+}
+
+#endif
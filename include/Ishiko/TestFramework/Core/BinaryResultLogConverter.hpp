@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_BINARYRESULTLOGCONVERTER_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_BINARYRESULTLOGCONVERTER_HPP
+
+#include "Test.hpp"
+#include <boost/filesystem/path.hpp>
+#include <Ishiko/Errors.hpp>
+#include <istream>
+#include <ostream>
+
+namespace Ishiko
+{
+    /// Converts the logs written by BinaryResultLogObserver to the formats that are usually produced during the run.
+
+    /// The logs are processed one record at a time so the memory used doesn't depend on the size of the log. A log
+    /// that was cut short is converted up to its last complete record.
+    class BinaryResultLogConverter
+    {
+    public:
+        /// Sends the events of the log to the observer as if the tests were running. The tests passed to the observer
+        /// only have a number, a name and, for test_end events, a result.
+        static void Replay(std::istream& log, Test::Observer& observer, Error& error);
+        /// Writes the same text as TestProgressObserver does during a run.
+        static void ToConsoleText(std::istream& log, std::ostream& output, Error& error);
+        /// Writes a JSON array with an object for each test that completed, in the order they completed, with its
+        /// number, name, result, start time and duration in microseconds and its failures.
+        static void ToJSON(std::istream& log, std::ostream& output, Error& error);
+        /// Writes the same JUnit XML report as TestHarness does, with a test case for each test that doesn't contain
+        /// other tests. The log is read twice since the number of test cases comes first in the report.
+        static void ToJUnitXML(const boost::filesystem::path& logPath, const boost::filesystem::path& reportPath,
+            Error& error);
+    };
+}
+
+#endif
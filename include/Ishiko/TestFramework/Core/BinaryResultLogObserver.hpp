@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_BINARYRESULTLOGOBSERVER_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_BINARYRESULTLOGOBSERVER_HPP
+
+#include "Test.hpp"
+#include "TestNumber.hpp"
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace Ishiko
+{
+    /// An observer that records every event of a run to a compact binary log.
+
+    /// Recording is cheap so the log can be kept for very large runs and converted afterwards to console text, JSON or
+    /// a JUnit XML report with BinaryResultLogConverter. The log is append-only: it is a header followed by records
+    /// that are each written in a single operation, so a log cut short by a crash can still be read up to the last
+    /// complete record. The format is described in BinaryResultLogReader.
+    class BinaryResultLogObserver : public Test::Observer
+    {
+    public:
+        /// Constructor. The header of the log is written to the output immediately.
+        BinaryResultLogObserver(std::ostream& output);
+
+        void onLifecycleEvent(const Test& source, EventType type) override;
+        void onCheckFailed(const Test& source, const std::string& message, const char* file, int line) override;
+        void onExceptionThrown(const Test& source, std::exception_ptr exception) override;
+
+    private:
+        void startRecord(uint8_t type, const TestNumber& number);
+        void writeRecord();
+
+    private:
+        std::ostream& m_output;
+        // The record being written, reused so that recording doesn't allocate once it is large enough
+        std::string m_record;
+        size_t m_nestingLevel;
+    };
+}
+
+#endif
@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_BINARYRESULTLOGREADER_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_BINARYRESULTLOGREADER_HPP
+
+#include "TestNumber.hpp"
+#include "TestResult.hpp"
+#include <Ishiko/Errors.hpp>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace Ishiko
+{
+    /// Reads the logs written by BinaryResultLogObserver.
+
+    /// The log starts with the 8 bytes "ISHKTLOG" followed by the version of the format as a 32-bit integer. Then
+    /// each record is its type on one byte, the size of the rest of the record as a 32-bit integer, the time of the
+    /// event in microseconds since the epoch as a 64-bit integer, the number of the test as its depth followed by its
+    /// parts, all 32-bit integers, and finally the fields specific to the type of record. Integers are little-endian
+    /// and strings are their size as a 32-bit integer followed by their characters. Readers skip the fields they
+    /// don't know about at the end of a record so fields can be added without changing the version.
+    class BinaryResultLogReader
+    {
+    public:
+        enum class RecordType : uint8_t
+        {
+            /// Followed by the name of the test.
+            test_start = 1,
+            /// Followed by the result of the test on one byte.
+            test_end = 2,
+            /// Followed by the message, the file and the line of the check.
+            check_failed = 3,
+            /// Followed by whether the exception was derived from std::exception on one byte and its message.
+            exception_thrown = 4
+        };
+
+        struct Record
+        {
+            RecordType type;
+            /// Microseconds since the epoch.
+            int64_t timestamp;
+            TestNumber number;
+            /// The name of the test, only set for test_start records.
+            std::string name;
+            /// Only set for test_end records.
+            TestResult result;
+            /// The message of a failed check or of an exception.
+            std::string message;
+            /// Only set for check_failed records.
+            std::string file;
+            int line;
+            /// Only set for exception_thrown records, false if the exception wasn't derived from std::exception.
+            bool standardException;
+        };
+
+        static const char magic[8];
+        static const uint32_t version = 1;
+
+        BinaryResultLogReader(std::istream& input);
+
+        /// Reads the next record. Returns false at the end of the log, or if the log is invalid in which case the
+        /// error is set. A record that was cut short, like the last record of the log of a run that crashed, is
+        /// considered to be the end of the log.
+        bool read(Record& record, Error& error);
+
+    private:
+        bool readHeader(Error& error);
+
+    private:
+        std::istream& m_input;
+        bool m_headerRead;
+        // Reused from one record to the next so that reading doesn't allocate once they are large enough
+        std::string m_buffer;
+        std::vector<int> m_numberParts;
+    };
+}
+
+#endif
@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_CAPTUREDOUTPUT_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_CAPTUREDOUTPUT_HPP
+
+#include <boost/filesystem/path.hpp>
+#include <Ishiko/Errors.hpp>
+#include <cstdio>
+#include <string>
+
+namespace Ishiko
+{
+    /// Accumulates the output of a process in memory.
+
+    /// Only the first maxMemorySize bytes are kept in memory. If a spill file has been set the full output is written
+    /// to that file once the limit is exceeded, otherwise the output past the limit is counted but discarded.
+    class CapturedOutput
+    {
+    public:
+        explicit CapturedOutput(size_t maxMemorySize);
+        CapturedOutput(const CapturedOutput& other) = delete;
+        CapturedOutput& operator=(const CapturedOutput& other) = delete;
+        ~CapturedOutput();
+
+        size_t maxMemorySize() const noexcept;
+        void setMaxMemorySize(size_t maxMemorySize);
+        void setSpillFilePath(const boost::filesystem::path& path);
+
+        void append(const char* data, size_t size);
+        void clear();
+
+        /// The total number of bytes that were appended, including the ones that didn't fit in memory.
+        size_t size() const noexcept;
+        /// The bytes that were kept in memory.
+        const std::string& data() const noexcept;
+        bool truncated() const noexcept;
+        bool spilled() const noexcept;
+        const boost::filesystem::path& spillFilePath() const noexcept;
+
+        /// Writes the captured output to a file. If the output was spilled the spill file is copied, otherwise the
+        /// in-memory data is written out.
+        void save(const boost::filesystem::path& path, Error& error);
+
+    private:
+        void closeSpillFile();
+
+    private:
+        size_t m_maxMemorySize;
+        size_t m_size;
+        std::string m_data;
+        boost::filesystem::path m_spillFilePath;
+        FILE* m_spillFile;
+        bool m_spillFailed;
+    };
+}
+
+#endif
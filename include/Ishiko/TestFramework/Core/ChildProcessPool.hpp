@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_CHILDPROCESSPOOL_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_CHILDPROCESSPOOL_HPP
+
+#include "PipedChildProcess.hpp"
+#include <chrono>
+#include <vector>
+
+namespace Ishiko
+{
+    /// Limits the number of child processes that run concurrently and services them from a single event loop.
+
+    /// Tests that support it, like ConsoleApplicationTest without setup actions, start their application in advance and
+    /// add it to the pool. Whenever a test waits for its application all the processes in the pool get their output
+    /// read so none of them blocks on a full pipe. The pool doesn't own the processes.
+    class ChildProcessPool
+    {
+    public:
+        explicit ChildProcessPool(size_t maxSize);
+        ChildProcessPool(const ChildProcessPool& other) = delete;
+        ChildProcessPool& operator=(const ChildProcessPool& other) = delete;
+
+        size_t maxSize() const noexcept;
+        size_t size() const noexcept;
+        bool full() const noexcept;
+
+        void add(PipedChildProcess& process);
+        void remove(PipedChildProcess& process);
+
+        /// Services all the processes in the pool until the given process has exited and its output has been read.
+        void waitForExit(PipedChildProcess& process);
+        /// Same as waitForExit(PipedChildProcess&) but gives up once the deadline has passed.
+        /// @returns false if the deadline passed before the process exited.
+        bool waitForExit(PipedChildProcess& process, std::chrono::steady_clock::time_point deadline);
+
+    private:
+        void serviceProcesses(int timeout);
+
+    private:
+        size_t m_maxSize;
+        std::vector<PipedChildProcess*> m_processes;
+    };
+}
+
+#endif
@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_CHILDPROCESSRESOURCES_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_CHILDPROCESSRESOURCES_HPP
+
+#include <Ishiko/BasePlatform.hpp>
+#include <chrono>
+#include <cstddef>
+
+namespace Ishiko
+{
+    /// The resources consumed by a child process.
+
+    /// A value of zero means the information is not available, either because the platform doesn't provide it or
+    /// because the process hasn't exited yet.
+    class ChildProcessResourceUsage
+    {
+    public:
+        ChildProcessResourceUsage();
+
+        std::chrono::microseconds userTime;
+        std::chrono::microseconds systemTime;
+        /// The time elapsed between the start of the process and the moment it was waited for.
+        std::chrono::microseconds wallTime;
+        /// The peak physical memory used by the process, in bytes.
+        size_t maxResidentSetSize;
+        size_t blockInputOperations;
+        size_t blockOutputOperations;
+    };
+
+    /// Limits on the resources a child process may consume. A value of zero means there is no limit.
+    class ChildProcessResourceLimits
+    {
+    public:
+        ChildProcessResourceLimits();
+
+        /// Sets the CPU time and memory limits on the calling process.
+
+        /// This is meant to be called in a new child process between fork and exec so the limits are in place before
+        /// the program runs. It only makes async-signal-safe calls. This does nothing on platforms other than Linux.
+        void applyToCurrentProcess() const;
+
+        /// The maximum amount of CPU time, user and system combined. The operating system terminates the process
+        /// shortly after the limit is reached.
+        std::chrono::milliseconds maxCPUTime;
+        /// The maximum amount of memory, in bytes.
+
+        /// The address space of the process is limited to this size so allocations beyond it fail. The peak physical
+        /// memory used by the process, which is smaller than its address space, is also checked against this value
+        /// once the process has exited.
+        size_t maxMemorySize;
+        /// The maximum time the process is allowed to run for before it is killed.
+        std::chrono::milliseconds wallTimeout;
+    };
+}
+
+#endif
@@ -4,9 +4,14 @@
 #ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_CONSOLEAPPLICATIONTEST_HPP
 #define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_CONSOLEAPPLICATIONTEST_HPP
 
+#include "CapturedOutput.hpp"
+#include "ChildProcessResources.hpp"
 #include "FileComparisonTestCheck.hpp"
+#include "ForkServer.hpp"
 #include "Test.hpp"
 #include <boost/filesystem.hpp>
+#include <exception>
+#include <memory>
 #include <string>
 
 namespace Ishiko
@@ -20,19 +25,77 @@ namespace Ishiko
             int expectedExitCode, const TestContext& context);
         ConsoleApplicationTest(const TestNumber& number, const std::string& name, const std::string& command_line,
             std::function<void(int exit_code, ConsoleApplicationTest& test)> run_fct, const TestContext& context);
+        ~ConsoleApplicationTest() noexcept override;
 
         void setStandardOutputFilePath(const boost::filesystem::path& path);
         void setStandardOutputReferenceFilePath(const boost::filesystem::path& path);
+        void setStandardErrorReferenceFilePath(const boost::filesystem::path& path);
+
+        /// Captures the standard output and standard error of the application through pipes instead of redirecting
+        /// the standard output to a file.
+
+        /// The output is compared with the reference files as it is received so no temporary files are needed. Up to
+        /// maxMemorySize bytes of each stream are kept in memory. If a standard output file path has been set the
+        /// standard output is spilled to it once it exceeds that size, and it is written to it if the comparison
+        /// fails. This setting is ignored on platforms where PipedChildProcess is not supported.
+        void setInMemoryOutputCapture(size_t maxMemorySize);
+        /// Kills the application as soon as its output differs from a reference file instead of waiting for it to
+        /// finish.
+
+        /// The exit code is not checked in that case. This only has an effect when in-memory output capture is
+        /// enabled since the comparison is otherwise only done once the application has exited.
+        void setAbortOnFirstMismatch(bool abort);
+        const CapturedOutput& standardOutput() const;
+        const CapturedOutput& standardError() const;
+
+        /// Sets limits on the resources the application may use. The test fails if any of them is exceeded.
+
+        /// The limits are enforced while the application runs only when in-memory output capture is enabled. Without
+        /// it only the wall time of the application is known and it is checked once the application has exited.
+        void setResourceLimits(const ChildProcessResourceLimits& limits);
+        /// The resources used by the application during the last run.
+        const ChildProcessResourceUsage& resourceUsage() const;
+        /// Forks the application from a server that runs a warm copy of it instead of starting it with exec.
+
+        /// The server must have been started with the same program as the one in the command line. This only has an
+        /// effect when in-memory output capture is enabled.
+        void setForkServer(std::shared_ptr<ForkServer> server);
+
+        /// Starts the application in the background if in-memory output capture is enabled and the test has no setup
+        /// actions.
+        bool launch(ChildProcessPool& pool) override;
 
     protected:
+        void setup() override;
         void doRun() override;
+        void addPropertiesToJUnitXMLTestReport(JUnitXMLWriter& writer) const override;
+
+    private:
+        class InMemoryRun;
+
+        void startInMemoryRun(ChildProcessPool* pool);
+        int completeInMemoryRun();
+        void checkResourceUsage(bool checkWallTime);
+        void persistCapturedOutput(CapturedOutput& output, const boost::filesystem::path& referenceFilePath);
+        void keepOutputIfFailed();
 
     private:
         std::string m_commandLine;
         bool m_checkExitCode;
         int m_expectedExitCode;
         FileComparisonTestCheck m_standardOutputTest;
+        boost::filesystem::path m_standardErrorReferenceFilePath;
+        bool m_inMemoryOutputCapture;
+        bool m_abortOnFirstMismatch;
+        CapturedOutput m_standardOutput;
+        CapturedOutput m_standardError;
+        ChildProcessResourceLimits m_resourceLimits;
+        ChildProcessResourceUsage m_resourceUsage;
+        std::shared_ptr<ForkServer> m_forkServer;
         std::function<void(int exit_code, ConsoleApplicationTest& test)> m_run_fct;
+        std::unique_ptr<InMemoryRun> m_inMemoryRun;
+        bool m_launched;
+        std::exception_ptr m_launchException;
     };
 }
 
@@ -10,10 +10,15 @@
 
 namespace Ishiko
 {
+    /// Deletes directories and everything they contain after the test has been run.
+
+    /// If the context of the test has a BackgroundDeleter the directories are handed to it instead of being deleted
+    /// immediately.
     class DirectoriesTeardownAction : public TestTeardownAction
     {
     public:
         void teardown() override;
+        void teardown(const Test& test) override;
 
         void add(const boost::filesystem::path& path);
 
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_FILEWATCHER_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_FILEWATCHER_HPP
+
+#include <boost/filesystem/path.hpp>
+#include <Ishiko/BasePlatform.hpp>
+#include <Ishiko/Errors.hpp>
+#include <chrono>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace Ishiko
+{
+    /// Waits for changes to files and directories.
+
+    /// The changes are reported by the operating system, nothing is polled. Files are watched through their parent
+    /// directory so that a file that is replaced, e.g. by a linker that writes a new file and renames it, is still
+    /// watched afterwards. The paths are reported absolute and normalized.
+    ///
+    /// This is only implemented on Linux, with inotify, at the moment, on other platforms adding a watch fails.
+    class FileWatcher
+    {
+    public:
+        FileWatcher();
+        FileWatcher(const FileWatcher& other) = delete;
+        FileWatcher& operator=(const FileWatcher& other) = delete;
+        ~FileWatcher();
+
+        static bool IsSupported() noexcept;
+
+        /// Watches a directory and all its subdirectories, including those created later.
+        void addDirectory(const boost::filesystem::path& path, Error& error);
+        /// Watches a single file. The file doesn't need to exist but its parent directory does.
+        void addFile(const boost::filesystem::path& path, Error& error);
+
+        /// Blocks until something changes then returns the paths of everything that changed until nothing changed
+        /// for quietPeriod, so that a build or a save that touches several files is reported once.
+        std::vector<boost::filesystem::path> wait(std::chrono::milliseconds quietPeriod, Error& error);
+
+    private:
+        struct Watch
+        {
+            boost::filesystem::path directory;
+            bool recursive;
+            // The files of the directory that are watched, unless the directory is watched recursively in which case
+            // they all are
+            std::set<boost::filesystem::path> files;
+        };
+
+        int addWatch(const boost::filesystem::path& directory, Error& error);
+        void addWatches(const boost::filesystem::path& directory, Error& error);
+        bool readEvents(int timeout, std::set<boost::filesystem::path>& changedPaths, Error& error);
+
+    private:
+        int m_descriptor;
+        std::map<int, Watch> m_watches;
+    };
+}
+
+#endif
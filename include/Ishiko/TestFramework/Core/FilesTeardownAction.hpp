@@ -14,10 +14,15 @@
 namespace Ishiko
 {
 
+/// Deletes files after the test has been run.
+
+/// If the context of the test has a BackgroundDeleter the files are handed to it instead of being deleted
+/// immediately.
 class FilesTeardownAction : public TestTeardownAction
 {
 public:
     void teardown() override;
+    void teardown(const Test& test) override;
 
     void add(const boost::filesystem::path& path);
 
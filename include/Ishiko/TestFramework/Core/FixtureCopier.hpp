@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_FIXTURECOPIER_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_FIXTURECOPIER_HPP
+
+#include <boost/filesystem/path.hpp>
+#include <Ishiko/BasePlatform.hpp>
+#include <Ishiko/Errors.hpp>
+#include <atomic>
+#include <cstddef>
+
+namespace Ishiko
+{
+    /// Copies fixture files and directories as cheaply as the file system allows.
+
+    /// Each file is first cloned, which on file systems that support reflinks (Btrfs, XFS, ...) shares the data with
+    /// the source until one of them is modified. If that isn't possible and the fixture has been declared read-only the
+    /// file is hard linked. Otherwise the data is copied. Directory trees are copied using several threads.
+    ///
+    /// Cloning and hard links are only implemented on Linux at the moment, on other platforms the data is always
+    /// copied.
+    class FixtureCopier
+    {
+    public:
+        FixtureCopier();
+        FixtureCopier(const FixtureCopier& other) = delete;
+        FixtureCopier& operator=(const FixtureCopier& other) = delete;
+
+        /// Allows files to be hard linked to the source.
+
+        /// A hard link is the same file as the source so this must only be used if the test doesn't modify the
+        /// files in place. Deleting or replacing them is fine.
+        void setReadOnly(bool readOnly);
+        /// Sets the number of threads used to copy directory trees. The default is the number of hardware threads.
+        void setThreadCount(size_t count);
+
+        /// Copies a file or a directory tree. If the source is a directory the destination becomes a copy of it.
+        /// Missing parent directories of the destination are created and existing files are replaced, each file is
+        /// written under a temporary name first and then renamed over the destination. Copying a file or directory
+        /// onto itself is an error.
+        void copy(const boost::filesystem::path& source, const boost::filesystem::path& destination, Error& error);
+
+        size_t clonedFileCount() const noexcept;
+        size_t linkedFileCount() const noexcept;
+        size_t copiedFileCount() const noexcept;
+
+    private:
+        bool copyFile(const boost::filesystem::path& source, const boost::filesystem::path& destination);
+
+    private:
+        bool m_readOnly;
+        size_t m_threadCount;
+        // Once an attempt fails because the file system doesn't support it we don't try again
+        std::atomic<bool> m_cloneSupported;
+        std::atomic<bool> m_linkSupported;
+        std::atomic<size_t> m_clonedFileCount;
+        std::atomic<size_t> m_linkedFileCount;
+        std::atomic<size_t> m_copiedFileCount;
+    };
+}
+
+#endif
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_FORKSERVER_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_FORKSERVER_HPP
+
+#include "ChildProcessResources.hpp"
+#include "ForkServerChild.hpp"
+#include <boost/filesystem/path.hpp>
+#include <Ishiko/BasePlatform.hpp>
+#include <Ishiko/Errors.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Ishiko
+{
+    /// Keeps a running copy of a helper program and forks new processes from it on demand.
+
+    /// Starting a process with exec means the program has to be loaded and dynamically linked every time. When the
+    /// same helper is run by many tests this cost can dominate. Instead the helper is started once as a server and
+    /// each new process is a fork of that server which then runs the main function of the helper with the arguments
+    /// it was given.
+    ///
+    /// The helper has to cooperate by passing its main function to RunIfRequested. Processes forked this way are not
+    /// children of this process but they can still be signalled and their exit status and resource usage are relayed
+    /// by the server.
+    ///
+    /// This is only implemented on Linux at the moment, on other platforms start() fails.
+    class ForkServer
+    {
+    public:
+        typedef ForkServerChild::MainFunction MainFunction;
+
+        ForkServer();
+        ForkServer(const ForkServer& other) = delete;
+        ForkServer& operator=(const ForkServer& other) = delete;
+        ~ForkServer();
+
+        static bool IsSupported() noexcept;
+        /// To be called from the main function of a helper program.
+
+        /// This is the same as ForkServerChild::RunIfRequested which helpers that don't link with this library can
+        /// use instead.
+        static int RunIfRequested(int argc, char* argv[], MainFunction mainFunction);
+
+        /// Starts the helper program in server mode.
+        void start(const boost::filesystem::path& executablePath, Error& error);
+        /// Stops the server. Processes that have already been forked keep running.
+        void stop();
+        bool isRunning() const noexcept;
+        const boost::filesystem::path& executablePath() const noexcept;
+
+        /// Forks a new process from the server.
+        /// @param arguments The arguments passed to the main function of the helper, the first one being the program
+        /// name.
+        /// @param standardOutputFD The descriptor the new process uses as its standard output.
+        /// @param standardErrorFD The descriptor the new process uses as its standard error.
+        /// @returns The process ID of the new process.
+        int spawn(const std::vector<std::string>& arguments, int standardOutputFD, int standardErrorFD, Error& error);
+        /// Forks a new process from the server with limits on the resources it can use.
+
+        /// The limits are set in the new process before its main function is called.
+        int spawn(const std::vector<std::string>& arguments, int standardOutputFD, int standardErrorFD,
+            const ChildProcessResourceLimits& limits, Error& error);
+        /// Checks whether a process forked by this server has exited.
+
+        /// The status is in the format returned by waitpid. If the server terminates unexpectedly all the processes
+        /// it forked are reported as having exited with a status of -1.
+        /// @returns true if the process has exited.
+        bool waitForExit(int pid, bool block, int& status, ChildProcessResourceUsage& resourceUsage);
+        /// A descriptor that becomes readable when the server has news about one of the processes it forked.
+        int descriptor() const noexcept;
+
+    private:
+        struct ExitStatus
+        {
+            int status;
+            ChildProcessResourceUsage resourceUsage;
+        };
+
+        bool receiveReply(bool block);
+
+    private:
+        boost::filesystem::path m_executablePath;
+        int m_socket;
+        int m_serverPID;
+        int m_startedPID;
+        std::map<int, ExitStatus> m_exitStatuses;
+    };
+}
+
+#endif
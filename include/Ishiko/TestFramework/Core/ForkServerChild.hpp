@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_FORKSERVERCHILD_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_FORKSERVERCHILD_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Ishiko
+{
+    /// The part of a ForkServer that runs in the helper program.
+
+    /// This is kept apart from ForkServer so a helper program only needs to be built with ForkServerChild.cpp and
+    /// ChildProcessResources.cpp instead of being linked with the whole library.
+    class ForkServerChild
+    {
+    public:
+        typedef int (*MainFunction)(int argc, char* argv[]);
+
+        /// To be called from the main function of a helper program.
+
+        /// If the program was started by ForkServer::start this serves fork requests until the ForkServer is stopped,
+        /// otherwise mainFunction is simply called with the arguments.
+        static int RunIfRequested(int argc, char* argv[], MainFunction mainFunction);
+
+        // The rest is the protocol between ForkServer and the helper, it is not meant to be used by anything else.
+
+        // The environment variable that tells the helper which descriptor is connected to the ForkServer
+        static const char* const SocketVariableName;
+
+        // Requests are a single message containing a RequestHeader followed by the NUL terminated arguments, with the
+        // standard output and standard error descriptors attached. They have to fit in this buffer.
+        static const size_t MaxRequestSize = 65536;
+
+        struct RequestHeader
+        {
+            int64_t maxCPUTime;
+            int64_t maxMemorySize;
+        };
+
+        enum ReplyType : int32_t
+        {
+            startedReply = 0,
+            exitedReply = 1
+        };
+
+        // The server sends a startedReply for each request, in the order the requests were received, and an
+        // exitedReply once the process has been waited for.
+        struct Reply
+        {
+            int32_t type;
+            int32_t pid;
+            int32_t status;
+            int64_t userTime;
+            int64_t systemTime;
+            int64_t maxResidentSetSize;
+            int64_t blockInputOperations;
+            int64_t blockOutputOperations;
+        };
+    };
+}
+
+#endif
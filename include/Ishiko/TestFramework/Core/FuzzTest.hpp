@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_FUZZTEST_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_FUZZTEST_HPP
+
+#include "RepeatedTestCase.hpp"
+#include "Test.hpp"
+#include <boost/filesystem/path.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Ishiko
+{
+    /// A test that runs a body with inputs produced by a coverage-guided mutator.
+
+    /// The inputs start from a corpus stored in a directory under the reference directory and are mutated until the
+    /// iteration or time budget is exhausted. If the code under test is compiled with -fsanitize-coverage=trace-pc-guard
+    /// the mutated inputs that reach new code are added to the corpus so that later mutations start from them, else
+    /// the mutations are blind. The inputs that were added to the corpus are saved to a directory named after the test
+    /// in the persistent-storage output directory, if there is one, and reused by the next runs. An input for which
+    /// the body fails or throws fails the test and is saved to the same directory with a "crash-" prefix.
+    class FuzzTest : public Test
+    {
+    public:
+        typedef std::function<void(Test& test, const std::string& input)> Body;
+
+        FuzzTest(const TestNumber& number, const std::string& name, Body body);
+        FuzzTest(const TestNumber& number, const std::string& name, Body body, const TestContext& context);
+
+        /// Returns true if the edge counters of the sanitizer coverage instrumentation are available, meaning the
+        /// fuzzing is coverage-guided.
+        static bool IsCoverageGuided() noexcept;
+
+        /// The seed of the last run, or the seed that will be used by the next run if it was set with setSeed().
+        uint64_t seed() const noexcept;
+        /// Makes the test use the given seed instead of a random one.
+        void setSeed(uint64_t seed) noexcept;
+        /// Sets the directory of the initial corpus, relative to the reference directory. Each file in it is an
+        /// input. The test starts from a single empty input if no directory is set.
+        void setCorpusDirectory(const boost::filesystem::path& path);
+        /// Sets the maximum number of mutated inputs to run. The default is 10000, 0 means no limit.
+        void setMaxIterations(size_t count) noexcept;
+        /// Sets the maximum duration of the run. The default is 10 seconds, 0 means no limit.
+        void setMaxDuration(std::chrono::milliseconds duration) noexcept;
+        /// Sets the maximum size of the mutated inputs. The default is 4096 bytes.
+        void setMaxInputSize(size_t size) noexcept;
+
+        /// The number of mutated inputs run by the last call to run(), not counting the corpus.
+        size_t iterations() const noexcept;
+        /// The size of the corpus at the end of the last call to run(), including the inputs it found.
+        size_t corpusSize() const noexcept;
+
+    protected:
+        void doRun() override;
+
+    private:
+        class Coverage;
+
+        /// Runs the body with the input and returns false if it failed or threw an exception.
+        bool execute(RepeatedTestCase& test, const std::string& input) const;
+        void loadCorpus(std::vector<std::string>& corpus) const;
+        void mutate(std::string& input, const std::vector<std::string>& corpus, std::mt19937_64& random) const;
+        void saveInput(const std::string& input, const std::string& prefix, boost::filesystem::path& path) const;
+        void reportFailure(const std::string& input, size_t iteration, const RepeatedTestCase& test);
+
+    private:
+        Body m_body;
+        uint64_t m_seed;
+        bool m_seedIsSet;
+        boost::filesystem::path m_corpusDirectory;
+        size_t m_maxIterations;
+        std::chrono::milliseconds m_maxDuration;
+        size_t m_maxInputSize;
+        size_t m_iterations;
+        size_t m_corpusSize;
+    };
+}
+
+#endif
@@ -17,6 +17,8 @@ namespace Ishiko
         HeapAllocationErrorsTest(const TestNumber& number, const std::string& name,
             void (*runFct)(Test& test), const TestContext& context);
 
+        void reset() override;
+
         void addToJUnitXMLTestReport(JUnitXMLWriter& writer) const;
 
     protected:
@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_INCREMENTALFILECOMPARISON_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_INCREMENTALFILECOMPARISON_HPP
+
+#include <boost/filesystem/path.hpp>
+#include <Ishiko/Errors.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace Ishiko
+{
+    /// Compares data that arrives in chunks against the contents of a reference file.
+
+    /// This allows output to be compared while it is being produced without storing it first. The comparison stops
+    /// at the first difference.
+    class IncrementalFileComparison
+    {
+    public:
+        IncrementalFileComparison();
+        IncrementalFileComparison(const IncrementalFileComparison& other) = delete;
+        IncrementalFileComparison& operator=(const IncrementalFileComparison& other) = delete;
+        ~IncrementalFileComparison();
+
+        void open(const boost::filesystem::path& referenceFilePath, Error& error);
+        void close();
+        bool isOpen() const noexcept;
+
+        /// Compares the next chunk of data with the reference.
+        /// @returns false if a difference has been found, either in this chunk or in a previous one.
+        bool compare(const char* data, size_t size);
+        /// Indicates the end of the data.
+        /// @returns false if a difference has been found or if the reference file has more data.
+        bool finish();
+
+        bool mismatch() const noexcept;
+        /// The offset of the first byte that differs from the reference.
+        size_t mismatchOffset() const noexcept;
+        /// The 1-based line number at which the first difference occurs.
+        size_t mismatchLine() const noexcept;
+        const boost::filesystem::path& referenceFilePath() const noexcept;
+
+    private:
+        void setMismatch(size_t relativeOffset, const char* data);
+
+    private:
+        boost::filesystem::path m_referenceFilePath;
+        FILE* m_referenceFile;
+        std::vector<char> m_buffer;
+        size_t m_offset;
+        size_t m_line;
+        bool m_mismatch;
+    };
+}
+
+#endif
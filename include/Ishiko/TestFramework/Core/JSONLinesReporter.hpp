@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_JSONLINESREPORTER_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_JSONLINESREPORTER_HPP
+
+#include "TestReporter.hpp"
+#include <ostream>
+
+namespace Ishiko
+{
+    /// Writes a JSON object on a line of its own for each test case as soon as it completes.
+
+    /// Each object has the number, name and result of the test, its duration in microseconds and its failures, each
+    /// with a message and, unless it was an exception, the file and line of the check, e.g.
+    /// {"number":"1.2","name":"test","result":"failed","duration":15,"failures":[{"message":"","file":"a.cpp","line":3}]}
+    class JSONLinesReporter : public TestReporter
+    {
+    public:
+        JSONLinesReporter(std::ostream& output);
+
+        /// Writes a test number in the format used in the records, e.g. "1.2", quotes included.
+        static void WriteNumber(std::ostream& output, const TestNumber& number);
+        /// Writes a JSON string, quotes included.
+        static void WriteString(std::ostream& output, const std::string& value);
+
+    protected:
+        void onTestCaseCompleted(const Test& test, std::chrono::microseconds duration,
+            const std::vector<Failure>& failures) override;
+        void onRunCompleted() override;
+
+    private:
+        std::ostream& m_output;
+    };
+}
+
+#endif
@@ -28,6 +28,9 @@ public:
     void writeTestSuiteEnd();
     void writeTestCaseStart(const std::string& classname, const std::string& name);
     void writeTestCaseEnd();
+    void writePropertiesStart();
+    void writePropertiesEnd();
+    void writeProperty(const std::string& name, const std::string& value);
     void writeFailureStart();
     void writeFailureEnd();
     void writeSkippedStart();
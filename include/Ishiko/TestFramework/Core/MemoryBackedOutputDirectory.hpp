@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_MEMORYBACKEDOUTPUTDIRECTORY_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_MEMORYBACKEDOUTPUTDIRECTORY_HPP
+
+#include <boost/filesystem/path.hpp>
+#include <Ishiko/Errors.hpp>
+#include <cstddef>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace Ishiko
+{
+    /// An output directory that lives on a memory-backed file system and only copies to disk what is worth keeping.
+
+    /// Most tests pass and their output is never looked at so writing it to disk is wasted effort. Instead the
+    /// output is written to a directory created under a tmpfs mount such as /dev/shm. Files that failing checks
+    /// compared are marked with keep() and copyOut() copies them to the same relative location under the disk
+    /// directory. Everything else is discarded by remove().
+    class MemoryBackedOutputDirectory
+    {
+    public:
+        MemoryBackedOutputDirectory();
+        MemoryBackedOutputDirectory(const MemoryBackedOutputDirectory& other) = delete;
+        MemoryBackedOutputDirectory& operator=(const MemoryBackedOutputDirectory& other) = delete;
+        /// Calls remove().
+        ~MemoryBackedOutputDirectory();
+
+        /// Creates a new uniquely named directory under root.
+        /// @param root A directory on a memory-backed file system, typically /dev/shm.
+        /// @param diskPath The directory the kept files are copied to.
+        void create(const boost::filesystem::path& root, const boost::filesystem::path& diskPath, Error& error);
+        /// Deletes the directory and everything in it.
+        void remove();
+
+        const boost::filesystem::path& path() const noexcept;
+        const boost::filesystem::path& diskPath() const noexcept;
+
+        /// Marks a file or directory inside this directory to be copied to disk. Paths outside of it are ignored.
+        /// This function can be called from several threads.
+        void keep(const boost::filesystem::path& path);
+        size_t keptCount() const;
+        /// Copies the kept paths that exist to the disk directory. A path that doesn't exist is skipped.
+
+        /// A path that can't be copied doesn't stop the others from being copied.
+        ///
+        /// @param error Set if any of the paths couldn't be copied.
+        /// @returns The kept paths, relative to the directory, that couldn't be copied.
+        std::vector<boost::filesystem::path> copyOut(Error& error);
+
+    private:
+        boost::filesystem::path m_path;
+        boost::filesystem::path m_diskPath;
+        mutable std::mutex m_mutex;
+        std::set<boost::filesystem::path> m_keptPaths;
+    };
+}
+
+#endif
@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_PARAMETERIZEDTEST_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_PARAMETERIZEDTEST_HPP
+
+#include "Test.hpp"
+#include <functional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Ishiko
+{
+    /// The part of ParameterizedTest that doesn't depend on the type of the parameter.
+
+    /// The cases are enumerated when the test is run and they are all run by the same Test object, so no test is
+    /// created per case. Each case still gets its own number and name and is reported individually to the observers
+    /// and in the JUnit XML report. Only the name, result and first failure of each case are kept once it has run.
+    class ParameterizedTestBase : public Test
+    {
+    public:
+        ParameterizedTestBase(const TestNumber& number, const std::string& name, const TestContext& context);
+
+        /// The number of cases run by the last call to run().
+        size_t caseCount() const noexcept;
+        const std::string& caseName(size_t pos) const;
+        TestResult caseResult(size_t pos) const;
+
+        void getPassRate(size_t& unknown, size_t& passed, size_t& passedButMemoryLeaks, size_t& exception,
+            size_t& failed, size_t& skipped, size_t& total) const override;
+
+        void addToJUnitXMLTestReport(JUnitXMLWriter& writer) const override;
+
+    protected:
+        /// Goes back to the first case, called at the start of each run.
+        virtual void rewindCases() = 0;
+        /// Moves to the next case. Returns false if there are no more cases, else sets the name of the case.
+        virtual bool nextCase(std::string& name) = 0;
+        /// Runs the current case.
+        virtual void runCase(Test& test) = 0;
+
+        /// Returns false, only the cases get an isolated output directory.
+        bool hasIsolatedOutputDirectory() const override;
+        void doRun() override;
+
+    private:
+        class Case;
+        class CaseObserver;
+
+        struct CaseResult
+        {
+            std::string name;
+            TestResult result;
+            // The first check that failed or the exception that was thrown, if any
+            std::string failure;
+        };
+
+        std::vector<CaseResult> m_cases;
+    };
+
+    /// A test that runs the same body for each of the parameters returned by a generator.
+
+    /// The parameters are only generated when the test is run, one at a time. Parameter must be default
+    /// constructible and assignable.
+    template<typename Parameter>
+    class ParameterizedTest : public ParameterizedTestBase
+    {
+    public:
+        /// Assigns the next parameter and returns true, or returns false if there are no more parameters.
+        typedef std::function<bool(Parameter& parameter)> Generator;
+        /// Returns the name of the case for a parameter.
+        typedef std::function<std::string(const Parameter& parameter)> Namer;
+        typedef std::function<void(Test& test, const Parameter& parameter)> Body;
+
+        /// Constructor. The cases are named after the test followed by the parameter in brackets, which requires
+        /// Parameter to be usable with operator<<.
+        ParameterizedTest(const TestNumber& number, const std::string& name, Generator generator, Body body);
+        ParameterizedTest(const TestNumber& number, const std::string& name, Generator generator, Body body,
+            const TestContext& context);
+        ParameterizedTest(const TestNumber& number, const std::string& name, Generator generator, Namer namer,
+            Body body);
+        ParameterizedTest(const TestNumber& number, const std::string& name, Generator generator, Namer namer,
+            Body body, const TestContext& context);
+
+        /// A generator that returns each of the values in turn.
+        static Generator Values(std::vector<Parameter> values);
+        /// A generator that returns the values from first to last, last excluded.
+        static Generator Range(Parameter first, Parameter last);
+
+    protected:
+        void rewindCases() override;
+        bool nextCase(std::string& name) override;
+        void runCase(Test& test) override;
+
+    private:
+        static Namer DefaultNamer(const std::string& name);
+
+    private:
+        Generator m_generator;
+        // Generators are consumed as they go, each run starts from a copy of m_generator
+        Generator m_remainingCases;
+        Namer m_namer;
+        Body m_body;
+        Parameter m_parameter;
+    };
+}
+
+template<typename Parameter>
+Ishiko::ParameterizedTest<Parameter>::ParameterizedTest(const TestNumber& number, const std::string& name,
+    Generator generator, Body body)
+    : ParameterizedTestBase(number, name, TestContext::DefaultTestContext()), m_generator(std::move(generator)),
+    m_namer(DefaultNamer(name)), m_body(std::move(body)), m_parameter()
+{
+}
+
+template<typename Parameter>
+Ishiko::ParameterizedTest<Parameter>::ParameterizedTest(const TestNumber& number, const std::string& name,
+    Generator generator, Body body, const TestContext& context)
+    : ParameterizedTestBase(number, name, context), m_generator(std::move(generator)), m_namer(DefaultNamer(name)),
+    m_body(std::move(body)), m_parameter()
+{
+}
+
+template<typename Parameter>
+Ishiko::ParameterizedTest<Parameter>::ParameterizedTest(const TestNumber& number, const std::string& name,
+    Generator generator, Namer namer, Body body)
+    : ParameterizedTestBase(number, name, TestContext::DefaultTestContext()), m_generator(std::move(generator)),
+    m_namer(std::move(namer)), m_body(std::move(body)), m_parameter()
+{
+}
+
+template<typename Parameter>
+Ishiko::ParameterizedTest<Parameter>::ParameterizedTest(const TestNumber& number, const std::string& name,
+    Generator generator, Namer namer, Body body, const TestContext& context)
+    : ParameterizedTestBase(number, name, context), m_generator(std::move(generator)), m_namer(std::move(namer)),
+    m_body(std::move(body)), m_parameter()
+{
+}
+
+template<typename Parameter>
+typename Ishiko::ParameterizedTest<Parameter>::Generator Ishiko::ParameterizedTest<Parameter>::Values(
+    std::vector<Parameter> values)
+{
+    size_t next = 0;
+    return [values, next](Parameter& parameter) mutable -> bool
+    {
+        if (next == values.size())
+        {
+            return false;
+        }
+        parameter = values[next++];
+        return true;
+    };
+}
+
+template<typename Parameter>
+typename Ishiko::ParameterizedTest<Parameter>::Generator Ishiko::ParameterizedTest<Parameter>::Range(
+    Parameter first, Parameter last)
+{
+    return [first, last](Parameter& parameter) mutable -> bool
+    {
+        if (!(first < last))
+        {
+            return false;
+        }
+        parameter = first;
+        ++first;
+        return true;
+    };
+}
+
+template<typename Parameter>
+void Ishiko::ParameterizedTest<Parameter>::rewindCases()
+{
+    m_remainingCases = m_generator;
+}
+
+template<typename Parameter>
+bool Ishiko::ParameterizedTest<Parameter>::nextCase(std::string& name)
+{
+    if (!m_remainingCases(m_parameter))
+    {
+        return false;
+    }
+    name = m_namer(m_parameter);
+    return true;
+}
+
+template<typename Parameter>
+void Ishiko::ParameterizedTest<Parameter>::runCase(Test& test)
+{
+    m_body(test, m_parameter);
+}
+
+template<typename Parameter>
+typename Ishiko::ParameterizedTest<Parameter>::Namer Ishiko::ParameterizedTest<Parameter>::DefaultNamer(
+    const std::string& name)
+{
+    return [name](const Parameter& parameter) -> std::string
+    {
+        std::stringstream caseName;
+        caseName << name << " [" << parameter << "]";
+        return caseName.str();
+    };
+}
+
+#endif
@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_PERSISTENTSTORAGE_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_PERSISTENTSTORAGE_HPP
+
+#include "Test.hpp"
+#include <boost/filesystem/path.hpp>
+#include <Ishiko/Errors.hpp>
+
+namespace Ishiko
+{
+    /// The files of failed tests kept in the "persistent-storage" output directory of the test context.
+
+    /// The files of a test are saved to a directory named after the test so that they can be inspected, or used to
+    /// update the reference files, once the run is over. Nothing is saved if the context has no persistent-storage
+    /// directory.
+    class PersistentStorage
+    {
+    public:
+        /// Returns the directory of the test, or an empty path if there is no persistent-storage directory.
+        static boost::filesystem::path GetTestDirectory(const Test& test);
+        /// Same as GetTestDirectory() but the directory is created if it doesn't exist yet.
+        static boost::filesystem::path CreateTestDirectory(const Test& test, Error& error);
+        /// Copies a file to the directory of the test.
+        static void CopySingleFile(const Test& test, const boost::filesystem::path& path, Error& error);
+    };
+}
+
+#endif
@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_PIPEDCHILDPROCESS_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_PIPEDCHILDPROCESS_HPP
+
+#include "ChildProcessResources.hpp"
+#include "ForkServer.hpp"
+#include <Ishiko/BasePlatform.hpp>
+#include <Ishiko/Errors.hpp>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Ishiko
+{
+    /// A child process whose standard output and standard error are connected to pipes.
+
+    /// The output is delivered to the callbacks as it is read from the pipes so nothing goes through the file system.
+    /// This is only implemented on Linux at the moment, on other platforms start() fails.
+    class PipedChildProcess
+    {
+    public:
+        class Callbacks
+        {
+        public:
+            virtual ~Callbacks() noexcept = default;
+
+            virtual void onStandardOutput(const char* data, size_t size);
+            virtual void onStandardError(const char* data, size_t size);
+        };
+
+        PipedChildProcess();
+        PipedChildProcess(const PipedChildProcess& other) = delete;
+        PipedChildProcess& operator=(const PipedChildProcess& other) = delete;
+        ~PipedChildProcess();
+
+        static bool IsSupported() noexcept;
+        /// Splits a command line into the arguments passed to the child.
+
+        /// The rules are a subset of those of the POSIX shell, there is no expansion of any kind:
+        /// - arguments are separated by spaces and tabs,
+        /// - characters between single quotes are taken literally,
+        /// - between double quotes a backslash only escapes a double quote or a backslash, it is kept otherwise,
+        /// - anywhere else a backslash escapes the character that follows it,
+        /// - quotes can be used in the middle of an argument and "" or '' on its own is an empty argument.
+        static std::vector<std::string> SplitCommandLine(const std::string& commandLine);
+
+        /// Sets the limits that are applied to the child when it is started.
+
+        /// The limits are set in the child before the program is executed.
+        void setResourceLimits(const ChildProcessResourceLimits& limits);
+        /// Sets a server from which the child is forked instead of being started with exec.
+
+        /// The first argument of the command line is passed to the helper as its program name but it is otherwise
+        /// ignored, the program that runs is the one the server was started with.
+        void setForkServer(std::shared_ptr<ForkServer> server);
+
+        void start(const std::string& commandLine, Callbacks& callbacks, Error& error);
+        /// Starts the child without pipes, it inherits the standard output and standard error of this process.
+        void start(const std::string& commandLine, Error& error);
+
+        /// Waits up to timeout milliseconds for output and passes whatever is available to the callbacks. A negative
+        /// timeout waits indefinitely.
+        /// @returns false once both output streams have been closed by the child.
+        bool readOutput(int timeout);
+        void readAllOutput();
+        /// Reads whatever is available on one of the output descriptors and passes it to the callbacks.
+
+        /// This is meant to be used by code that waits on the descriptors of several processes at once, like
+        /// ChildProcessPool. The call is ignored if descriptor is not one of the output descriptors of this process.
+        void readDescriptor(int descriptor);
+        /// Closes the pipes. Any output the child writes afterwards is lost.
+        void stopReading();
+
+        /// The read ends of the pipes, -1 once the corresponding stream has been closed.
+        int standardOutputDescriptor() const noexcept;
+        int standardErrorDescriptor() const noexcept;
+        /// A descriptor that becomes readable when the child exits, -1 if the platform doesn't provide one or the child
+        /// has already been waited for. If the child was forked by a ForkServer this is the descriptor of the server
+        /// which is shared by all the processes it forked, it also becomes readable when other processes exit.
+        int exitDescriptor() const noexcept;
+
+        void kill();
+        void waitForExit();
+        /// Checks whether the child has exited without blocking.
+        /// @returns true if the child has exited.
+        bool tryWaitForExit();
+        bool hasExited() const noexcept;
+        int exitCode() const noexcept;
+        /// The resources consumed by the child, only available once it has exited.
+        const ChildProcessResourceUsage& resourceUsage() const noexcept;
+
+    private:
+        void spawn(const std::string& commandLine, Callbacks* callbacks, Error& error);
+        bool readStream(int& fd, bool standardOutput);
+        bool reap(bool block);
+        void setExitStatus(int status);
+
+    private:
+        Callbacks* m_callbacks;
+        int m_pid;
+        int m_standardOutputFD;
+        int m_standardErrorFD;
+        int m_exitFD;
+        bool m_exited;
+        int m_exitCode;
+        ChildProcessResourceLimits m_resourceLimits;
+        std::shared_ptr<ForkServer> m_forkServer;
+        ChildProcessResourceUsage m_resourceUsage;
+        std::chrono::steady_clock::time_point m_startTime;
+    };
+}
+
+#endif
@@ -4,6 +4,9 @@
 #ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_PROCESSACTION_HPP
 #define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_PROCESSACTION_HPP
 
+#include "ChildProcessResources.hpp"
+#include "ForkServer.hpp"
+#include "PipedChildProcess.hpp"
 #include "TestSetupAction.hpp"
 #include "TestTeardownAction.hpp"
 #include "Ishiko/Process/ChildProcess.hpp"
@@ -27,12 +30,22 @@ public:
     ProcessAction(const std::string& commandLine, EMode mode);
     ~ProcessAction() override;
 
+    /// Forks the process from a server instead of starting it with exec. This is ignored on platforms where
+    /// PipedChildProcess is not supported.
+    void setForkServer(std::shared_ptr<ForkServer> server);
+
     void setup(const Test& test) override;
     void teardown() override;
 
+    /// The resources used by the process. This is only available after teardown and only on platforms where
+    /// PipedChildProcess is supported.
+    const ChildProcessResourceUsage& resourceUsage() const;
+
 private:
     std::string m_commandLine;
     EMode m_mode;
+    // PipedChildProcess is used when it is supported because it reports the resource usage, ChildProcess otherwise
+    PipedChildProcess m_process;
     ChildProcess m_processHandle;
 };
 
@@ -0,0 +1,330 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_PROPERTYGENERATOR_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_PROPERTYGENERATOR_HPP
+
+#include "TestException.hpp"
+#include <functional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Ishiko
+{
+    /// Generates the random inputs of a PropertyTest and the simpler inputs used to shrink a counterexample.
+
+    /// Generators are composed from the basic ones with vectors(), strings(), pairWith(), map() and filter(). The
+    /// functions may be called from several threads at once so they must not modify shared state.
+    template<typename T>
+    class PropertyGenerator
+    {
+    public:
+        typedef std::function<T(std::mt19937_64& random)> GenerateFunction;
+        /// Returns values that are simpler than the given one, the simplest first.
+        typedef std::function<std::vector<T>(const T& value)> ShrinkFunction;
+
+        /// Constructor. The values of a generator created without a shrink function are not shrunk.
+        PropertyGenerator(GenerateFunction generate);
+        PropertyGenerator(GenerateFunction generate, ShrinkFunction shrink);
+
+        /// Integers between min and max, both included. They shrink towards 0, or the bound closest to it.
+        static PropertyGenerator<T> Integers(T min, T max);
+        /// One of the values. They shrink towards the first value. Throws a TestException if values is empty.
+        static PropertyGenerator<T> Elements(std::vector<T> values);
+
+        T generate(std::mt19937_64& random) const;
+        std::vector<T> shrink(const T& value) const;
+
+        /// Vectors of up to maxSize values. They shrink by removing values and then by shrinking the values.
+        PropertyGenerator<std::vector<T>> vectors(size_t maxSize) const;
+        /// Strings of up to maxSize characters from this generator, T must be char. They shrink like vectors.
+        PropertyGenerator<std::string> strings(size_t maxSize) const;
+        /// Pairs of a value from this generator and a value from the other one. The first value is shrunk first.
+        template<typename U>
+        PropertyGenerator<std::pair<T, U>> pairWith(PropertyGenerator<U> other) const;
+        /// The values of this generator transformed by function. The transformed values can't be shrunk since the
+        /// function can't be reversed.
+        template<typename U>
+        PropertyGenerator<U> map(std::function<U(const T& value)> function) const;
+        /// The values of this generator for which predicate returns true. Generating a value fails with a
+        /// TestException if the predicate keeps rejecting them.
+        PropertyGenerator<T> filter(std::function<bool(const T& value)> predicate) const;
+
+    private:
+        template<typename Sequence>
+        static std::vector<Sequence> ShrinkSequence(const Sequence& value,
+            const std::function<std::vector<typename Sequence::value_type>(
+                const typename Sequence::value_type& element)>& shrinkElement);
+
+    private:
+        GenerateFunction m_generate;
+        ShrinkFunction m_shrink;
+    };
+}
+
+template<typename T>
+Ishiko::PropertyGenerator<T>::PropertyGenerator(GenerateFunction generate)
+    : m_generate(std::move(generate))
+{
+}
+
+template<typename T>
+Ishiko::PropertyGenerator<T>::PropertyGenerator(GenerateFunction generate, ShrinkFunction shrink)
+    : m_generate(std::move(generate)), m_shrink(std::move(shrink))
+{
+}
+
+template<typename T>
+Ishiko::PropertyGenerator<T> Ishiko::PropertyGenerator<T>::Integers(T min, T max)
+{
+    static_assert(std::is_integral<T>::value, "T must be an integral type");
+
+    // uniform_int_distribution isn't defined for the character types so we always use a 64-bit type
+    typedef typename std::conditional<std::is_signed<T>::value, long long, unsigned long long>::type Wide;
+    typedef typename std::make_unsigned<T>::type Unsigned;
+
+    return PropertyGenerator<T>(
+        [min, max](std::mt19937_64& random) -> T
+        {
+            std::uniform_int_distribution<Wide> distribution(min, max);
+            return static_cast<T>(distribution(random));
+        },
+        [min, max](const T& value) -> std::vector<T>
+        {
+            std::vector<T> result;
+            T target = ((min > 0) ? min : ((max < 0) ? max : 0));
+            if (value == target)
+            {
+                return result;
+            }
+            result.push_back(target);
+
+            // Try values closer and closer to the current one, halving the distance each time
+            Unsigned distance = ((value > target) ? static_cast<Unsigned>(static_cast<Unsigned>(value) - target)
+                : static_cast<Unsigned>(target - static_cast<Unsigned>(value)));
+            for (Unsigned step = (distance / 2); step > 0; step /= 2)
+            {
+                Unsigned candidate = ((value > target) ? (static_cast<Unsigned>(value) - step)
+                    : (static_cast<Unsigned>(value) + step));
+                result.push_back(static_cast<T>(candidate));
+            }
+            return result;
+        });
+}
+
+template<typename T>
+Ishiko::PropertyGenerator<T> Ishiko::PropertyGenerator<T>::Elements(std::vector<T> values)
+{
+    if (values.empty())
+    {
+        throw TestException("PropertyGenerator::Elements: there must be at least one value");
+    }
+
+    return PropertyGenerator<T>(
+        [values](std::mt19937_64& random) -> T
+        {
+            std::uniform_int_distribution<size_t> distribution(0, (values.size() - 1));
+            return values[distribution(random)];
+        },
+        [values](const T& value) -> std::vector<T>
+        {
+            std::vector<T> result;
+            for (const T& v : values)
+            {
+                if (v == value)
+                {
+                    break;
+                }
+                result.push_back(v);
+            }
+            return result;
+        });
+}
+
+template<typename T>
+T Ishiko::PropertyGenerator<T>::generate(std::mt19937_64& random) const
+{
+    return m_generate(random);
+}
+
+template<typename T>
+std::vector<T> Ishiko::PropertyGenerator<T>::shrink(const T& value) const
+{
+    if (m_shrink)
+    {
+        return m_shrink(value);
+    }
+    else
+    {
+        return std::vector<T>();
+    }
+}
+
+template<typename T>
+Ishiko::PropertyGenerator<std::vector<T>> Ishiko::PropertyGenerator<T>::vectors(size_t maxSize) const
+{
+    PropertyGenerator<T> element = *this;
+    return PropertyGenerator<std::vector<T>>(
+        [element, maxSize](std::mt19937_64& random) -> std::vector<T>
+        {
+            std::uniform_int_distribution<size_t> sizeDistribution(0, maxSize);
+            size_t size = sizeDistribution(random);
+            std::vector<T> result;
+            result.reserve(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                result.push_back(element.generate(random));
+            }
+            return result;
+        },
+        [element](const std::vector<T>& value) -> std::vector<std::vector<T>>
+        {
+            return ShrinkSequence<std::vector<T>>(value,
+                [&element](const T& e)
+                {
+                    return element.shrink(e);
+                });
+        });
+}
+
+template<typename T>
+Ishiko::PropertyGenerator<std::string> Ishiko::PropertyGenerator<T>::strings(size_t maxSize) const
+{
+    static_assert(std::is_same<T, char>::value, "strings() can only be used with a generator of char");
+
+    PropertyGenerator<char> character = *this;
+    return PropertyGenerator<std::string>(
+        [character, maxSize](std::mt19937_64& random) -> std::string
+        {
+            std::uniform_int_distribution<size_t> sizeDistribution(0, maxSize);
+            size_t size = sizeDistribution(random);
+            std::string result;
+            result.reserve(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                result.push_back(character.generate(random));
+            }
+            return result;
+        },
+        [character](const std::string& value) -> std::vector<std::string>
+        {
+            return ShrinkSequence<std::string>(value,
+                [&character](const char& c)
+                {
+                    return character.shrink(c);
+                });
+        });
+}
+
+template<typename T>
+template<typename U>
+Ishiko::PropertyGenerator<std::pair<T, U>> Ishiko::PropertyGenerator<T>::pairWith(PropertyGenerator<U> other) const
+{
+    PropertyGenerator<T> first = *this;
+    return PropertyGenerator<std::pair<T, U>>(
+        [first, other](std::mt19937_64& random) -> std::pair<T, U>
+        {
+            T firstValue = first.generate(random);
+            return std::pair<T, U>(std::move(firstValue), other.generate(random));
+        },
+        [first, other](const std::pair<T, U>& value) -> std::vector<std::pair<T, U>>
+        {
+            std::vector<std::pair<T, U>> result;
+            for (T& candidate : first.shrink(value.first))
+            {
+                result.push_back(std::pair<T, U>(std::move(candidate), value.second));
+            }
+            for (U& candidate : other.shrink(value.second))
+            {
+                result.push_back(std::pair<T, U>(value.first, std::move(candidate)));
+            }
+            return result;
+        });
+}
+
+template<typename T>
+template<typename U>
+Ishiko::PropertyGenerator<U> Ishiko::PropertyGenerator<T>::map(std::function<U(const T& value)> function) const
+{
+    PropertyGenerator<T> source = *this;
+    return PropertyGenerator<U>(
+        [source, function](std::mt19937_64& random) -> U
+        {
+            return function(source.generate(random));
+        });
+}
+
+template<typename T>
+Ishiko::PropertyGenerator<T> Ishiko::PropertyGenerator<T>::filter(std::function<bool(const T& value)> predicate) const
+{
+    PropertyGenerator<T> source = *this;
+    return PropertyGenerator<T>(
+        [source, predicate](std::mt19937_64& random) -> T
+        {
+            for (size_t i = 0; i < 1000; ++i)
+            {
+                T result = source.generate(random);
+                if (predicate(result))
+                {
+                    return result;
+                }
+            }
+            throw TestException("PropertyGenerator::filter: the predicate rejected 1000 values in a row");
+        },
+        [source, predicate](const T& value) -> std::vector<T>
+        {
+            std::vector<T> result;
+            for (T& candidate : source.shrink(value))
+            {
+                if (predicate(candidate))
+                {
+                    result.push_back(std::move(candidate));
+                }
+            }
+            return result;
+        });
+}
+
+template<typename T>
+template<typename Sequence>
+std::vector<Sequence> Ishiko::PropertyGenerator<T>::ShrinkSequence(const Sequence& value,
+    const std::function<std::vector<typename Sequence::value_type>(
+        const typename Sequence::value_type& element)>& shrinkElement)
+{
+    std::vector<Sequence> result;
+    if (value.empty())
+    {
+        return result;
+    }
+
+    // Remove large chunks first, then single elements, and finally try to simplify the elements that remain
+    result.push_back(Sequence());
+    for (size_t chunk = (value.size() / 2); chunk > 0; chunk /= 2)
+    {
+        for (size_t start = 0; (start + chunk) <= value.size(); start += chunk)
+        {
+            if ((chunk == value.size()) && (start == 0))
+            {
+                continue;
+            }
+            Sequence candidate(value.begin(), (value.begin() + start));
+            candidate.insert(candidate.end(), (value.begin() + start + chunk), value.end());
+            result.push_back(std::move(candidate));
+        }
+    }
+    for (size_t i = 0; i < value.size(); ++i)
+    {
+        for (typename Sequence::value_type& element : shrinkElement(value[i]))
+        {
+            Sequence candidate = value;
+            candidate[i] = std::move(element);
+            result.push_back(std::move(candidate));
+        }
+    }
+    return result;
+}
+
+#endif
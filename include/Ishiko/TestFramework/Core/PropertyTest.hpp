@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_PROPERTYTEST_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_PROPERTYTEST_HPP
+
+#include "PropertyGenerator.hpp"
+#include "RepeatedTestCase.hpp"
+#include "Test.hpp"
+#include "TestMacrosFormatter.hpp"
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Ishiko
+{
+    /// The part of PropertyTest that doesn't depend on the type of the input.
+    class PropertyTestBase : public Test
+    {
+    public:
+        PropertyTestBase(const TestNumber& number, const std::string& name, const TestContext& context);
+
+        /// The seed of the last run, or the seed that will be used by the next run if it was set with setSeed().
+        uint64_t seed() const noexcept;
+        /// Makes the test use the given seed instead of a random one. Running the test again with the seed reported
+        /// by a failure generates the same inputs.
+        void setSeed(uint64_t seed) noexcept;
+        size_t caseCount() const noexcept;
+        /// Sets the number of inputs to generate. The default is 100.
+        void setCaseCount(size_t count) noexcept;
+        size_t parallelism() const noexcept;
+        /// Sets the number of threads the cases are run on. The default is the number of cores. The property must be
+        /// safe to call from several threads at once unless this is set to 1, which is also needed if the property
+        /// uses the context of the test.
+        void setParallelism(size_t parallelism) noexcept;
+
+    protected:
+        /// The test the property is run on for each input.
+        typedef RepeatedTestCase Case;
+
+        /// Generates the input with the given index and checks the property. This is called from several threads at
+        /// once.
+        virtual bool checkGeneratedCase(Case& test, size_t index) = 0;
+        /// Shrinks the input with the given index, which failed, and reports the result with reportCounterexample().
+        virtual void shrinkAndReport(Case& test, size_t index) = 0;
+
+        /// The random number generator for the input with the given index. It only depends on the seed and the index
+        /// so the inputs are the same whatever the order the cases are run in.
+        std::mt19937_64 caseRandom(size_t index) const;
+        /// Fails the test with a message that has everything needed to replay the failure.
+        /// @param test The test the minimal input was last checked on.
+        void reportCounterexample(const std::string& input, size_t index, size_t shrinkSteps, const Case& test);
+
+        void doRun() override;
+
+    protected:
+        // Stop shrinking after that many steps, each step can check many candidates
+        static const size_t maxShrinkSteps = 1000;
+
+    private:
+        uint64_t m_seed;
+        bool m_seedIsSet;
+        size_t m_caseCount;
+        size_t m_parallelism;
+    };
+
+    /// A test that checks a property holds for randomly generated inputs.
+
+    /// The property uses the ISHIKO_TEST_* macros like a normal test function. The inputs are generated from a seed
+    /// and checked in parallel. If the property fails for an input the test looks for a simpler input it also fails
+    /// for and reports the simplest one it found along with the seed.
+    template<typename Input>
+    class PropertyTest : public PropertyTestBase
+    {
+    public:
+        typedef std::function<void(Test& test, const Input& input)> Property;
+
+        PropertyTest(const TestNumber& number, const std::string& name, PropertyGenerator<Input> generator,
+            Property property);
+        PropertyTest(const TestNumber& number, const std::string& name, PropertyGenerator<Input> generator,
+            Property property, const TestContext& context);
+
+    protected:
+        bool checkGeneratedCase(Case& test, size_t index) override;
+        void shrinkAndReport(Case& test, size_t index) override;
+
+    private:
+        bool check(Case& test, const Input& input) const;
+
+    private:
+        PropertyGenerator<Input> m_generator;
+        Property m_property;
+    };
+}
+
+template<typename Input>
+Ishiko::PropertyTest<Input>::PropertyTest(const TestNumber& number, const std::string& name,
+    PropertyGenerator<Input> generator, Property property)
+    : PropertyTestBase(number, name, TestContext::DefaultTestContext()), m_generator(std::move(generator)),
+    m_property(std::move(property))
+{
+}
+
+template<typename Input>
+Ishiko::PropertyTest<Input>::PropertyTest(const TestNumber& number, const std::string& name,
+    PropertyGenerator<Input> generator, Property property, const TestContext& context)
+    : PropertyTestBase(number, name, context), m_generator(std::move(generator)), m_property(std::move(property))
+{
+}
+
+template<typename Input>
+bool Ishiko::PropertyTest<Input>::checkGeneratedCase(Case& test, size_t index)
+{
+    std::mt19937_64 random = caseRandom(index);
+    Input input = m_generator.generate(random);
+    return check(test, input);
+}
+
+template<typename Input>
+void Ishiko::PropertyTest<Input>::shrinkAndReport(Case& test, size_t index)
+{
+    std::mt19937_64 random = caseRandom(index);
+    Input minimalInput = m_generator.generate(random);
+
+    size_t steps = 0;
+    bool shrunk = true;
+    while (shrunk && (steps < maxShrinkSteps))
+    {
+        shrunk = false;
+        for (Input& candidate : m_generator.shrink(minimalInput))
+        {
+            if (!check(test, candidate))
+            {
+                minimalInput = std::move(candidate);
+                ++steps;
+                shrunk = true;
+                break;
+            }
+        }
+    }
+
+    // Check the minimal input again so that the test holds its failure and not the one of the last candidate
+    check(test, minimalInput);
+
+    std::string formattedInput;
+    if (!Internal::UniversalFormatter<Input>::Format(minimalInput, formattedInput))
+    {
+        formattedInput = "<not printable>";
+    }
+    reportCounterexample(formattedInput, index, steps, test);
+}
+
+template<typename Input>
+bool Ishiko::PropertyTest<Input>::check(Case& test, const Input& input) const
+{
+    return test.check(
+        [this, &input](Test& test)
+        {
+            m_property(test, input);
+        });
+}
+
+#endif
@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_REPEATEDTESTCASE_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_REPEATEDTESTCASE_HPP
+
+#include "Test.hpp"
+#include <exception>
+#include <memory>
+#include <string>
+
+namespace Ishiko
+{
+    /// A test that runs a test function again and again, e.g. once per generated input, and records the first failure
+    /// of each run.
+
+    /// The test has the number, name and context of the test that owns it so the checks of the function report
+    /// failures as if they happened in the owner. The owner decides what to do with a failure, typically it fails
+    /// itself with a message that includes the input and the recorded failure.
+    class RepeatedTestCase : public Test
+    {
+    public:
+        RepeatedTestCase(const Test& owner);
+
+        /// Calls the function with this test and returns false if it failed or threw an exception. An input the
+        /// function skips is considered as passing.
+        template<typename F>
+        bool check(F&& function);
+
+        /// The message of the first check that failed during the last call to check(), or a description of the
+        /// exception it threw.
+        const std::string& failureMessage() const noexcept;
+        const char* failureFile() const noexcept;
+        /// The line of the first check that failed during the last call to check(), 0 if it only threw an exception.
+        int failureLine() const noexcept;
+
+    private:
+        class FailureRecorder : public Observer
+        {
+        public:
+            void onCheckFailed(const Test& source, const std::string& message, const char* file, int line) override;
+
+            std::string m_message;
+            const char* m_file = "";
+            int m_line = 0;
+        };
+
+        void prepare();
+        bool completed();
+
+    private:
+        std::shared_ptr<FailureRecorder> m_failureRecorder;
+    };
+}
+
+template<typename F>
+bool Ishiko::RepeatedTestCase::check(F&& function)
+{
+    prepare();
+    try
+    {
+        function(*this);
+    }
+    catch (const std::exception& e)
+    {
+        setResult(TestResult::exception);
+        if (m_failureRecorder->m_message.empty())
+        {
+            m_failureRecorder->m_message = (std::string("Exception thrown: ") + e.what());
+        }
+    }
+    catch (...)
+    {
+        // abort() and skip() use an exception to interrupt the test, in which case the result has already been set
+        if ((result() != TestResult::failed) && (result() != TestResult::skipped))
+        {
+            setResult(TestResult::exception);
+            if (m_failureRecorder->m_message.empty())
+            {
+                m_failureRecorder->m_message = "Exception not derived from std::exception thrown";
+            }
+        }
+    }
+    return completed();
+}
+
+#endif
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_SHAREDFIXTURE_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_SHAREDFIXTURE_HPP
+
+#include "TestSetupAction.hpp"
+#include "TestTeardownAction.hpp"
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Ishiko
+{
+    /// A fixture that is set up once and shared by several tests.
+
+    /// The same instance is added as a setup and a teardown action to each test that depends on the fixture, see
+    /// Test::addSharedFixture. The setup action runs when the first of these tests is set up and the teardown action
+    /// runs when the last of them has been torn down. Tests may run on different threads.
+    ///
+    /// The dependents are counted down as they are torn down and the count is re-armed whenever the fixture is torn
+    /// down so the same tests can be run again, e.g. by the watch mode of TestHarness.
+    ///
+    /// If the setup action throws, the exception is rethrown to every dependent test until the fixture is torn down.
+    /// A test whose setup throws is not torn down so it is counted as done with the fixture at that point.
+    ///
+    /// The setup and teardown actions run without the fixture's lock held so they can query the fixture. Tests that
+    /// need the fixture while an action is running wait for it to complete.
+    class SharedFixture : public TestSetupAction, public TestTeardownAction
+    {
+    public:
+        /// Constructor.
+        /// @param name The name under which the fixture is registered.
+        /// @param setupAction The action that creates the fixture.
+        /// @param teardownAction The action that destroys the fixture, it can be null.
+        SharedFixture(const std::string& name, std::shared_ptr<TestSetupAction> setupAction,
+            std::shared_ptr<TestTeardownAction> teardownAction);
+        SharedFixture(const SharedFixture& other) = delete;
+        SharedFixture& operator=(const SharedFixture& other) = delete;
+
+        const std::string& name() const noexcept;
+
+        /// Declares that one more test depends on the fixture.
+        void addDependent();
+        /// The number of tests that depend on the fixture.
+        size_t dependentCount() const;
+        /// The number of dependent tests that haven't been torn down since the fixture was last torn down.
+        size_t remainingDependentCount() const;
+        bool isSetUp() const;
+        /// When set the fixture isn't torn down with its last dependent but only by forceTeardown, so that tests
+        /// that are run again, e.g. by the server mode of TestHarness, don't pay for its setup again.
+        void setKeptSetUp(bool kept);
+
+        void setup(const Test& test) override;
+        /// Called when a dependent test is torn down. The fixture is torn down with the last one.
+        void teardown(const Test& test) override;
+        /// Tears down the fixture if it is set up, regardless of the number of remaining dependents.
+        void forceTeardown();
+
+    private:
+        void waitForAction(std::unique_lock<std::mutex>& lock);
+        void releaseDependent(std::unique_lock<std::mutex>& lock, const Test& test);
+        /// @param test The test that is being torn down, nullptr if the teardown is forced.
+        void doTeardown(std::unique_lock<std::mutex>& lock, const Test* test);
+
+    private:
+        std::string m_name;
+        std::shared_ptr<TestSetupAction> m_setupAction;
+        std::shared_ptr<TestTeardownAction> m_teardownAction;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_actionCompleted;
+        // Set while the setup or teardown action runs, m_mutex is released during that time
+        bool m_actionRunning;
+        size_t m_dependentCount;
+        size_t m_remainingDependentCount;
+        bool m_setUp;
+        bool m_keptSetUp;
+        std::exception_ptr m_setupException;
+    };
+}
+
+#endif
@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_SHAREDFIXTUREREGISTRY_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_SHAREDFIXTUREREGISTRY_HPP
+
+#include "SharedFixture.hpp"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Ishiko
+{
+    /// The shared fixtures available to the tests that use a given TestContext.
+
+    /// The scope of the fixtures is determined by the context the registry is attached to. TestHarness attaches one
+    /// to its context so by default fixtures are shared by all the tests of the harness. Attaching a registry to the
+    /// context of a TestSequence limits the sharing to the tests of that sequence.
+    class SharedFixtureRegistry
+    {
+    public:
+        SharedFixtureRegistry();
+        SharedFixtureRegistry(const SharedFixtureRegistry& other) = delete;
+        SharedFixtureRegistry& operator=(const SharedFixtureRegistry& other) = delete;
+        /// Tears down the fixtures that are still set up.
+        ~SharedFixtureRegistry();
+
+        /// Returns the fixture with the given name, registering a new one with the given actions if there is none.
+        /// The actions are ignored if the fixture already exists.
+        std::shared_ptr<SharedFixture> get(const std::string& name, std::shared_ptr<TestSetupAction> setupAction,
+            std::shared_ptr<TestTeardownAction> teardownAction);
+        /// Returns the fixture with the given name or nullptr if there is none.
+        std::shared_ptr<SharedFixture> find(const std::string& name) const;
+        /// Tears down all the fixtures that are set up. This is used to clean up fixtures whose dependents didn't all
+        /// run.
+        void teardownAll();
+        /// Calls SharedFixture::setKeptSetUp on the fixtures, including those registered afterwards.
+        void setKeptSetUp(bool kept);
+
+    private:
+        mutable std::mutex m_mutex;
+        std::map<std::string, std::shared_ptr<SharedFixture>> m_fixtures;
+        bool m_keptSetUp;
+    };
+}
+
+#endif
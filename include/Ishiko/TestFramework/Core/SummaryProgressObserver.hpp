@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_SUMMARYPROGRESSOBSERVER_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_SUMMARYPROGRESSOBSERVER_HPP
+
+#include "TestReporter.hpp"
+#include <chrono>
+#include <ostream>
+#include <string>
+
+namespace Ishiko
+{
+    /// A compact alternative to TestProgressObserver for large test suites.
+
+    /// Only the test cases that didn't pass or get skipped are printed, followed by their failures. Apart from that a
+    /// single progress line with the number of completed test cases, the rate, the estimated time remaining and the
+    /// number of failures so far is kept updated at the bottom of the output, using a carriage return to overwrite
+    /// it. The output is accumulated in a buffer and only written and flushed when the progress line is refreshed,
+    /// which happens at most once per refresh interval, and at the end of the run.
+    class SummaryProgressObserver : public TestReporter
+    {
+    public:
+        /// Creates an observer that writes to @p output.
+        /**
+            @param output The stream to write to.
+            @param expectedTestCases The number of test cases the run is expected to have, used to estimate the time
+            remaining. If 0 no estimate is displayed.
+        */
+        SummaryProgressObserver(std::ostream& output, size_t expectedTestCases = 0);
+
+        /// Sets the minimum interval between two refreshes of the progress line. The default is 250 ms.
+        void setRefreshInterval(std::chrono::milliseconds interval);
+
+        size_t completedTestCases() const noexcept;
+        size_t failedTestCases() const noexcept;
+
+    protected:
+        void onTestCaseCompleted(const Test& test, std::chrono::microseconds duration,
+            const std::vector<Failure>& failures) override;
+        void onRunCompleted() override;
+
+    private:
+        void clearProgressLine();
+        void writeProgressLine(std::chrono::steady_clock::time_point now);
+        void flushBuffer();
+
+    private:
+        std::ostream& m_output;
+        size_t m_expectedTestCases;
+        std::chrono::milliseconds m_refreshInterval;
+        std::chrono::steady_clock::time_point m_runStart;
+        std::chrono::steady_clock::time_point m_lastRefresh;
+        size_t m_completedTestCases;
+        size_t m_failedTestCases;
+        std::string m_buffer;
+        size_t m_progressLineLength;
+    };
+}
+
+#endif
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TAPREPORTER_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TAPREPORTER_HPP
+
+#include "TestReporter.hpp"
+#include <ostream>
+
+namespace Ishiko
+{
+    /// Writes the results of the test cases in the Test Anything Protocol (TAP) version 13 format as they complete.
+
+    /// The number of test cases isn't known before the run so the plan is written at the end. Each test case line is
+    /// followed by a YAML block with the duration of the test case and, if it failed, its failures. The strings in it
+    /// are JSON strings which are also valid YAML. A '#' in a test name is escaped so that it isn't read as a
+    /// directive.
+    class TAPReporter : public TestReporter
+    {
+    public:
+        TAPReporter(std::ostream& output);
+
+        void onLifecycleEvent(const Test& source, EventType type) override;
+
+    protected:
+        void onTestCaseCompleted(const Test& test, std::chrono::microseconds duration,
+            const std::vector<Failure>& failures) override;
+        void onRunCompleted() override;
+
+    private:
+        std::ostream& m_output;
+        bool m_headerWritten;
+        size_t m_count;
+    };
+}
+
+#endif
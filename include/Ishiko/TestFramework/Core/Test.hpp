@@ -7,6 +7,7 @@
 #include "DebugHeap.hpp"
 #include "JUnitXMLWriter.hpp"
 #include "TestCheck.hpp"
+#include "TestCheckArena.hpp"
 #include "TestContext.hpp"
 #include "TestNumber.hpp"
 #include "TestResult.hpp"
@@ -16,6 +17,7 @@
 #include <Ishiko/Time.hpp>
 #include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 #include <memory>
 
@@ -66,7 +68,11 @@ public:
     public:
         Utilities(const Test& test);
 
+        /// Copies a file or a directory tree. The copy is made with FixtureCopier so it is cheap on file systems
+        /// that support reflinks.
         void copy(const InterpolatedString& source, const InterpolatedString& destination);
+        /// Same as copy but the files may be hard linked to the source. The test must not modify them in place.
+        void copyReadOnly(const InterpolatedString& source, const InterpolatedString& destination);
 
     private:
         const Test& m_test;
@@ -105,7 +111,16 @@ public:
 
     Utilities utils() const;
 
+    /// Constructs a check that belongs to this test.
+
+    /// The check is allocated from an arena owned by the test. Like the checks added with appendCheck it is destroyed
+    /// when the test completes unless it didn't pass.
+    template<typename T, typename... Args>
+    T& createCheck(Args&&... args);
     void appendCheck(std::shared_ptr<TestCheck> check);
+    /// The number of checks that haven't been released yet. Once the test has completed these are the checks that
+    /// didn't pass.
+    size_t checkCount() const noexcept;
 
     size_t allocationCount() const;
 
@@ -113,10 +128,40 @@ public:
     TestContext& context();
 
     virtual void run();
+    /// Sets the result back to unknown and forgets the failed checks so that the test can be run again.
+    virtual void reset();
+    /// Starts the part of the test that can run in the background, typically a child process.
+
+    /// This is called before the tests that precede this one have completed, so a test must only accept to be
+    /// launched if its setup doesn't depend on them. If this returns true the setup has been done and run() must be
+    /// called later to complete the test. The default implementation returns false, meaning the test can only be run
+    /// by calling run().
+    virtual bool launch(ChildProcessPool& pool);
 
     virtual void addSetupAction(std::shared_ptr<TestSetupAction> action);
     virtual void addTeardownAction(std::shared_ptr<TestTeardownAction> action);
+    /// Makes the test depend on a fixture that is shared with the other tests that use the same name.
+
+    /// The fixture is looked up in the SharedFixtureRegistry of the context, see TestContext::getSharedFixtureRegistry,
+    /// and registered with the given actions if this is the first test to use it. The setup action runs once, before
+    /// the first dependent test, and the teardown action runs after the last dependent test. If the context has no
+    /// registry the actions are simply run for this test.
+    /// @param name The name of the fixture.
+    /// @param setupAction The action that creates the fixture.
+    /// @param teardownAction The action that destroys the fixture, it can be null.
+    void addSharedFixture(const std::string& name, std::shared_ptr<TestSetupAction> setupAction,
+        std::shared_ptr<TestTeardownAction> teardownAction = nullptr);
+
+    /// The number of tests this test contains. Only test sequences contain other tests.
 
+    /// Unlike traverse this isn't virtual, see TestTraversal.
+    size_t childCount() const noexcept;
+    const Test& child(size_t pos) const;
+    Test& child(size_t pos);
+
+    /// Calls function on this test and on all the tests it contains.
+
+    /// The function is copied at every level of the tree, TestTraversal should be preferred for large trees.
     virtual void traverse(std::function<void(const Test& test)> function) const;
 
     Observers& observers();
@@ -124,31 +169,69 @@ public:
     virtual void addToJUnitXMLTestReport(JUnitXMLWriter& writer) const;
 
 protected:
+    /// Whether the test gets its own output subdirectory when the context isolates them, see
+    /// TestContext::setIsolatedOutputDirectories. The default implementation returns true. Tests that don't write
+    /// output themselves, like sequences, return false since the subdirectory would only nest those of their tests.
+    virtual bool hasIsolatedOutputDirectory() const;
+    /// Whether setup actions, including shared fixtures, have been added to the test.
+    bool hasSetupActions() const noexcept;
     virtual void setup();
     virtual void doRun();
     virtual void teardown();
     virtual void notify(Observer::EventType type);
+    /// Destroys the checks that passed, those that didn't are kept for the JUnit XML report. This is called by run()
+    /// once the test has completed.
+    void releaseChecks();
+    /// Gives the test a new number and name and resets its result so that it can be run again. This is how the cases
+    /// of a ParameterizedTest are run without creating a test for each of them.
+    void reuse(const TestNumber& number, const std::string& name);
+    /// Override this to add properties to the test case in the JUnit XML report. The default implementation adds
+    /// nothing.
+    virtual void addPropertiesToJUnitXMLTestReport(JUnitXMLWriter& writer) const;
+    /// Sets the tests returned by child(). The vector is owned by the derived class and must outlive this test.
+    void setChildren(const std::vector<std::shared_ptr<Test>>* children) noexcept;
     
 private:
     class AbortException
     {
     };
 
+    // Most tests have no checks and no actions so these are only allocated when needed
+    struct Extras
+    {
+        TestCheckArena checkArena;
+        // The checks from both the arena and appendCheck, in the order they were added
+        std::vector<TestCheck*> checks;
+        std::vector<std::shared_ptr<TestCheck>> appendedChecks;
+        std::vector<std::shared_ptr<TestSetupAction>> setupActions;
+        std::vector<std::shared_ptr<TestTeardownAction>> teardownActions;
+    };
+
+    Extras& extras();
+
     TestNumber m_number;
     std::string m_name;
     TestResult m_result;
-    TestContext m_context;
-    std::vector<std::shared_ptr<TestCheck>> m_checks;
     bool m_memoryLeakCheck;
+    TestContext m_context;
     SystemTime m_executionStartTime;
     SystemTime m_executionEndTime;
     DebugHeap::HeapState m_initial_heap_state;
-    std::vector<std::shared_ptr<TestSetupAction>> m_setupActions;
-    std::vector<std::shared_ptr<TestTeardownAction>> m_teardownActions;
+    std::unique_ptr<Extras> m_extras;
     Observers m_observers;
     std::function<void(Test& test)> m_runFct;
+    const std::vector<std::shared_ptr<Test>>* m_children;
 };
 
 }
 
+template<typename T, typename... Args>
+T& Ishiko::Test::createCheck(Args&&... args)
+{
+    Extras& e = extras();
+    T& result = e.checkArena.create<T>(std::forward<Args>(args)...);
+    e.checks.push_back(&result);
+    return result;
+}
+
 #endif
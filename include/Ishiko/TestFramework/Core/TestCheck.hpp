@@ -25,6 +25,7 @@ public:
     };
 
     TestCheck();
+    virtual ~TestCheck() = default;
 
     virtual void run(Test& test, const char* file, int line) = 0;
 
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTCHECKARENA_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTCHECKARENA_HPP
+
+#include "TestCheck.hpp"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Ishiko
+{
+    /// Allocates the checks of a test from a few large blocks of memory.
+
+    /// Tests that compare many files create a check per comparison. Allocating each of them separately costs a heap
+    /// allocation, and a control block when it is held by a shared_ptr. The arena instead places the checks next to
+    /// each other in blocks and destroys all of them at once when clear() is called.
+    class TestCheckArena
+    {
+    public:
+        TestCheckArena() noexcept;
+        TestCheckArena(const TestCheckArena& other) = delete;
+        TestCheckArena& operator=(const TestCheckArena& other) = delete;
+        ~TestCheckArena();
+
+        /// Constructs a check in the arena. The check lives until clear() is called or the arena is destroyed.
+        template<typename T, typename... Args>
+        T& create(Args&&... args);
+
+        /// Destroys all the checks, in the reverse order of their creation, and frees the memory.
+        void clear() noexcept;
+
+        size_t size() const noexcept;
+
+    private:
+        struct Block;
+        // Precedes each check in its block so that the checks can be destroyed without a separate list
+        struct Entry
+        {
+            Entry* previous;
+            TestCheck* check;
+        };
+
+        void* allocate(size_t size, size_t alignment);
+
+    private:
+        Block* m_currentBlock;
+        Entry* m_lastEntry;
+        size_t m_size;
+    };
+}
+
+template<typename T, typename... Args>
+T& Ishiko::TestCheckArena::create(Args&&... args)
+{
+    static_assert(std::is_base_of<TestCheck, T>::value, "T must derive from TestCheck");
+
+    const size_t alignment = (alignof(T) > alignof(Entry)) ? alignof(T) : alignof(Entry);
+    const size_t offset = ((sizeof(Entry) + alignment - 1) / alignment) * alignment;
+    char* memory = static_cast<char*>(allocate(offset + sizeof(T), alignment));
+    T* result = new(memory + offset) T(std::forward<Args>(args)...);
+    Entry* entry = new(memory) Entry{m_lastEntry, result};
+    m_lastEntry = entry;
+    ++m_size;
+    return *result;
+}
+
+#endif
@@ -4,14 +4,23 @@
 #ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTCONTEXT_HPP
 #define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTCONTEXT_HPP
 
+#include "BackgroundDeleter.hpp"
+#include "ChildProcessPool.hpp"
+#include "MemoryBackedOutputDirectory.hpp"
+#include "SharedFixtureRegistry.hpp"
 #include <boost/filesystem/path.hpp>
 #include <boost/optional.hpp>
 #include <Ishiko/Errors.hpp>
 #include <Ishiko/Text.hpp>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 
 namespace Ishiko
 {
+    class TestFileDependencies;
+
     class TestContext : public InterpolatedString::Callbacks
     {
     public:
@@ -23,8 +32,20 @@ namespace Ishiko
 
         TestContext();
         TestContext(const TestContext* parent);
-        ~TestContext() noexcept = default;
+        /// Copies the settings and the services but not the cached paths.
+        TestContext(const TestContext& other);
+        TestContext(TestContext&& other) noexcept;
+        ~TestContext() noexcept;
+
+        TestContext& operator=(const TestContext& other);
+        TestContext& operator=(TestContext&& other) noexcept;
         static const TestContext& DefaultTestContext();
+        /// Forgets the paths this context has resolved.
+
+        /// The directories returned by the getXxxDirectory functions are cached by each context until a directory is
+        /// set in it or one of its ancestors. The platform specific reference paths are cached as well, and since
+        /// they depend on which files exist this needs to be called if a test creates reference files.
+        void clearPathCache() const;
 
         void expand(boost::string_view variable, std::string& result, Error& error) const override;
 
@@ -61,16 +82,97 @@ namespace Ishiko
         // can contain environment variables by using the $(...) notation.
         void setOutputDirectory(const boost::filesystem::path& path);
         void setOutputDirectory(const std::string& id, const boost::filesystem::path& path);
+        /// Returns true if each test writes its output to its own subdirectory of the output directory.
+        bool isolatedOutputDirectories() const;
+        /// Gives each test its own output subdirectory, named after its number, so that tests that use the same
+        /// output file names can run in parallel. The subdirectory is applied when the test is run and is transparent
+        /// to getOutputDirectory() and getOutputPath(). Tests that set their own output directory are not affected.
+        void setIsolatedOutputDirectories(bool isolated);
+        /// Makes the default output directory of this context the subdirectory with the given name of the parent
+        /// output directory, if isolated output directories are enabled and no output directory was set explicitly.
+        void isolateOutputDirectory(const std::string& name);
 
         boost::filesystem::path getApplicationPath() const;
         void setApplicationPath(const boost::filesystem::path& path);
 
+        /// Returns the pool used to run child processes concurrently or nullptr if tests should run their child
+        /// processes one at a time.
+        ChildProcessPool* getChildProcessPool() const;
+        void setChildProcessPool(std::shared_ptr<ChildProcessPool> pool);
+
+        /// Returns the registry of the closest context that has one or nullptr if there is none.
+        SharedFixtureRegistry* getSharedFixtureRegistry() const;
+        void setSharedFixtureRegistry(std::shared_ptr<SharedFixtureRegistry> registry);
+
+        /// Returns the deleter teardown actions should hand their paths to or nullptr if they should delete them
+        /// immediately.
+        BackgroundDeleter* getBackgroundDeleter() const;
+        void setBackgroundDeleter(std::shared_ptr<BackgroundDeleter> deleter);
+
+        /// Returns the memory-backed directory the output directory has been redirected to or nullptr if the output
+        /// is written directly to disk.
+        MemoryBackedOutputDirectory* getMemoryBackedOutputDirectory() const;
+        void setMemoryBackedOutputDirectory(std::shared_ptr<MemoryBackedOutputDirectory> directory);
+
+        /// Returns the object that records the files the tests use or nullptr if they aren't recorded. When set the
+        /// paths returned by getDataPath and getReferencePath are recorded, see TestHarness's watch mode.
+        TestFileDependencies* getFileDependencies() const;
+        void setFileDependencies(std::shared_ptr<TestFileDependencies> dependencies);
+
+    private:
+        // Tests running on different threads may resolve paths through the same context
+        struct ResolvedPaths
+        {
+            void clear();
+
+            std::mutex mutex;
+            // The pathVersion() the paths were resolved with
+            unsigned long version = 0;
+            std::map<std::string, boost::filesystem::path> dataDirectories;
+            std::map<std::string, boost::filesystem::path> referenceDirectories;
+            std::map<std::string, boost::filesystem::path> outputDirectories;
+            std::map<std::string, boost::filesystem::path> platformSpecificReferencePaths;
+        };
+        typedef std::map<std::string, boost::filesystem::path> ResolvedPaths::* PathMap;
+
+        // Most contexts belong to a test and don't override anything from their parent so the settings are allocated on
+        // demand
+        struct Settings
+        {
+            std::map<std::string, boost::filesystem::path> dataDirectories;
+            std::map<std::string, boost::filesystem::path> referenceDirectories;
+            std::map<std::string, boost::filesystem::path> outputDirectories;
+            boost::optional<bool> isolatedOutputDirectories;
+            boost::optional<boost::filesystem::path> applicationPath;
+        };
+
+        // The services are usually only set on the top context so they are allocated on demand to keep the contexts of
+        // the tests small
+        struct Services
+        {
+            std::shared_ptr<ChildProcessPool> childProcessPool;
+            std::shared_ptr<SharedFixtureRegistry> sharedFixtureRegistry;
+            std::shared_ptr<BackgroundDeleter> backgroundDeleter;
+            std::shared_ptr<MemoryBackedOutputDirectory> memoryBackedOutputDirectory;
+            std::shared_ptr<TestFileDependencies> fileDependencies;
+        };
+
+        boost::filesystem::path resolveReferencePath(const boost::filesystem::path& path,
+            PathResolution path_resolution) const;
+        const Settings& settings() const;
+        Settings& settings();
+        ResolvedPaths& resolvedPaths() const;
+        unsigned long pathVersion() const;
+        bool findResolvedPath(PathMap map, const std::string& key, boost::filesystem::path& result) const;
+        void storeResolvedPath(PathMap map, const std::string& key, const boost::filesystem::path& path) const;
+        Services& services();
+
     private:
         const TestContext* m_parent;
-        std::map<std::string, boost::filesystem::path> m_dataDirectories;
-        std::map<std::string, boost::filesystem::path> m_referenceDirectories;
-        std::map<std::string, boost::filesystem::path> m_outputDirectories;
-        boost::optional<boost::filesystem::path> m_application_path;
+        std::unique_ptr<Settings> m_settings;
+        std::unique_ptr<Services> m_services;
+        // Allocated on demand by resolvedPaths(), which may be called concurrently
+        mutable std::atomic<ResolvedPaths*> m_resolvedPaths;
     };
 }
 
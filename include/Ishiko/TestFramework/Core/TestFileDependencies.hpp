@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTFILEDEPENDENCIES_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTFILEDEPENDENCIES_HPP
+
+#include "Test.hpp"
+#include <boost/filesystem/path.hpp>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace Ishiko
+{
+    /// Records the data and reference files used by each of the outermost tests, to know which to run again when
+    /// files change.
+
+    /// It must be set on the context of the tests with TestContext::setFileDependencies and added to the observers
+    /// of the sequence that contains the tests. The paths returned by TestContext::getDataPath and
+    /// TestContext::getReferencePath are recorded, files that a test finds some other way, e.g. from
+    /// TestContext::getDataDirectory, aren't. The dependencies of a test are forgotten each time it starts so that
+    /// they are always those of its last run.
+    class TestFileDependencies : public Test::Observer
+    {
+    public:
+        TestFileDependencies();
+
+        void onLifecycleEvent(const Test& source, EventType type) override;
+
+        /// Records that the outermost test currently running uses path. Does nothing if no test is running.
+        void record(const boost::filesystem::path& path);
+
+        /// The outermost tests that use one of the changed paths, or a file in one of them if it's a directory, in
+        /// the order they first ran.
+        std::vector<Test*> findAffectedTests(const std::vector<boost::filesystem::path>& changedPaths) const;
+
+    private:
+        static boost::filesystem::path Normalize(const boost::filesystem::path& path);
+
+    private:
+        mutable std::mutex m_mutex;
+        size_t m_depth;
+        Test* m_currentTest;
+        // The tests in the order they first ran, and their dependencies
+        std::vector<Test*> m_tests;
+        std::map<const Test*, std::set<boost::filesystem::path>> m_dependencies;
+    };
+}
+
+#endif
@@ -5,15 +5,19 @@
 #define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTHARNESS_HPP
 
 #include "TestContext.hpp"
+#include "TestResultSummary.hpp"
 #include "TestSequence.hpp"
 #include "TopTestSequence.hpp"
 #include "TestApplicationReturnCodes.hpp"
 #include <boost/optional.hpp>
 #include <Ishiko/Configuration.hpp>
 #include <string>
+#include <vector>
 
 namespace Ishiko
 {
+    class TestRegistry;
+
     class TestHarness
     {
     public:
@@ -34,6 +38,30 @@ namespace Ishiko
             const boost::optional<std::string>& contextApplicatiponPath() const;
             const boost::optional<std::string>& persistentStoragePath() const;
             const boost::optional<std::string>& junitXMLTestReport() const;
+            /// The path of the log BinaryResultLogObserver writes the events of the run to, if any.
+            const boost::optional<std::string>& binaryResultLog() const;
+            /// The path of the file JSONLinesReporter writes a line per test case to, if any.
+            const boost::optional<std::string>& jsonLinesReport() const;
+            /// The path of the file TAPReporter writes the TAP results to, if any.
+            const boost::optional<std::string>& tapReport() const;
+            /// Whether SummaryProgressObserver is used instead of TestProgressObserver to report progress on the
+            /// console, i.e. whether the console-output option is "summary" rather than "detailed".
+            const boost::optional<bool>& summaryConsoleOutput() const;
+            /// Whether the names of the tests are listed instead of running them.
+            const boost::optional<bool>& listTests() const;
+            /// Whether the harness keeps running after the tests have run and runs them again when their files
+            /// change.
+            const boost::optional<bool>& watch() const;
+            /// The path of the Unix domain socket TestServer listens on, if the tests are to be run on request
+            /// instead of straight away.
+            const boost::optional<std::string>& serverSocketPath() const;
+            /// A description of the first option that had an invalid value, if any. TestHarness::run() reports it
+            /// instead of running the tests.
+            const boost::optional<std::string>& error() const;
+            const boost::optional<size_t>& childProcessPoolSize() const;
+            const boost::optional<size_t>& backgroundDeleterThreadCount() const;
+            const boost::optional<std::string>& memoryBackedOutputRoot() const;
+            const boost::optional<bool>& isolatedOutputDirectories() const;
 
         private:
             boost::optional<std::string> m_contextData;
@@ -42,29 +70,74 @@ namespace Ishiko
             boost::optional<std::string> m_application_path;
             boost::optional<std::string> m_persistentStorage;
             boost::optional<std::string> m_junitXMLTestReport;
+            boost::optional<std::string> m_binaryResultLog;
+            boost::optional<std::string> m_jsonLinesReport;
+            boost::optional<std::string> m_tapReport;
+            boost::optional<bool> m_summaryConsoleOutput;
+            boost::optional<bool> m_listTests;
+            boost::optional<bool> m_watch;
+            boost::optional<std::string> m_serverSocketPath;
+            boost::optional<std::string> m_error;
+            boost::optional<size_t> m_childProcessPoolSize;
+            boost::optional<size_t> m_backgroundDeleterThreadCount;
+            boost::optional<std::string> m_memoryBackedOutputRoot;
+            boost::optional<bool> m_isolatedOutputDirectories;
         };
 
         explicit TestHarness(const std::string& title);
         TestHarness(const std::string& title, const Configuration& configuration);
         virtual ~TestHarness() noexcept = default;
 
+        /// Runs the tests, including those of the test registry, if one was set, which are appended after the others. If
+        /// the list-tests option is set the tests are listed instead.
+
+        /// If the watch option is set this doesn't return. The data and reference directories are watched once the
+        /// tests have run and the tests that used a data or reference file that changed, as recorded by
+        /// TestFileDependencies, are run again in the same process. If the test executable itself changes it is
+        /// started again with the same arguments.
+        ///
+        /// If the server option is set the tests are only run when a client of TestServer asks for them, until a
+        /// client asks for the server to shut down. The shared fixtures are kept set up between requests.
         int run();
 
         TestContext& context();
 
         TestSequence& tests();
 
+        /// Sets the registry whose tests are appended by run(), usually &TestRegistry::DefaultTestRegistry(). There is
+        /// none by default. The tests are only appended the first time run() is called. The registry must outlive the
+        /// harness.
+        void setTestRegistry(const TestRegistry* registry);
+
     private:
         void prepareOutputDirectory();
+        void prepareMemoryBackedOutputDirectory(const boost::filesystem::path& root);
+        void copyOutMemoryBackedOutputDirectory();
+        void listTests();
         int runTests();
-        void printDetailedResults();
-        void printSummary();
+        int watchTests();
+        int serveTests(const std::string& socketPath);
+        void rerunTests(const std::vector<Test*>& tests);
+        void printDetailedResults(const TestResultSummary& summary);
+        void printSummary(const TestResultSummary& summary, bool passed);
         void writeJUnitXMLTestReport(const std::string& path);
 
     private:
         boost::optional<std::string> m_junitXMLTestReport;
+        boost::optional<std::string> m_binaryResultLog;
+        boost::optional<std::string> m_jsonLinesReport;
+        boost::optional<std::string> m_tapReport;
+        bool m_summaryConsoleOutput;
+        bool m_listTests;
+        bool m_watch;
+        boost::optional<std::string> m_serverSocketPath;
+        boost::optional<std::string> m_configurationError;
         TestContext m_context;
         TopTestSequence m_topSequence;
+        const TestRegistry* m_testRegistry;
+        // The registry whose tests have already been appended to m_topSequence
+        const TestRegistry* m_appendedTestRegistry;
+        TestResultSummary m_resultSummary;
         bool m_timestampOutputDirectory;
     };
 }
@@ -105,17 +105,15 @@
 #endif
 
 // TODO: can I avoid the tracking state nightmare here?
-#define ISHIKO_TEST_FAIL_IF_OUTPUT_AND_REFERENCE_FILES_NEQ(...)                                 \
-    {                                                                                           \
-        Ishiko::DebugHeap::TrackingState trackingState;                                         \
-        trackingState.disableTracking();                                                        \
-        std::shared_ptr<Ishiko::FileComparisonTestCheck> check =                                \
-            std::make_shared<Ishiko::FileComparisonTestCheck>(                                  \
-                Ishiko::FileComparisonTestCheck::CreateFromContext(test.context(), __VA_ARGS__, \
-                    Ishiko::TestContext::PathResolution::platform_specific));                   \
-        test.appendCheck(check);                                                                \
-        trackingState.restore();                                                                \
-        check->run(test, __FILE__, __LINE__);                                                   \
+#define ISHIKO_TEST_FAIL_IF_OUTPUT_AND_REFERENCE_FILES_NEQ(...)                                     \
+    {                                                                                               \
+        Ishiko::DebugHeap::TrackingState trackingState;                                             \
+        trackingState.disableTracking();                                                            \
+        Ishiko::FileComparisonTestCheck& check = test.createCheck<Ishiko::FileComparisonTestCheck>( \
+            Ishiko::FileComparisonTestCheck::CreateFromContext(test.context(), __VA_ARGS__,         \
+                Ishiko::TestContext::PathResolution::platform_specific));                           \
+        trackingState.restore();                                                                    \
+        check.run(test, __FILE__, __LINE__);                                                        \
     }
 
 #define ISHIKO_TEST_PASS() test.pass()
@@ -7,31 +7,76 @@
 #ifndef _ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTNUMBER_HPP_
 #define _ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTNUMBER_HPP_
 
-#include <vector>
+#include <cstdint>
+#include <functional>
 #include <stdlib.h>
 
 namespace Ishiko
 {
 
+/// The hierarchical number of a test, e.g. 1.2.3 for the third test of the second sequence of the first sequence.
+
+/// Numbers up to a depth of 6 are stored inline so creating and copying them doesn't allocate memory. Numbers
+/// are ordered in the same order as the tests they identify and can be hashed, which makes them suitable keys for
+/// sharding and for caching results.
 class TestNumber
 {
 public:
-    TestNumber();
-    TestNumber(int major);
-    TestNumber(int major, int minor);
+    TestNumber() noexcept;
+    TestNumber(int major) noexcept;
+    TestNumber(int major, int minor) noexcept;
+    /// Creates a number from its parts, for instance when reading it back from a result log.
+    TestNumber(const int* parts, size_t depth);
+    TestNumber(const TestNumber& other);
+    TestNumber(TestNumber&& other) noexcept;
+    ~TestNumber();
+
+    TestNumber& operator =(const TestNumber& other);
+    TestNumber& operator =(TestNumber&& other) noexcept;
 
-    size_t depth() const;
-    int part(size_t i) const;
+    size_t depth() const noexcept;
+    int part(size_t i) const noexcept;
 
-    bool operator ==(const TestNumber& other) const;
-    bool operator !=(const TestNumber& other) const;
+    bool operator ==(const TestNumber& other) const noexcept;
+    bool operator !=(const TestNumber& other) const noexcept;
+    /// Compares the parts in order, a number comes before the numbers of the tests it contains.
+    bool operator <(const TestNumber& other) const noexcept;
+    size_t hash() const noexcept;
 
-    TestNumber& operator ++();
+    TestNumber& operator ++() noexcept;
     TestNumber operator ++(int);
     TestNumber getDeeperNumber() const;
 
 private:
-    std::vector<int> m_number;
+    static const size_t inlineCapacity = 6;
+
+    const int* parts() const noexcept;
+    int* parts() noexcept;
+    bool isInline() const noexcept;
+    void reserve(size_t capacity);
+
+private:
+    uint32_t m_depth;
+    uint32_t m_capacity;
+    union
+    {
+        int m_inlineParts[inlineCapacity];
+        int* m_heapParts;
+    };
+};
+
+}
+
+namespace std
+{
+
+template<>
+struct hash<Ishiko::TestNumber>
+{
+    size_t operator()(const Ishiko::TestNumber& number) const noexcept
+    {
+        return number.hash();
+    }
 };
 
 }
@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTREGISTRY_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTREGISTRY_HPP
+
+#include "Test.hpp"
+#include "TestContext.hpp"
+#include "TestNumber.hpp"
+#include "TestSequence.hpp"
+#include <memory>
+#include <vector>
+
+namespace Ishiko
+{
+    /// The tests registered with the ISHIKO_TEST_REGISTER and ISHIKO_TEST_CASE macros.
+
+    /// Registering a test only links a static Entry into the registry, before main is called. The entry holds the
+    /// name and location of the test and a function to create it, nothing is allocated and no test is constructed
+    /// until the registry is used to create the tests. The tests in DefaultTestRegistry() are appended to the tests
+    /// of a TestHarness when it runs if it was passed to TestHarness::setTestRegistry.
+    class TestRegistry
+    {
+    public:
+        class Entry;
+        typedef std::shared_ptr<Test> (*Factory)(const Entry& entry, const TestNumber& number,
+            const TestContext& context);
+
+        /// A registered test. Entries must have static storage duration.
+        class Entry
+        {
+        public:
+            /// Registers a test created by factory with the given registry.
+            Entry(TestRegistry& registry, const char* name, const char* file, int line, Factory factory) noexcept;
+            /// Registers a Test that runs function with the given registry.
+            Entry(TestRegistry& registry, const char* name, const char* file, int line,
+                void (*function)(Test& test)) noexcept;
+            Entry(const Entry& other) = delete;
+            Entry& operator=(const Entry& other) = delete;
+
+            const char* name() const noexcept;
+            const char* file() const noexcept;
+            int line() const noexcept;
+
+            std::shared_ptr<Test> createTest(const TestNumber& number, const TestContext& context) const;
+
+        private:
+            friend class TestRegistry;
+
+            const char* m_name;
+            const char* m_file;
+            int m_line;
+            Factory m_factory;
+            void (*m_function)(Test& test);
+            const Entry* m_next;
+        };
+
+        /// The registry the macros add the tests to.
+        static TestRegistry& DefaultTestRegistry();
+
+        TestRegistry() noexcept;
+        TestRegistry(const TestRegistry& other) = delete;
+        TestRegistry& operator=(const TestRegistry& other) = delete;
+
+        size_t size() const noexcept;
+        /// The entries ordered by file and then line so that the order, and so the test numbers, don't depend on the
+        /// order the files were linked in.
+        std::vector<const Entry*> entries() const;
+
+        /// Creates the registered tests and appends them to sequence.
+        void appendTo(TestSequence& sequence) const;
+
+        template<typename TestClass>
+        static std::shared_ptr<Test> CreateTest(const Entry& entry, const TestNumber& number,
+            const TestContext& context);
+
+    private:
+        void add(Entry& entry) noexcept;
+
+        const Entry* m_first;
+        Entry* m_last;
+        size_t m_size;
+    };
+}
+
+template<typename TestClass>
+std::shared_ptr<Ishiko::Test> Ishiko::TestRegistry::CreateTest(const Entry& entry, const TestNumber& number,
+    const TestContext& context)
+{
+    return std::make_shared<TestClass>(number, context);
+}
+
+#define ISHIKO_TEST_REGISTRY_CONCATENATE_IMPL(a, b) a##b
+#define ISHIKO_TEST_REGISTRY_CONCATENATE(a, b) ISHIKO_TEST_REGISTRY_CONCATENATE_IMPL(a, b)
+
+/// Registers a test class with the default registry. The class must have a constructor that takes a TestNumber and a
+/// TestContext, like the sequences of tests that are usually appended to the harness in main.
+#define ISHIKO_TEST_REGISTER(TestClass)                                                                       \
+    static Ishiko::TestRegistry::Entry ISHIKO_TEST_REGISTRY_CONCATENATE(IshikoTestRegistryEntry, __LINE__)(   \
+        Ishiko::TestRegistry::DefaultTestRegistry(), #TestClass, __FILE__, __LINE__,                          \
+        &Ishiko::TestRegistry::CreateTest<TestClass>)
+
+/// Defines a test function and registers it with the default registry. The body of the test follows the macro and
+/// has access to the test through a variable called test like the other test functions.
+#define ISHIKO_TEST_CASE(name)                                                                                \
+    static void ISHIKO_TEST_REGISTRY_CONCATENATE(IshikoTestCase, __LINE__)(Ishiko::Test& test);              \
+    static Ishiko::TestRegistry::Entry ISHIKO_TEST_REGISTRY_CONCATENATE(IshikoTestRegistryEntry, __LINE__)(   \
+        Ishiko::TestRegistry::DefaultTestRegistry(), name, __FILE__, __LINE__,                                \
+        &ISHIKO_TEST_REGISTRY_CONCATENATE(IshikoTestCase, __LINE__));                                         \
+    static void ISHIKO_TEST_REGISTRY_CONCATENATE(IshikoTestCase, __LINE__)(Ishiko::Test& test)
+
+#endif
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTREPORTER_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTREPORTER_HPP
+
+#include "Test.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace Ishiko
+{
+    /// The base class of the observers that write a record for each test case as soon as it completes.
+
+    /// The test cases are the tests that don't contain other tests, the same ones that appear in the JUnit XML
+    /// report. Only the tests that are running are kept track of so the memory used doesn't depend on the number of
+    /// tests.
+    class TestReporter : public Test::Observer
+    {
+    public:
+        struct Failure
+        {
+            std::string message;
+            /// Empty for exceptions.
+            std::string file;
+            int line;
+        };
+
+        /// Must be called once all the tests have run.
+
+        /// The end of the run can't be detected from the events alone since the top sequence of TestHarness doesn't
+        /// send any, so each of its children ends with no test left running.
+        void endRun();
+
+        void onLifecycleEvent(const Test& source, EventType type) override;
+        void onCheckFailed(const Test& source, const std::string& message, const char* file, int line) override;
+        void onExceptionThrown(const Test& source, std::exception_ptr exception) override;
+
+    protected:
+        /// Called when a test that doesn't contain other tests completes.
+        virtual void onTestCaseCompleted(const Test& test, std::chrono::microseconds duration,
+            const std::vector<Failure>& failures) = 0;
+        /// Called by endRun(). The default implementation does nothing.
+        virtual void onRunCompleted();
+
+    private:
+        struct RunningTest
+        {
+            std::chrono::steady_clock::time_point start;
+            bool hasChildren;
+            std::vector<Failure> failures;
+        };
+
+        std::vector<RunningTest> m_runningTests;
+    };
+}
+
+#endif
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTRESULTSUMMARY_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTRESULTSUMMARY_HPP
+
+#include "Test.hpp"
+#include "TestResult.hpp"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Ishiko
+{
+    /// The number of test cases with each result, updated as the test cases complete.
+
+    /// This gives the same numbers as Test::getPassRate without walking the test tree at the end of the run. The
+    /// counters are atomic so they can be updated from several threads and read at any time, e.g. to display live
+    /// progress. The names of the test cases that didn't pass are kept as well so they can be listed at the end.
+    class TestResultSummary
+    {
+    public:
+        /// Adds each test that doesn't contain other tests to a TestResultSummary when it completes.
+
+        /// The events of a given test tree must come from a single thread, the summary itself may be shared.
+        class Observer : public Test::Observer
+        {
+        public:
+            Observer(TestResultSummary& summary);
+
+            void onLifecycleEvent(const Test& source, EventType type) override;
+
+        private:
+            TestResultSummary& m_summary;
+            /// Whether each of the tests currently running has started another test.
+            std::vector<bool> m_hasChildren;
+        };
+
+        TestResultSummary();
+
+        void add(const Test& test);
+
+        size_t unknown() const noexcept;
+        size_t passed() const noexcept;
+        size_t passedButMemoryLeaks() const noexcept;
+        size_t exception() const noexcept;
+        size_t failed() const noexcept;
+        size_t skipped() const noexcept;
+        size_t total() const noexcept;
+
+        /// The names and results of the test cases that didn't pass, skipped test cases included, in the order they
+        /// completed.
+        std::vector<std::pair<std::string, TestResult>> notPassed() const;
+
+    private:
+        std::atomic<size_t> m_unknown;
+        std::atomic<size_t> m_passed;
+        std::atomic<size_t> m_passedButMemoryLeaks;
+        std::atomic<size_t> m_exception;
+        std::atomic<size_t> m_failed;
+        std::atomic<size_t> m_skipped;
+        std::atomic<size_t> m_total;
+        mutable std::mutex m_notPassedMutex;
+        std::vector<std::pair<std::string, TestResult>> m_notPassed;
+    };
+}
+
+#endif
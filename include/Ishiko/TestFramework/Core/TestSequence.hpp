@@ -29,6 +29,7 @@ public:
     TestClass& append(Args&&... args);
 
     void setNumber(const TestNumber& number) override;
+    void reset() override;
     
     void getPassRate(size_t& unknown, size_t& passed, size_t& passedButMemoryLeaks, size_t& exception, size_t& failed,
         size_t& skipped, size_t& total) const override;
@@ -38,6 +39,7 @@ public:
     void addToJUnitXMLTestReport(JUnitXMLWriter& writer) const override;
 
 protected:
+    bool hasIsolatedOutputDirectory() const override;
     void doRun() override;
 
 private:
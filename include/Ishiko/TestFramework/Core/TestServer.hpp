@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTSERVER_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTSERVER_HPP
+
+#include "Test.hpp"
+#include <boost/filesystem/path.hpp>
+#include <Ishiko/BasePlatform.hpp>
+#include <Ishiko/Errors.hpp>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Ishiko
+{
+    /// Runs tests on request from clients connected to a Unix domain socket.
+
+    /// This lets a tool such as an IDE run a few tests at a time without starting the test executable, and setting
+    /// up its shared fixtures, each time. Clients are served one at a time and send requests made of a single line of
+    /// text:
+    /// - "run" runs all the tests and "run <filter>" runs the tests whose number, e.g. 2.1, or name is the filter
+    /// together with the tests they contain.
+    /// - "list" lists the tests.
+    /// - "shutdown" stops the server.
+    ///
+    /// Replies are in JSON Lines format and each line is sent as soon as it is ready. "run" replies with the
+    /// records of JSONLinesReporter for each test case as it completes and "list" with a
+    /// {"number":"2.1","name":"test"} object per test. Every reply ends with a line that has a "done" member,
+    /// e.g. {"done":true,"total":3,"passed":2,"failed":1,"exception":0,"skipped":0} for "run".
+    ///
+    /// This is only implemented on Linux at the moment, on other platforms start() fails.
+    class TestServer
+    {
+    public:
+        /// Constructor.
+        /// @param tests The sequence that contains the tests, normally the top sequence of TestHarness.
+        TestServer(Test& tests);
+        TestServer(const TestServer& other) = delete;
+        TestServer& operator=(const TestServer& other) = delete;
+        ~TestServer();
+
+        static bool IsSupported() noexcept;
+        /// Returns the tests matched by a filter as described for the "run" request. The tests contained in a
+        /// matching test are not returned separately.
+        static std::vector<Test*> FindTests(Test& tests, const std::string& filter);
+
+        /// Listens on a socket at the given path. A socket already at that path, e.g. the socket of a server that
+        /// didn't shut down cleanly, is replaced. If there is anything else at that path it is left alone and this
+        /// fails.
+        void start(const boost::filesystem::path& socketPath, Error& error);
+        /// Serves the clients until one of them sends a shutdown request.
+        void serve(Error& error);
+        /// Stops listening and removes the socket.
+        void stop();
+        bool isRunning() const noexcept;
+
+    private:
+        /// Returns true if the client asked for the server to shut down.
+        bool serveClient(int socket);
+        void runTests(const std::string& filter, std::ostream& output);
+        void listTests(std::ostream& output);
+
+    private:
+        Test& m_tests;
+        boost::filesystem::path m_socketPath;
+        int m_socket;
+    };
+}
+
+#endif
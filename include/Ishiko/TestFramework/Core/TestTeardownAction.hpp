@@ -10,6 +10,8 @@
 namespace Ishiko
 {
 
+class Test;
+
 /// Base class that represents an action that needs to be performed after the test has been run.
 
 /// This class does nothing. Derived classes can override the run() method to perform
@@ -22,6 +24,11 @@ public:
 
     /// This method is called to perform the teardown action.
     virtual void teardown();
+    /// This method is called by the test to perform the teardown action.
+
+    /// The default implementation calls teardown(). Derived classes can override it if they need access to the
+    /// test, for instance to use facilities provided by its context.
+    virtual void teardown(const Test& test);
 };
 
 }
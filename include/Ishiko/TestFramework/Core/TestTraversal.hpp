@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2000-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTTRAVERSAL_HPP
+#define GUARD_ISHIKO_CPP_TESTFRAMEWORK_CORE_TESTTRAVERSAL_HPP
+
+#include "Test.hpp"
+
+namespace Ishiko
+{
+    /// Functions that visit all the tests in a test tree.
+
+    /// Unlike Test::traverse the visitor is passed by reference all the way down and called directly, and the children
+    /// are found with Test::childCount and Test::child which are neither virtual nor need a dynamic_cast. Nothing is
+    /// allocated so these are suitable for large test trees.
+    ///
+    /// The TestType template parameter is deduced from the root: if it's const the visitor gets const Test&, else it
+    /// gets Test& and can modify the tests, but not add or remove any.
+    class TestTraversal
+    {
+    public:
+        /// Calls visitor(test) on each test, parents before their children.
+        template<typename TestType, typename Visitor>
+        static void PreOrder(TestType& root, Visitor&& visitor);
+
+        /// Calls visitor(test) on each test, children before their parents.
+        template<typename TestType, typename Visitor>
+        static void PostOrder(TestType& root, Visitor&& visitor);
+
+        /// Calls visitor(test) on each test that doesn't contain other tests, in order.
+
+        /// These are the test cases. Note that an empty sequence is also a leaf.
+        template<typename TestType, typename Visitor>
+        static void Leaves(TestType& root, Visitor&& visitor);
+    };
+}
+
+template<typename TestType, typename Visitor>
+void Ishiko::TestTraversal::PreOrder(TestType& root, Visitor&& visitor)
+{
+    visitor(root);
+    size_t count = root.childCount();
+    for (size_t i = 0; i < count; ++i)
+    {
+        PreOrder(root.child(i), visitor);
+    }
+}
+
+template<typename TestType, typename Visitor>
+void Ishiko::TestTraversal::PostOrder(TestType& root, Visitor&& visitor)
+{
+    size_t count = root.childCount();
+    for (size_t i = 0; i < count; ++i)
+    {
+        PostOrder(root.child(i), visitor);
+    }
+    visitor(root);
+}
+
+template<typename TestType, typename Visitor>
+void Ishiko::TestTraversal::Leaves(TestType& root, Visitor&& visitor)
+{
+    size_t count = root.childCount();
+    if (count == 0)
+    {
+        visitor(root);
+    }
+    else
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            Leaves(root.child(i), visitor);
+        }
+    }
+}
+
+#endif